@@ -0,0 +1,121 @@
+// Copyright (C) 2025 ...
+
+#include "async_writer.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+
+namespace form::experimental {
+
+  async_writer::async_writer(std::unique_ptr<form_interface> form, std::size_t capacity) :
+    m_form(std::move(form)),
+    m_capacity(std::max(capacity, std::size_t{1})),
+    m_thread([this](std::stop_token token) { run(token); })
+  {
+  }
+
+  async_writer::~async_writer()
+  {
+    // Storages that were not closed explicitly are closed when m_form is destroyed.
+    drain();
+    m_thread.request_stop();
+    m_thread.join();
+  }
+
+  std::future<void> async_writer::write(std::string const& creator,
+                                        segment_id id,
+                                        std::vector<product_with_name> products,
+                                        std::shared_ptr<void const> owner)
+  {
+    auto written = std::make_shared<std::promise<void>>();
+    auto result = written->get_future();
+    write(creator,
+          std::move(id),
+          std::move(products),
+          std::move(owner),
+          [written](std::exception_ptr error) {
+            if (error) {
+              written->set_exception(error);
+            } else {
+              written->set_value();
+            }
+          });
+    return result;
+  }
+
+  void async_writer::write(std::string const& creator,
+                           segment_id id,
+                           std::vector<product_with_name> products,
+                           std::shared_ptr<void const> owner,
+                           std::function<void(std::exception_ptr)> done)
+  {
+    {
+      std::unique_lock lock{m_mutex};
+      if (m_closed) {
+        throw std::runtime_error("async_writer::write called after close");
+      }
+      m_not_full.wait(lock, [this] { return m_queue.size() < m_capacity; });
+      m_queue.push_back(
+        {creator, std::move(id), std::move(products), std::move(owner), std::move(done)});
+    }
+    m_not_empty.notify_one();
+  }
+
+  void async_writer::drain()
+  {
+    std::unique_lock lock{m_mutex};
+    m_idle.wait(lock, [this] { return m_queue.empty() && !m_busy; });
+  }
+
+  void async_writer::close()
+  {
+    {
+      std::lock_guard lock{m_mutex};
+      if (m_closed) {
+        return;
+      }
+      m_closed = true;
+    }
+    drain();
+    m_form->close();
+  }
+
+  void async_writer::run(std::stop_token token)
+  {
+    while (true) {
+      std::optional<request> next;
+      {
+        std::unique_lock lock{m_mutex};
+        m_not_empty.wait(lock, token, [this] { return !m_queue.empty(); });
+        if (m_queue.empty()) {
+          // Stop was requested and everything has been written.
+          return;
+        }
+        next.emplace(std::move(m_queue.front()));
+        m_queue.pop_front();
+        m_busy = true;
+      }
+      m_not_full.notify_one();
+
+      std::exception_ptr error;
+      try {
+        m_form->write(next->creator, next->id, next->products);
+      } catch (...) {
+        error = std::current_exception();
+      }
+      auto done = std::move(next->done);
+      next.reset(); // Release the products before reporting completion
+      done(error);
+
+      {
+        std::lock_guard lock{m_mutex};
+        m_busy = false;
+      }
+      m_idle.notify_all();
+    }
+  }
+
+} // namespace form::experimental
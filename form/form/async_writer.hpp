@@ -0,0 +1,80 @@
+// Copyright (C) 2025 ...
+
+#ifndef __ASYNC_WRITER_HPP__
+#define __ASYNC_WRITER_HPP__
+
+#include "form/form.hpp"
+#include "form/segment_id.hpp"
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/* @class async_writer
+ * @brief Write-behind stage in front of a form_interface.
+ *
+ * Calls to write() enqueue the products of a segment and return immediately; a dedicated
+ * thread hands them to the form_interface, which serializes and compresses them.  The caller
+ * passes an owner that keeps the product data alive until it has been written.  The returned
+ * future becomes ready once the segment has been written, and holds any exception thrown while
+ * writing it; alternatively, the caller passes a function that the writer thread calls at that
+ * point, with the exception or a null pointer.  The queue is bounded: write() blocks while it is full, which pushes back on the
+ * producers.  drain() waits until everything enqueued so far has been written.  close() drains
+ * the queue and then closes the form_interface.
+ */
+namespace form::experimental {
+
+  class async_writer {
+  public:
+    async_writer(std::unique_ptr<form_interface> form, std::size_t capacity);
+    ~async_writer();
+
+    async_writer(async_writer const&) = delete;
+    async_writer& operator=(async_writer const&) = delete;
+
+    std::future<void> write(std::string const& creator,
+                            segment_id id,
+                            std::vector<product_with_name> products,
+                            std::shared_ptr<void const> owner);
+    void write(std::string const& creator,
+               segment_id id,
+               std::vector<product_with_name> products,
+               std::shared_ptr<void const> owner,
+               std::function<void(std::exception_ptr)> done);
+    void drain();
+    void close();
+
+  private:
+    struct request {
+      std::string creator;
+      segment_id id;
+      std::vector<product_with_name> products;
+      std::shared_ptr<void const> owner;
+      std::function<void(std::exception_ptr)> done;
+    };
+
+    void run(std::stop_token token);
+
+    std::unique_ptr<form_interface> m_form;
+    std::size_t m_capacity;
+    std::mutex m_mutex;
+    std::condition_variable_any m_not_empty;
+    std::condition_variable m_not_full;
+    std::condition_variable m_idle;
+    std::deque<request> m_queue;
+    bool m_busy = false;
+    bool m_closed = false;
+    std::jthread m_thread;
+  };
+
+} // namespace form::experimental
+
+#endif
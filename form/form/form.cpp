@@ -2,13 +2,16 @@
 
 #include "form.hpp"
 
+#include <algorithm>
 #include <stdexcept>
 #include <typeinfo>
+#include <utility>
 
 namespace form::experimental {
 
   form_interface::form_interface(config::output_item_config const& output_config,
-                                 config::tech_setting_config const& tech_config) :
+                                 config::tech_setting_config const& tech_config,
+                                 char output_mode) :
     m_pers(nullptr)
   {
     for (auto const& item : output_config.getItems()) {
@@ -17,13 +20,13 @@ namespace form::experimental {
                                     item.product_name, item.file_name, item.technology));
     }
 
-    m_pers = form::detail::experimental::createPersistence();
+    m_pers = form::detail::experimental::createPersistence(output_mode);
     m_pers->configureOutputItems(output_config);
     m_pers->configureTechSettings(tech_config);
   }
 
   void form_interface::write(std::string const& creator,
-                             std::string const& segment_id,
+                             segment_id const& id,
                              product_with_name const& pb)
   {
 
@@ -32,45 +35,68 @@ namespace form::experimental {
       throw std::runtime_error("No configuration found for product: " + pb.label);
     }
 
-    std::map<std::string, std::type_info const*> products = {{pb.label, pb.type}};
-    m_pers->createContainers(creator, products);
+    if (!m_pers->hasContainer(creator, pb.label)) {
+      std::map<std::string, std::type_info const*> products = {{pb.label, pb.type}};
+      m_pers->createContainers(creator, products);
+    }
 
     m_pers->registerWrite(creator, pb.label, pb.data, *pb.type);
 
-    m_pers->commitOutput(creator, segment_id);
+    m_pers->commitOutput(creator, id.key());
   }
 
   void form_interface::write(std::string const& creator,
-                             std::string const& segment_id,
+                             segment_id const& id,
                              std::vector<product_with_name> const& products)
   {
 
     if (products.empty())
       return;
 
-    auto it = m_product_to_config.find(products[0].label);
-    if (it == m_product_to_config.end()) {
-      throw std::runtime_error("No configuration found for product: " + products[0].label);
-    }
+    auto& bindings = m_bindings[creator];
+    auto found = std::ranges::find_if(
+      bindings, [&products](creator_binding const& b) { return matches(b, products); });
+    auto const& binding = (found != bindings.end()) ? *found : bind(creator, products, bindings);
 
-    // FIXME: Really only needed on first call
-    std::map<std::string, std::type_info const*> product_types;
-    for (auto const& pb : products) {
-      product_types.insert(std::make_pair(pb.label, pb.type));
+    for (std::size_t i = 0; i != products.size(); ++i) {
+      // FIXME: We could consider checking id to be identical for all product bases here
+      m_pers->registerWrite(binding.handle, i, products[i].data);
     }
 
-    m_pers->createContainers(creator, product_types);
+    m_pers->commitOutput(binding.handle, id.key());
+  }
+
+  bool form_interface::matches(creator_binding const& binding,
+                               std::vector<product_with_name> const& products)
+  {
+    return std::ranges::equal(binding.types, products, {}, {}, &product_with_name::type) &&
+           std::ranges::equal(binding.labels, products, {}, {}, &product_with_name::label);
+  }
 
+  form_interface::creator_binding const& form_interface::bind(
+    std::string const& creator,
+    std::vector<product_with_name> const& products,
+    std::vector<creator_binding>& bindings)
+  {
+    std::vector<std::pair<std::string, std::type_info const*>> product_types;
+    creator_binding binding;
+    product_types.reserve(products.size());
+    binding.types.reserve(products.size());
+    binding.labels.reserve(products.size());
     for (auto const& pb : products) {
-      // FIXME: We could consider checking id to be identical for all product bases here
-      m_pers->registerWrite(creator, pb.label, pb.data, *pb.type);
+      if (!m_product_to_config.contains(pb.label)) {
+        throw std::runtime_error("No configuration found for product: " + pb.label);
+      }
+      product_types.emplace_back(pb.label, pb.type);
+      binding.types.push_back(pb.type);
+      binding.labels.push_back(pb.label);
     }
-
-    m_pers->commitOutput(creator, segment_id);
+    binding.handle = m_pers->bindProducts(creator, product_types);
+    return bindings.emplace_back(std::move(binding));
   }
 
   void form_interface::read(std::string const& creator,
-                            std::string const& segment_id,
+                            segment_id const& id,
                             product_with_name& pb)
   {
 
@@ -79,6 +105,17 @@ namespace form::experimental {
       throw std::runtime_error("No configuration found for product: " + pb.label);
     }
 
-    m_pers->read(creator, pb.label, segment_id, &pb.data, *pb.type);
+    m_pers->read(creator, pb.label, id.key(), &pb.data, *pb.type);
+  }
+
+  std::vector<segment_id> form_interface::read_segment_ids(std::string const& creator)
+  {
+    std::vector<segment_id> ids;
+    for (auto& key : m_pers->readSegmentIds(creator)) {
+      ids.push_back(segment_id::from_key(std::move(key)));
+    }
+    return ids;
   }
+
+  void form_interface::close() { m_pers->close(); }
 }
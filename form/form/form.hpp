@@ -4,12 +4,15 @@
 #define __FORM_HPP__
 
 #include "form/config.hpp"
+#include "form/segment_id.hpp"
 #include "persistence/ipersistence.hpp"
 
+#include <cstddef>
 #include <map>
 #include <memory>
 #include <string>
 #include <typeinfo>
+#include <unordered_map>
 #include <vector>
 
 namespace form::experimental {
@@ -22,25 +25,52 @@ namespace form::experimental {
 
   class form_interface {
   public:
+    /// output_mode 'm' writes files that are merged with those of other form_interfaces
+    /// (see parallel_writer)
     form_interface(config::output_item_config const& output_config,
-                   config::tech_setting_config const& tech_config);
+                   config::tech_setting_config const& tech_config,
+                   char output_mode = 'o');
     ~form_interface() = default;
 
     void write(std::string const& creator,
-               std::string const& segment_id,
+               segment_id const& id,
                product_with_name const& product);
 
+    /// The containers of a creator's products are bound on the first call, so that later
+    /// calls with the same labels and types, in the same order, write the products by
+    /// position.  Every other set of products is bound separately, and its binding is kept
+    /// as well, so that a creator may alternate between sets.
     void write(std::string const& creator,
-               std::string const& segment_id,
+               segment_id const& id,
                std::vector<product_with_name> const& products);
 
     void read(std::string const& creator,
-              std::string const& segment_id,
+              segment_id const& id,
               product_with_name& product);
 
+    /// Segments for which the creator wrote products, in the order in which they were written
+    std::vector<segment_id> read_segment_ids(std::string const& creator);
+
+    /// Finish writing the output files.  Errors that occur while doing so are thrown here;
+    /// a form_interface that is destroyed without being closed can only print them.
+    void close();
+
   private:
+    struct creator_binding {
+      std::size_t handle;
+      std::vector<std::type_info const*> types;
+      std::vector<std::string> labels;
+    };
+
+    static bool matches(creator_binding const& binding,
+                        std::vector<product_with_name> const& products);
+    creator_binding const& bind(std::string const& creator,
+                                std::vector<product_with_name> const& products,
+                                std::vector<creator_binding>& bindings);
+
     std::unique_ptr<form::detail::experimental::IPersistence> m_pers;
     std::map<std::string, form::experimental::config::PersistenceItem> m_product_to_config;
+    std::unordered_map<std::string, std::vector<creator_binding>> m_bindings;
   };
 }
 
@@ -0,0 +1,86 @@
+// Copyright (C) 2025 ...
+
+#include "parallel_writer.hpp"
+
+#include <iostream>
+#include <stdexcept>
+
+namespace form::experimental {
+
+  parallel_writer::parallel_writer(config::output_item_config const& output_config,
+                                   config::tech_setting_config const& tech_config) :
+    m_output_config(output_config), m_tech_config(tech_config)
+  {
+  }
+
+  parallel_writer::~parallel_writer()
+  {
+    try {
+      close();
+    } catch (std::exception const& e) {
+      std::cerr << "parallel_writer: error while closing output: " << e.what() << '\n';
+    }
+  }
+
+  void parallel_writer::write(std::string const& creator,
+                              segment_id const& id,
+                              std::vector<product_with_name> const& products)
+  {
+    auto* lane = checkout(creator);
+    try {
+      lane->write(creator, id, products);
+    } catch (...) {
+      checkin(lane);
+      throw;
+    }
+    checkin(lane);
+  }
+
+  void parallel_writer::close()
+  {
+    if (m_closed) {
+      return;
+    }
+    m_closed = true;
+
+    // Closing the lanes hands their remaining buffers to the mergers, and throws if they
+    // cannot be written.  The mergers close the output files once the last lane is gone.
+    m_idle.clear();
+    for (auto& lane : m_lanes) {
+      lane->close();
+    }
+    m_lanes.clear();
+
+    // The index containers are only read, so the writing technology settings are not needed.
+    auto persistence = detail::experimental::createPersistence();
+    persistence->configureOutputItems(m_output_config);
+    persistence->configureTechSettings(config::tech_setting_config{});
+    for (auto const& creator : m_creators) {
+      persistence->rebuildIndex(creator);
+    }
+    persistence->close();
+  }
+
+  form_interface* parallel_writer::checkout(std::string const& creator)
+  {
+    std::lock_guard lock{m_mutex};
+    if (m_closed) {
+      throw std::runtime_error("parallel_writer::write called after close");
+    }
+    m_creators.insert(creator);
+    if (m_idle.empty()) {
+      m_lanes.push_back(std::make_unique<form_interface>(m_output_config, m_tech_config, 'm'));
+      return m_lanes.back().get();
+    }
+    auto* lane = m_idle.back();
+    m_idle.pop_back();
+    return lane;
+  }
+
+  void parallel_writer::checkin(form_interface* lane)
+  {
+    std::lock_guard lock{m_mutex};
+    m_idle.push_back(lane);
+  }
+
+} // namespace form::experimental
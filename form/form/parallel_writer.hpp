@@ -0,0 +1,60 @@
+// Copyright (C) 2025 ...
+
+#ifndef __PARALLEL_WRITER_HPP__
+#define __PARALLEL_WRITER_HPP__
+
+#include "form/config.hpp"
+#include "form/form.hpp"
+#include "form/segment_id.hpp"
+
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+/* @class parallel_writer
+ * @brief Writes segments from several threads concurrently into the same output files.
+ *
+ * Each call to write() borrows a form_interface (a "lane") that no other thread is using, and
+ * a new lane is created whenever all of them are busy.  The lanes serialize and compress their
+ * products independently into per-lane buffers, which are merged into the output files by
+ * the storage technology (for ROOT, a TBufferMerger per file).  Row numbers are only known
+ * once the buffers have been merged, so the segment index of each file is rebuilt from the
+ * merged index containers when the writer is closed.
+ */
+namespace form::experimental {
+
+  class parallel_writer {
+  public:
+    parallel_writer(config::output_item_config const& output_config,
+                    config::tech_setting_config const& tech_config);
+    ~parallel_writer();
+
+    parallel_writer(parallel_writer const&) = delete;
+    parallel_writer& operator=(parallel_writer const&) = delete;
+
+    /// May be called concurrently
+    void write(std::string const& creator,
+               segment_id const& id,
+               std::vector<product_with_name> const& products);
+
+    /// Merge the output of all lanes and write the segment index; no writes may be in flight
+    void close();
+
+  private:
+    form_interface* checkout(std::string const& creator);
+    void checkin(form_interface* lane);
+
+    config::output_item_config m_output_config;
+    config::tech_setting_config m_tech_config;
+    std::mutex m_mutex;
+    std::vector<std::unique_ptr<form_interface>> m_lanes;
+    std::vector<form_interface*> m_idle;
+    std::set<std::string> m_creators;
+    bool m_closed = false;
+  };
+
+} // namespace form::experimental
+
+#endif
@@ -0,0 +1,165 @@
+// Copyright (C) 2025 ...
+
+#include "read_ahead_reader.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+namespace form::experimental {
+
+  read_ahead_reader::read_ahead_reader(config::output_item_config const& input_config,
+                                       config::tech_setting_config const& tech_config,
+                                       std::size_t capacity) :
+    m_form(std::make_unique<form_interface>(input_config, tech_config)),
+    m_capacity(std::max(capacity, std::size_t{1})),
+    m_thread([this](std::stop_token token) { run(token); })
+  {
+  }
+
+  read_ahead_reader::~read_ahead_reader()
+  {
+    m_thread.request_stop();
+    m_thread.join();
+  }
+
+  void read_ahead_reader::add_product(std::string const& creator,
+                                      std::string const& label,
+                                      std::type_info const& type,
+                                      deleter destroy,
+                                      std::uint64_t layer)
+  {
+    std::lock_guard lock{m_mutex};
+    m_products.insert_or_assign({creator, label}, product_spec{&type, destroy, layer});
+  }
+
+  std::vector<segment_id> read_ahead_reader::read_segment_ids(std::string const& creator)
+  {
+    std::lock_guard lock{m_form_mutex};
+    return m_form->read_segment_ids(creator);
+  }
+
+  void read_ahead_reader::prefetch(segment_id const& id)
+  {
+    if (!id.is_binary()) {
+      // Products are registered by layer, which a text segment ID does not have
+      return;
+    }
+    {
+      std::unique_lock lock{m_mutex};
+      auto const& key = id.key();
+      if (m_pending_keys.contains(key) || m_cache.contains(key) || (m_busy && m_in_flight == key)) {
+        return;
+      }
+      while (m_pending.size() + m_cache.size() + (m_busy ? 1 : 0) >= m_capacity) {
+        if (m_cache.empty()) {
+          m_progress.wait(lock);
+          continue;
+        }
+        // The consumers lag behind by more than the window: drop the oldest segment
+        m_cache.erase(m_cache_order.front());
+        m_cache_order.pop_front();
+      }
+      m_pending.push_back(id);
+      m_pending_keys.insert(key);
+    }
+    m_scheduled.notify_one();
+  }
+
+  std::shared_ptr<void const> read_ahead_reader::read(std::string const& creator,
+                                                      segment_id const& id,
+                                                      std::string const& label)
+  {
+    product_key const product{creator, label};
+    product_spec spec;
+    {
+      std::unique_lock lock{m_mutex};
+      auto const it = m_products.find(product);
+      if (it == m_products.end()) {
+        throw std::runtime_error("read_ahead_reader: product " + label + " of creator " +
+                                 creator + " has not been registered");
+      }
+      spec = it->second;
+
+      auto const& key = id.key();
+      m_progress.wait(lock, [this, &key] {
+        return !m_pending_keys.contains(key) && !(m_busy && m_in_flight == key);
+      });
+
+      if (auto entry = m_cache.find(key); entry != m_cache.end()) {
+        if (auto cached = entry->second.find(product); cached != entry->second.end()) {
+          auto result = std::move(cached->second);
+          entry->second.erase(cached);
+          if (entry->second.empty()) {
+            m_cache.erase(entry);
+            std::erase(m_cache_order, key);
+          }
+          return result;
+        }
+      }
+    }
+    return read_product(creator, id, label, spec);
+  }
+
+  std::shared_ptr<void const> read_ahead_reader::read_product(std::string const& creator,
+                                                              segment_id const& id,
+                                                              std::string const& label,
+                                                              product_spec const& spec)
+  {
+    product_with_name pb{label, nullptr, spec.type};
+    {
+      std::lock_guard lock{m_form_mutex};
+      m_form->read(creator, id, pb);
+    }
+    return std::shared_ptr<void const>(pb.data, spec.destroy);
+  }
+
+  void read_ahead_reader::run(std::stop_token token)
+  {
+    while (true) {
+      std::optional<segment_id> id;
+      std::vector<std::pair<product_key, product_spec>> products;
+      {
+        std::unique_lock lock{m_mutex};
+        m_scheduled.wait(lock, token, [this] { return !m_pending.empty(); });
+        if (token.stop_requested()) {
+          return;
+        }
+        id.emplace(std::move(m_pending.front()));
+        m_pending.pop_front();
+        m_pending_keys.erase(id->key());
+        m_in_flight = id->key();
+        m_busy = true;
+        auto const layer = id->layer();
+        for (auto const& [product, spec] : m_products) {
+          if (spec.layer == layer) {
+            products.emplace_back(product, spec);
+          }
+        }
+      }
+
+      cache_entry entry;
+      for (auto const& [product, spec] : products) {
+        try {
+          entry.emplace(product, read_product(product.first, *id, product.second, spec));
+        } catch (std::exception const&) {
+          // Left to read(), which reports the error to the consumer of the product
+        }
+      }
+
+      {
+        std::lock_guard lock{m_mutex};
+        if (!entry.empty()) {
+          m_cache.emplace(id->key(), std::move(entry));
+          m_cache_order.push_back(id->key());
+        }
+        m_in_flight.clear();
+        m_busy = false;
+      }
+      m_progress.notify_all();
+    }
+  }
+
+} // namespace form::experimental
@@ -0,0 +1,102 @@
+// Copyright (C) 2025 ...
+
+#ifndef __READ_AHEAD_READER_HPP__
+#define __READ_AHEAD_READER_HPP__
+
+#include "form/config.hpp"
+#include "form/form.hpp"
+#include "form/segment_id.hpp"
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+/* @class read_ahead_reader
+ * @brief Read stage in front of a form_interface that fetches products before they are needed.
+ *
+ * The products to be read are registered up front, each with the layer of the segments it
+ * belongs to.  prefetch() schedules a segment, and a dedicated thread reads the registered
+ * products of that segment's layer into a cache; read() then takes a product from the cache,
+ * or reads it on demand if it was not prefetched.  A product is released from the cache once
+ * it has been taken.  At most 'capacity' segments are scheduled or cached at any time: if the
+ * window is full, prefetch() drops the oldest cached segment (whose products are then read on
+ * demand) or, if nothing has been cached yet, waits for the reading thread.  Errors of the
+ * reading thread are not reported; the product is read again, and the error raised, by read().
+ */
+namespace form::experimental {
+
+  class read_ahead_reader {
+  public:
+    using deleter = void (*)(void const*);
+
+    read_ahead_reader(config::output_item_config const& input_config,
+                      config::tech_setting_config const& tech_config,
+                      std::size_t capacity);
+    ~read_ahead_reader();
+
+    read_ahead_reader(read_ahead_reader const&) = delete;
+    read_ahead_reader& operator=(read_ahead_reader const&) = delete;
+
+    /// Products of segments in the layer are read ahead; 'destroy' deletes a product that was read
+    void add_product(std::string const& creator,
+                     std::string const& label,
+                     std::type_info const& type,
+                     deleter destroy,
+                     std::uint64_t layer);
+
+    std::vector<segment_id> read_segment_ids(std::string const& creator);
+
+    /// Schedule the registered products of the segment to be read in the background
+    void prefetch(segment_id const& id);
+
+    /// May be called concurrently
+    std::shared_ptr<void const> read(std::string const& creator,
+                                     segment_id const& id,
+                                     std::string const& label);
+
+  private:
+    using product_key = std::pair<std::string, std::string>; // Creator and label
+
+    struct product_spec {
+      std::type_info const* type;
+      deleter destroy;
+      std::uint64_t layer;
+    };
+
+    using cache_entry = std::map<product_key, std::shared_ptr<void const>>;
+
+    void run(std::stop_token token);
+    std::shared_ptr<void const> read_product(std::string const& creator,
+                                             segment_id const& id,
+                                             std::string const& label,
+                                             product_spec const& spec);
+
+    std::unique_ptr<form_interface> m_form;
+    std::mutex m_form_mutex; // form_interface is not thread-safe
+    std::size_t m_capacity;
+    std::mutex m_mutex;
+    std::condition_variable_any m_scheduled;
+    std::condition_variable m_progress;
+    std::map<product_key, product_spec> m_products;
+    std::deque<segment_id> m_pending;
+    std::set<std::string> m_pending_keys;
+    std::string m_in_flight;
+    bool m_busy = false;
+    std::map<std::string, cache_entry> m_cache;
+    std::deque<std::string> m_cache_order; // Keys in the order in which they were cached
+    std::jthread m_thread;
+  };
+
+} // namespace form::experimental
+
+#endif
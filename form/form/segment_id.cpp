@@ -0,0 +1,118 @@
+// Copyright (C) 2025 ...
+
+#include "segment_id.hpp"
+
+#include <cstdio>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+  // Binary keys start with a NUL byte, which never begins a text segment ID.  The tag is
+  // followed by the layer identifier (8 bytes, little-endian) and by one LEB128-encoded
+  // number per level.
+  constexpr char binary_tag = '\0';
+  constexpr std::size_t layer_size = 8;
+
+  void append_varint(std::string& key, std::uint64_t value)
+  {
+    while (value >= 0x80) {
+      key.push_back(static_cast<char>((value & 0x7f) | 0x80));
+      value >>= 7;
+    }
+    key.push_back(static_cast<char>(value));
+  }
+}
+
+namespace form::experimental {
+
+  segment_id::segment_id(std::string text) : m_key(std::move(text))
+  {
+    if (!m_key.empty() && m_key.front() == binary_tag) {
+      throw std::runtime_error("segment_id: a text segment ID may not start with a NUL byte");
+    }
+  }
+
+  segment_id::segment_id(char const* text) : segment_id(std::string(text)) {}
+
+  segment_id::segment_id(std::uint64_t layer, std::span<std::uint64_t const> numbers)
+  {
+    m_key.reserve(1 + layer_size + numbers.size() * 2);
+    m_key.push_back(binary_tag);
+    for (std::size_t i = 0; i != layer_size; ++i) {
+      m_key.push_back(static_cast<char>((layer >> (8 * i)) & 0xff));
+    }
+    for (auto const number : numbers) {
+      append_varint(m_key, number);
+    }
+  }
+
+  bool segment_id::is_binary() const { return !m_key.empty() && m_key.front() == binary_tag; }
+
+  segment_id segment_id::from_key(std::string key)
+  {
+    segment_id result;
+    result.m_key = std::move(key);
+    if (result.is_binary() && result.m_key.size() < 1 + layer_size) {
+      throw std::runtime_error("segment_id: binary key is too short");
+    }
+    return result;
+  }
+
+  std::uint64_t segment_id::layer() const
+  {
+    if (!is_binary()) {
+      throw std::runtime_error("segment_id: a text segment ID has no layer");
+    }
+    std::uint64_t layer = 0;
+    for (std::size_t i = 0; i != layer_size; ++i) {
+      layer |= std::uint64_t{static_cast<unsigned char>(m_key[1 + i])} << (8 * i);
+    }
+    return layer;
+  }
+
+  std::vector<std::uint64_t> segment_id::numbers() const
+  {
+    if (!is_binary()) {
+      throw std::runtime_error("segment_id: a text segment ID has no numbers");
+    }
+    std::vector<std::uint64_t> result;
+    std::uint64_t number = 0;
+    unsigned shift = 0;
+    for (std::size_t i = 1 + layer_size; i != m_key.size(); ++i) {
+      auto const byte = static_cast<unsigned char>(m_key[i]);
+      number |= std::uint64_t{byte & 0x7fu} << shift;
+      shift += 7;
+      if (byte & 0x80u) {
+        continue;
+      }
+      result.push_back(number);
+      number = 0;
+      shift = 0;
+    }
+    return result;
+  }
+
+  std::string segment_id::to_string() const
+  {
+    if (!is_binary()) {
+      return m_key;
+    }
+
+    char layer_text[32];
+    std::snprintf(
+      layer_text, sizeof(layer_text), "%016llx", static_cast<unsigned long long>(layer()));
+
+    std::string result = "[layer ";
+    result += layer_text;
+    result += ':';
+    bool first = true;
+    for (auto const number : numbers()) {
+      result += first ? " " : ", ";
+      result += std::to_string(number);
+      first = false;
+    }
+    result += ']';
+    return result;
+  }
+
+} // namespace form::experimental
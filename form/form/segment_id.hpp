@@ -0,0 +1,53 @@
+// Copyright (C) 2025 ...
+
+#ifndef __SEGMENT_ID_HPP__
+#define __SEGMENT_ID_HPP__
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+/* @class segment_id
+ * @brief Identifier of the segment (data cell) that a set of products belongs to.
+ *
+ * A segment ID is either a free-form text (e.g. "[EVENT=00000001]") or a compact binary key
+ * built from a 64-bit layer identifier and the numbers of the segment at each level of the
+ * hierarchy.  Only the key bytes are written to the index container and looked up on reading;
+ * a human-readable rendering is produced on demand by to_string().
+ */
+namespace form::experimental {
+
+  class segment_id {
+  public:
+    /// Text segment ID
+    segment_id(std::string text);
+    segment_id(char const* text);
+
+    /// Binary segment ID
+    segment_id(std::uint64_t layer, std::span<std::uint64_t const> numbers);
+
+    /// Segment ID of the bytes read back from an index container (text or binary)
+    static segment_id from_key(std::string key);
+
+    /// Bytes written to, and looked up in, the index container
+    std::string const& key() const { return m_key; }
+    bool is_binary() const;
+
+    /// Layer identifier and per-level numbers of a binary segment ID
+    std::uint64_t layer() const;
+    std::vector<std::uint64_t> numbers() const;
+
+    std::string to_string() const;
+
+    bool operator==(segment_id const& other) const = default;
+
+  private:
+    segment_id() = default;
+
+    std::string m_key;
+  };
+
+} // namespace form::experimental
+
+#endif
@@ -8,6 +8,8 @@ namespace form {
     constexpr int ROOT_TTREE_MINOR = 1;
     constexpr int ROOT_RNTUPLE_MINOR = 2;
     constexpr int HDF5_MAJOR = 2;
+    constexpr int NATIVE_MAJOR = 3;
+    constexpr int NATIVE_COLUMN_MINOR = 1;
 
     // Helper function for combining major/minor
     constexpr int Combine(int major, int minor) { return major * 256 + minor; }
@@ -16,6 +18,7 @@ namespace form {
     constexpr int ROOT_TTREE = Combine(ROOT_MAJOR, ROOT_TTREE_MINOR);
     constexpr int ROOT_RNTUPLE = Combine(ROOT_MAJOR, ROOT_RNTUPLE_MINOR);
     constexpr int HDF5 = Combine(HDF5_MAJOR, 1);
+    constexpr int NATIVE_COLUMN = Combine(NATIVE_MAJOR, NATIVE_COLUMN_MINOR);
 
     // Helper functions
     inline int GetMajor(int tech) { return tech / 256; }
@@ -0,0 +1,309 @@
+// ==============================================================================================
+// FORM input plugin: feeds the products of a file written by the FORM output module
+// (form_module.cpp) back into a Phlex graph, so that a job can be split into stages that do not
+// recompute each other's products.
+//
+// The driver replays the data cells recorded in the index container of one creator.  Data
+// cells are yielded in the order of their numbers, parents before children, starting with the
+// job.  The layers of the data cells are given from the top of the hierarchy down:
+//
+//   driver: {
+//     cpp: 'form_input',
+//     input_file: 'stage1.root',
+//     technology: 'ROOT_TTREE',
+//     creator: 'provider:provide_i',
+//     layers: ['event'],
+//     read_ahead: 32,
+//   }
+//
+// The providers of the same plugin provide the stored products, each from the creator that
+// wrote it and in the layer of its data cells:
+//
+//   sources: {
+//     stage1: {
+//       cpp: 'form_input',
+//       input_file: 'stage1.root',
+//       technology: 'ROOT_TTREE',
+//       products: {
+//         i: { creator: 'provider:provide_i', layer: 'event', type: 'int' },
+//         j: { creator: 'provider:provide_j', layer: 'event', type: 'int' },
+//       },
+//     },
+//   }
+//
+// The driver and the providers that read the same file share one reader.  While the driver
+// yields data cells, a background thread reads the products of upcoming data cells into a
+// cache of at most 'read_ahead' segments, so that the providers usually find their products in
+// memory (see form/read_ahead_reader.hpp).  Providers may also be used with another driver, in
+// which case every product is read when it is requested.
+// ==============================================================================================
+
+#include "phlex/driver.hpp"
+#include "phlex/model/data_cell_index.hpp"
+#include "phlex/source.hpp"
+
+#include "form/config.hpp"
+#include "form/read_ahead_reader.hpp"
+#include "form/segment_id.hpp"
+#include "form_plugin_helpers.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+using namespace phlex;
+
+namespace {
+
+  using form::experimental::read_ahead_reader;
+  using form::experimental::segment_id;
+
+  template <typename F>
+  void with_product_type(std::string const& type, F f)
+  {
+    if (type == "int") {
+      f.template operator()<int>();
+    } else if (type == "unsigned int") {
+      f.template operator()<unsigned int>();
+    } else if (type == "long") {
+      f.template operator()<long>();
+    } else if (type == "unsigned long") {
+      f.template operator()<unsigned long>();
+    } else if (type == "float") {
+      f.template operator()<float>();
+    } else if (type == "double") {
+      f.template operator()<double>();
+    } else if (type == "std::vector<int>") {
+      f.template operator()<std::vector<int>>();
+    } else if (type == "std::vector<float>") {
+      f.template operator()<std::vector<float>>();
+    } else if (type == "std::vector<double>") {
+      f.template operator()<std::vector<double>>();
+    } else {
+      throw std::runtime_error("FORM input: unsupported product type '" + type + "'");
+    }
+  }
+
+  // State shared by the driver and the providers that read the same file
+  class input_file {
+  public:
+    input_file(std::string name, int technology) :
+      m_name(std::move(name)), m_technology(technology)
+    {
+    }
+
+    int technology() const { return m_technology; }
+
+    template <typename T>
+    void add_product(std::string const& creator, std::string const& label, std::string const& layer)
+    {
+      std::lock_guard lock{m_mutex};
+      if (m_reader) {
+        throw std::runtime_error("FORM input: product " + label +
+                                 " was added after reading of " + m_name + " started");
+      }
+      m_products.push_back({creator, label, layer, &typeid(T), [](void const* product) {
+                              delete static_cast<T const*>(product);
+                            }});
+    }
+
+    void set_layer(std::string const& name, std::uint64_t hash)
+    {
+      std::lock_guard lock{m_mutex};
+      m_layers.insert_or_assign(name, hash);
+    }
+
+    void set_read_ahead(std::size_t read_ahead)
+    {
+      std::lock_guard lock{m_mutex};
+      m_read_ahead = read_ahead;
+    }
+
+    // The reader is created once all providers have been registered, i.e. when the first data
+    // cell is read or yielded.
+    read_ahead_reader& reader()
+    {
+      std::lock_guard lock{m_mutex};
+      if (!m_reader) {
+        form::experimental::config::output_item_config input_cfg;
+        form::experimental::config::tech_setting_config tech_cfg;
+        // The first item locates the index containers
+        input_cfg.addItem("index", m_name, m_technology);
+        for (auto const& product : m_products) {
+          input_cfg.addItem(product.label, m_name, m_technology);
+        }
+        m_reader = std::make_unique<read_ahead_reader>(input_cfg, tech_cfg, m_read_ahead);
+        for (auto const& product : m_products) {
+          // Products in layers that the driver does not replay are only read on demand
+          auto const layer = m_layers.find(product.layer);
+          m_reader->add_product(product.creator,
+                                product.label,
+                                *product.type,
+                                product.destroy,
+                                layer != m_layers.end() ? layer->second : 0);
+        }
+      }
+      return *m_reader;
+    }
+
+  private:
+    struct product {
+      std::string creator;
+      std::string label;
+      std::string layer;
+      std::type_info const* type;
+      read_ahead_reader::deleter destroy;
+    };
+
+    std::string m_name;
+    int m_technology;
+    std::mutex m_mutex;
+    std::size_t m_read_ahead = 32;
+    std::vector<product> m_products;
+    std::map<std::string, std::uint64_t> m_layers; // Layer name -> layer-path hash
+    std::unique_ptr<read_ahead_reader> m_reader;
+  };
+
+  std::shared_ptr<input_file> open_input_file(configuration const& config)
+  {
+    static std::mutex mutex;
+    static std::map<std::string, std::weak_ptr<input_file>> files;
+
+    auto const name = config.get<std::string>("input_file");
+    auto const technology = form::experimental::technology_from_string(
+      config.get<std::string>("technology", "ROOT_TTREE"));
+
+    std::lock_guard lock{mutex};
+    auto& entry = files[name];
+    auto file = entry.lock();
+    if (!file) {
+      file = std::make_shared<input_file>(name, technology);
+      entry = file;
+    } else if (file->technology() != technology) {
+      throw std::runtime_error("FORM input: " + name +
+                               " is configured with different technologies");
+    }
+    return file;
+  }
+
+  class form_input {
+  public:
+    form_input(configuration const& config) :
+      m_file(open_input_file(config)),
+      m_creator(config.get<std::string>("creator")),
+      m_layers(config.get<std::vector<std::string>>("layers")),
+      m_read_ahead(config.get<std::size_t>("read_ahead", 32))
+    {
+      m_file->set_read_ahead(m_read_ahead);
+
+      // Segment IDs are keyed by the hash of the layer path, which is that of the data cells
+      // created along the configured layers.
+      auto index = data_cell_index::base_ptr();
+      for (auto const& layer : m_layers) {
+        index = index->make_child(0, layer);
+        m_layer_hashes.push_back(index->layer_hash());
+        m_file->set_layer(layer, index->layer_hash());
+      }
+    }
+
+    void next(framework_driver& driver)
+    {
+      auto& reader = m_file->reader();
+
+      struct cell {
+        std::vector<std::uint64_t> numbers;
+        segment_id id;
+      };
+      std::vector<cell> cells;
+      for (auto& id : reader.read_segment_ids(m_creator)) {
+        if (!id.is_binary()) {
+          throw std::runtime_error("FORM input: segment " + id.to_string() + " of creator " +
+                                   m_creator + " was not written by the FORM output module");
+        }
+        auto numbers = id.numbers();
+        if (numbers.empty() || numbers.size() > m_layer_hashes.size() ||
+            id.layer() != m_layer_hashes[numbers.size() - 1]) {
+          throw std::runtime_error("FORM input: segment " + id.to_string() + " of creator " +
+                                   m_creator + " is not in the configured layers");
+        }
+        cells.push_back({std::move(numbers), std::move(id)});
+      }
+
+      // Rows of files written concurrently are not ordered; the children of a data cell must
+      // be yielded after it and together.
+      std::ranges::stable_sort(cells, {}, &cell::numbers);
+
+      // Half of the window is kept for data cells that have been yielded but whose products
+      // have not been read yet.
+      std::size_t const lookahead = std::max(m_read_ahead / 2, std::size_t{1});
+      for (std::size_t i = 0; i != std::min(lookahead, cells.size()); ++i) {
+        reader.prefetch(cells[i].id);
+      }
+
+      std::vector<data_cell_index_ptr> chain{data_cell_index::base_ptr()};
+      std::vector<std::uint64_t> chain_numbers;
+      driver.yield(chain.front());
+      for (std::size_t i = 0; i != cells.size(); ++i) {
+        if (i + lookahead < cells.size()) {
+          reader.prefetch(cells[i + lookahead].id);
+        }
+
+        auto const& numbers = cells[i].numbers;
+        auto const common = static_cast<std::size_t>(
+          std::ranges::mismatch(numbers, chain_numbers).in1 - numbers.begin());
+        if (common == numbers.size() && common == chain_numbers.size()) {
+          // The same data cell was written more than once
+          continue;
+        }
+        chain.resize(common + 1);
+        chain_numbers.resize(common);
+        // Parents for which the creator wrote no products are yielded as well
+        for (std::size_t level = common; level != numbers.size(); ++level) {
+          chain.push_back(chain.back()->make_child(numbers[level], m_layers[level]));
+          chain_numbers.push_back(numbers[level]);
+          driver.yield(chain.back());
+        }
+      }
+    }
+
+  private:
+    std::shared_ptr<input_file> m_file;
+    std::string m_creator;
+    std::vector<std::string> m_layers;
+    std::size_t m_read_ahead;
+    std::vector<std::uint64_t> m_layer_hashes;
+  };
+
+}
+
+PHLEX_EXPERIMENTAL_REGISTER_DRIVER(form_input)
+
+PHLEX_REGISTER_PROVIDERS(s, config)
+{
+  auto file = open_input_file(config);
+  auto const products = config.get<configuration>("products");
+  for (auto const& label : products.keys()) {
+    auto const product_config = products.get<configuration>(label);
+    auto const creator = product_config.get<std::string>("creator");
+    auto const layer = product_config.get<std::string>("layer");
+    with_product_type(product_config.get<std::string>("type"), [&]<typename T>() {
+      file->add_product<T>(creator, label, layer);
+      s.provide("read_" + label,
+                [file, creator, label](data_cell_index const& index) -> T {
+                  auto const product = file->reader().read(
+                    creator, form::experimental::make_segment_id(index), label);
+                  // The product was created by FORM for this call only, so it can be moved from
+                  return std::move(*const_cast<T*>(static_cast<T const*>(product.get())));
+                })
+        .output_product(product_query{experimental::product_specification::create(label), layer});
+    });
+  }
+}
@@ -1,31 +1,48 @@
+#include "phlex/model/data_cell_index.hpp"
 #include "phlex/model/product_store.hpp"
 #include "phlex/model/products.hpp"
 #include "phlex/module.hpp"
+#include "phlex/utilities/async_future.hpp"
 
 // FORM headers - these need to be available via CMake configuration
 // need to set up the build system to find these headers
+#include "form/async_writer.hpp"
 #include "form/config.hpp"
 #include "form/form.hpp"
+#include "form/parallel_writer.hpp"
+#include "form/segment_id.hpp"
 #include "form/technology.hpp"
+#include "form_plugin_helpers.hpp"
 
+#include <cstddef>
+#include <exception>
 #include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <vector>
 
 namespace {
 
+  using form::experimental::make_segment_id;
+
   class FormOutputModule {
   public:
     FormOutputModule(std::string output_file,
                      int technology,
-                     std::vector<std::string> const& products_to_save) :
+                     std::vector<std::string> const& products_to_save,
+                     form::experimental::config::tech_setting_config const& tech_cfg,
+                     std::size_t write_behind,
+                     bool parallel) :
       m_output_file(std::move(output_file)), m_technology(technology)
     {
       std::cout << "FormOutputModule initialized\n";
       std::cout << "  Output file: " << m_output_file << "\n";
       std::cout << "  Technology: " << m_technology << "\n";
+      std::cout << "  Write-behind queue: " << write_behind << "\n";
+      std::cout << "  Parallel writers: " << (parallel ? "yes" : "no") << "\n";
 
       // Build FORM configuration
       form::experimental::config::output_item_config output_cfg;
-      form::experimental::config::tech_setting_config tech_cfg;
 
       // FIXME: Temporary solution to accommodate Phlex limitation.
       // Eventually, Phlex will communicate to FORM which products will be written
@@ -37,11 +54,28 @@ namespace {
         output_cfg.addItem(product, m_output_file, m_technology);
       }
 
+      if (parallel) {
+        // Each concurrent call writes into its own buffers, which are merged into the output file
+        m_parallel_writer =
+          std::make_unique<form::experimental::parallel_writer>(output_cfg, tech_cfg);
+        return;
+      }
+
       // Initialize FORM interface
-      m_form_interface = std::make_unique<form::experimental::form_interface>(output_cfg, tech_cfg);
+      auto form_interface =
+        std::make_unique<form::experimental::form_interface>(output_cfg, tech_cfg);
+      if (write_behind > 0) {
+        // Products are written by a dedicated thread; the queue of pending segments is bounded
+        // by write_behind entries.
+        m_writer =
+          std::make_unique<form::experimental::async_writer>(std::move(form_interface), write_behind);
+      } else {
+        m_form_interface = std::move(form_interface);
+      }
     }
 
-    // This method is called by Phlex - signature must be: void(product_store const&)
+    // This method is called by Phlex when the products are written synchronously, either
+    // directly or through the parallel writers.
     void save_data_products(phlex::experimental::product_store const& store)
     {
       // Check if store is empty - smart way, check store not products vector
@@ -49,17 +83,73 @@ namespace {
         return;
       }
 
-      // STEP 1: Extract metadata from Phlex's product_store
+      auto const segment_id = make_segment_id(*store.index());
+      auto const products = collect_products(store);
 
-      // Extract creator (algorithm name)
-      std::string creator = store.source();
+      // STEP 3: Send everything to FORM for persistence
 
-      // Extract segment ID (partition) - extract once for entire store
-      std::string segment_id = store.index()->to_string();
+      // Write all products to FORM
+      // Pass segment_id once for entire collection (not duplicated in each product)
+      // No need to check if products is empty - already checked store.empty() above
+      if (m_parallel_writer) {
+        m_parallel_writer->write(store.source(), segment_id, products);
+      } else {
+        m_form_interface->write(store.source(), segment_id, products);
+      }
+    }
+
+    // This method is called by Phlex when the products are written by the write-behind thread.
+    // The shared pointer keeps the products alive until they have been written, and the
+    // write-behind thread completes the returned future at that point.
+    phlex::experimental::async_future<void> queue_data_products(
+      phlex::experimental::product_store_const_ptr const& store_ptr)
+    {
+      auto written = std::make_shared<phlex::experimental::async_promise<void>>();
+      auto result = written->get_future();
+      auto const& store = *store_ptr;
+      if (store.empty()) {
+        written->set_value();
+        return result;
+      }
+
+      auto products = collect_products(store);
+      m_writer->write(store.source(),
+                      make_segment_id(*store.index()),
+                      std::move(products),
+                      store_ptr,
+                      [written](std::exception_ptr error) {
+                        if (error) {
+                          written->set_exception(error);
+                        } else {
+                          written->set_value();
+                        }
+                      });
+      return result;
+    }
+
+    // Called by Phlex once all data cells have been processed; failures to complete the
+    // output file are reported to the framework.
+    void close()
+    {
+      if (m_parallel_writer) {
+        m_parallel_writer->close();
+      } else if (m_writer) {
+        m_writer->close();
+      } else {
+        m_form_interface->close();
+      }
+    }
 
+  private:
+    static std::vector<form::experimental::product_with_name> collect_products(
+      phlex::experimental::product_store const& store)
+    {
+      // STEP 1: Extract metadata from Phlex's product_store
+      // The compact binary segment key is written to the file; the text form is only for
+      // printing.
       std::cout << "\n=== FormOutputModule::save_data_products ===\n";
-      std::cout << "Creator: " << creator << "\n";
-      std::cout << "Segment ID: " << segment_id << "\n";
+      std::cout << "Creator: " << store.source() << "\n";
+      std::cout << "Segment ID: " << store.index()->to_string() << "\n";
       std::cout << "Number of products: " << store.size() << "\n";
 
       // STEP 2: Convert each Phlex product to FORM format
@@ -83,20 +173,14 @@ namespace {
                               &product_ptr->type()    // type, from phlex product_base
         );
       }
-
-      // STEP 3: Send everything to FORM for persistence
-
-      // Write all products to FORM
-      // Pass segment_id once for entire collection (not duplicated in each product)
-      // No need to check if products is empty - already checked store.empty() above
-      m_form_interface->write(creator, segment_id, products);
-      std::cout << "Wrote " << products.size() << " products to FORM\n";
+      return products;
     }
 
-  private:
     std::string m_output_file;
     int m_technology;
     std::unique_ptr<form::experimental::form_interface> m_form_interface;
+    std::unique_ptr<form::experimental::async_writer> m_writer;
+    std::unique_ptr<form::experimental::parallel_writer> m_parallel_writer;
   };
 
 }
@@ -114,27 +198,56 @@ PHLEX_REGISTER_ALGORITHMS(m, config)
   std::cout << "  technology: " << tech_string << "\n";
 
   // Map Phlex config string to FORM technology constant
-  int technology = form::technology::ROOT_TTREE; // default
-
-  if (tech_string == "ROOT_TTREE") {
-    technology = form::technology::ROOT_TTREE;
-  } else if (tech_string == "ROOT_RNTUPLE") {
-    technology = form::technology::ROOT_RNTUPLE;
-  } else if (tech_string == "HDF5") {
-    technology = form::technology::HDF5;
-  } else {
-    throw std::runtime_error("Unknown technology: " + tech_string);
-  }
+  int const technology = form::experimental::technology_from_string(tech_string);
 
   auto products_to_save = config.get<std::vector<std::string>>("products");
 
+  // Settings of the output file: the compression algorithm and level (e.g. 'kZSTD:5'), and the
+  // number of threads with which ROOT compresses baskets and pages in parallel (ROOT only)
+  form::experimental::config::tech_setting_config tech_cfg;
+  auto& file_settings = tech_cfg.file_settings[technology][output_file];
+  if (auto const compression = config.get<std::string>("compression", ""); !compression.empty()) {
+    file_settings.emplace_back("compression", compression);
+  }
+  if (auto const implicit_mt = config.get<unsigned int>("implicit_mt", 0); implicit_mt > 0) {
+    file_settings.emplace_back("implicit_mt", std::to_string(implicit_mt));
+  }
+
+  // Write from all calling threads concurrently, merging their output into one file
+  auto const parallel = config.get<bool>("parallel", false);
+
+  // Number of segments that may wait for the write-behind thread.  The default, 0, writes
+  // synchronously.  With a write-behind queue, a write error is reported only once the
+  // write-behind thread reaches the failed segment, after later segments have been queued.
+  auto const write_behind = config.get<std::size_t>("write_behind", 0);
+  if (parallel && write_behind > 0) {
+    throw std::runtime_error("FORM output: 'parallel' and 'write_behind' cannot be combined");
+  }
+
   // Phlex needs an OBJECT
   // Create the FORM output module
-  auto form_output = m.make<FormOutputModule>(output_file, technology, products_to_save);
+  auto form_output =
+    m.make<FormOutputModule>(
+      output_file, technology, products_to_save, tech_cfg, write_behind, parallel);
 
   // Phlex needs a MEMBER FUNCTION to call
-  // Register the callback that Phlex will invoke
-  form_output.output("save_data_products", &FormOutputModule::save_data_products);
+  // Register the callback that Phlex will invoke.  With the write-behind queue, the callback
+  // only enqueues the products and returns a future; at most write_behind segments are in
+  // flight, and further stores wait in the graph rather than blocking worker threads.
+  // Parallel writers can be called concurrently.
+  if (write_behind > 0) {
+    form_output
+      .output("save_data_products",
+              &FormOutputModule::queue_data_products,
+              phlex::concurrency{write_behind})
+      .experimental_at_end_of_job(&FormOutputModule::close);
+  } else {
+    form_output
+      .output("save_data_products",
+              &FormOutputModule::save_data_products,
+              parallel ? phlex::concurrency::unlimited : phlex::concurrency::serial)
+      .experimental_at_end_of_job(&FormOutputModule::close);
+  }
 
   std::cout << "FORM output module registered successfully\n";
 }
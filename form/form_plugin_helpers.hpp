@@ -0,0 +1,53 @@
+// Copyright (C) 2025 ...
+
+#ifndef __FORM_PLUGIN_HELPERS_HPP__
+#define __FORM_PLUGIN_HELPERS_HPP__
+
+// Helpers shared by the FORM output module (form_module.cpp) and input plugin (form_input.cpp)
+
+#include "phlex/model/data_cell_index.hpp"
+
+#include "form/segment_id.hpp"
+#include "form/technology.hpp"
+
+#include <cstdint>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace form::experimental {
+
+  /// Binary segment ID made of the layer-path hash and the data-cell numbers of each level
+  inline segment_id make_segment_id(phlex::data_cell_index const& index)
+  {
+    std::vector<std::uint64_t> numbers(index.depth());
+    auto const* cell = &index;
+    for (auto& number : numbers | std::views::reverse) {
+      number = cell->number();
+      cell = cell->parent().get();
+    }
+    return {index.layer_hash(), numbers};
+  }
+
+  /// Map a Phlex configuration string to a FORM technology constant
+  inline int technology_from_string(std::string const& tech_string)
+  {
+    if (tech_string == "ROOT_TTREE") {
+      return form::technology::ROOT_TTREE;
+    }
+    if (tech_string == "ROOT_RNTUPLE") {
+      return form::technology::ROOT_RNTUPLE;
+    }
+    if (tech_string == "HDF5") {
+      return form::technology::HDF5;
+    }
+    if (tech_string == "NATIVE_COLUMN") {
+      return form::technology::NATIVE_COLUMN;
+    }
+    throw std::runtime_error("Unknown technology: " + tech_string);
+  }
+
+}
+
+#endif
@@ -0,0 +1,310 @@
+// Copyright (C) 2025 ...
+
+#include "native_column_container.hpp"
+#include "native_file.hpp"
+#include "native_type.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+
+using namespace form::detail::experimental;
+
+namespace {
+  // On-disk layout of a column file (native byte order):
+  //   Header, type name, padding to 8 bytes, records
+  // and of the offsets file of a column with variable-size records:
+  //   end offset (relative to the first record) of every record, as std::uint64_t
+  // Every variable-size record starts at the first multiple of 8 bytes after the end of the
+  // previous one, so that its elements are aligned in the mapped file.
+  constexpr char columnMagic[8] = {'F', 'O', 'R', 'M', 'C', 'O', 'L', 'S'};
+  constexpr std::uint64_t columnVersion = 2;
+
+  struct Header {
+    char magic[8];
+    std::uint64_t version;
+    std::uint64_t recordSize;
+    std::uint64_t typeNameSize;
+  };
+
+  std::uint64_t align8(std::uint64_t offset) { return (offset + 7) & ~std::uint64_t{7}; }
+
+  std::FILE* openForWriting(std::string const& path, std::vector<char>& buffer)
+  {
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (file == nullptr) {
+      throw std::runtime_error("Native_Column_ContainerImp can't create " + path);
+    }
+    std::setvbuf(file, buffer.data(), _IOFBF, buffer.size());
+    return file;
+  }
+}
+
+Native_Column_ContainerImp::Mapping::~Mapping() { close(); }
+
+void Native_Column_ContainerImp::Mapping::open(std::string const& path)
+{
+  close();
+  int const fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("Native_Column_ContainerImp can't open " + path);
+  }
+  struct stat st;
+  if (::fstat(fd, &st) != 0) {
+    ::close(fd);
+    throw std::runtime_error("Native_Column_ContainerImp can't stat " + path);
+  }
+  m_size = static_cast<std::size_t>(st.st_size);
+  if (m_size > 0) {
+    void* map = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (map == MAP_FAILED) {
+      ::close(fd);
+      m_size = 0;
+      throw std::runtime_error("Native_Column_ContainerImp can't map " + path);
+    }
+    m_map = map;
+    m_data = static_cast<char const*>(map);
+  }
+  ::close(fd);
+}
+
+void Native_Column_ContainerImp::Mapping::close()
+{
+  if (m_map != nullptr) {
+    ::munmap(m_map, m_size);
+  }
+  m_map = nullptr;
+  m_data = nullptr;
+  m_size = 0;
+}
+
+Native_Column_ContainerImp::Native_Column_ContainerImp(std::string const& name) :
+  Storage_Container(name),
+  m_nativeFile(nullptr),
+  m_bufferSize(1 << 20),
+  m_type(nullptr),
+  m_data(nullptr),
+  m_offsets(nullptr),
+  m_dataSize(0),
+  m_rows(0),
+  m_recordSize(0),
+  m_dataStart(0),
+  m_mappedRows(0),
+  m_mapped(false)
+{
+}
+
+Native_Column_ContainerImp::~Native_Column_ContainerImp()
+{
+  // Columns that are not closed explicitly are still written, but errors can then only be
+  // reported here.
+  try {
+    close();
+  } catch (std::exception const& e) {
+    std::cerr << e.what() << '\n';
+  }
+}
+
+void Native_Column_ContainerImp::close()
+{
+  if (m_data == nullptr) {
+    return;
+  }
+  bool failed = false;
+  for (std::FILE** file : {&m_data, &m_offsets}) {
+    if (*file != nullptr) {
+      failed |= std::fflush(*file) != 0;
+      failed |= std::fclose(*file) != 0;
+      *file = nullptr;
+    }
+  }
+  // Records written since the column was mapped become visible once it is mapped again
+  m_mapped = false;
+  if (failed) {
+    throw std::runtime_error("Native_Column_ContainerImp::close failed to write column " +
+                             name());
+  }
+}
+
+void Native_Column_ContainerImp::setAttribute(std::string const& key, std::string const& value)
+{
+  if (key == "buffer_size") {
+    m_bufferSize = std::stoul(value);
+  } else {
+    throw std::runtime_error("Native_Column_ContainerImp accepts some attributes, but not " + key);
+  }
+}
+
+void Native_Column_ContainerImp::setFile(std::shared_ptr<IStorage_File> file)
+{
+  this->Storage_Container::setFile(file);
+  m_nativeFile = dynamic_cast<Native_File*>(file.get());
+  if (m_nativeFile == nullptr) {
+    throw std::runtime_error(
+      "Native_Column_ContainerImp::setFile can't attach to non-native file");
+  }
+  m_dataPath = m_nativeFile->columnPath(name(), ".col");
+  m_offsetsPath = m_nativeFile->columnPath(name(), ".off");
+  return;
+}
+
+void Native_Column_ContainerImp::setupWrite(std::type_info const& type)
+{
+  if (m_nativeFile == nullptr) {
+    throw std::runtime_error("Native_Column_ContainerImp::setupWrite no file attached");
+  }
+  if (m_data != nullptr) {
+    return;
+  }
+  m_type = findNativeType(type);
+  if (m_type == nullptr) {
+    throw std::runtime_error(std::string{"Native_Column_ContainerImp::setupWrite unsupported type: "} +
+                             type.name());
+  }
+
+  m_dataBuffer.resize(m_bufferSize);
+  m_data = openForWriting(m_dataPath, m_dataBuffer);
+  Header header{};
+  std::memcpy(header.magic, columnMagic, sizeof(columnMagic));
+  header.version = columnVersion;
+  header.recordSize = m_type->recordSize;
+  header.typeNameSize = m_type->name.size();
+  write(m_data, &header, sizeof(header));
+  write(m_data, m_type->name.data(), m_type->name.size());
+  char const padding[8] = {};
+  write(m_data, padding, align8(sizeof(header) + m_type->name.size()) - sizeof(header) -
+                           m_type->name.size());
+
+  if (m_type->recordSize == 0) {
+    m_offsetsBuffer.resize(m_bufferSize / 8);
+    m_offsets = openForWriting(m_offsetsPath, m_offsetsBuffer);
+  }
+  return;
+}
+
+void Native_Column_ContainerImp::fill(void const* data)
+{
+  if (m_data == nullptr) {
+    throw std::runtime_error("Native_Column_ContainerImp::fill column not set up for writing: " +
+                             name());
+  }
+  if (m_type->recordSize != 0) {
+    write(m_data, data, m_type->recordSize);
+  } else {
+    auto const [bytes, size] = m_type->bytes(data);
+    char const padding[8] = {};
+    write(m_data, padding, align8(m_dataSize) - m_dataSize);
+    write(m_data, bytes, size);
+    m_dataSize = align8(m_dataSize) + size;
+    write(m_offsets, &m_dataSize, sizeof(m_dataSize));
+  }
+  ++m_rows;
+  return;
+}
+
+void Native_Column_ContainerImp::commit()
+{
+  // Records are appended as they are filled
+  return;
+}
+
+bool Native_Column_ContainerImp::read(int id, void const** data, std::type_info const& type)
+{
+  if (id < 0) {
+    return false;
+  }
+  auto const record = view(static_cast<std::uint64_t>(id));
+  if (record.data() == nullptr) {
+    return false;
+  }
+  auto const* nativeType = findNativeType(type);
+  if (nativeType == nullptr || nativeType->name != m_typeName) {
+    throw std::runtime_error(std::string{"Native_Column_ContainerImp::read column "} + name() +
+                             " holds " + m_typeName + ", not " + type.name());
+  }
+  *data = nativeType->create(record.data(), record.size());
+  return true;
+}
+
+std::uint64_t Native_Column_ContainerImp::rows()
+{
+  if (m_data != nullptr) {
+    return m_rows;
+  }
+  if (!m_mapped) {
+    mapColumn();
+  }
+  return m_mappedRows;
+}
+
+std::span<char const> Native_Column_ContainerImp::view(std::uint64_t row)
+{
+  // Records written since the column was mapped become visible once it is mapped again
+  if (!m_mapped || (m_data != nullptr && row >= m_mappedRows && row < m_rows)) {
+    mapColumn();
+  }
+  if (row >= m_mappedRows) {
+    return {};
+  }
+  char const* records = m_dataMap.data() + m_dataStart;
+  if (m_recordSize != 0) {
+    return {records + row * m_recordSize, m_recordSize};
+  }
+  auto const* ends = reinterpret_cast<std::uint64_t const*>(m_offsetsMap.data());
+  std::uint64_t const begin = (row == 0) ? 0 : align8(ends[row - 1]);
+  return {records + begin, ends[row] - begin};
+}
+
+void Native_Column_ContainerImp::write(std::FILE* file, void const* bytes, std::size_t size)
+{
+  if (size != 0 && std::fwrite(bytes, 1, size, file) != size) {
+    throw std::runtime_error("Native_Column_ContainerImp::write failed for column " + name());
+  }
+}
+
+void Native_Column_ContainerImp::mapColumn()
+{
+  if (m_nativeFile == nullptr) {
+    throw std::runtime_error("Native_Column_ContainerImp::read no file attached");
+  }
+  if (m_data != nullptr) {
+    std::fflush(m_data);
+    if (m_offsets != nullptr) {
+      std::fflush(m_offsets);
+    }
+  }
+
+  m_dataMap.open(m_dataPath);
+  Header header;
+  if (m_dataMap.size() < sizeof(header)) {
+    throw std::runtime_error("Native_Column_ContainerImp::read truncated column " + m_dataPath);
+  }
+  std::memcpy(&header, m_dataMap.data(), sizeof(header));
+  if (std::memcmp(header.magic, columnMagic, sizeof(columnMagic)) != 0 ||
+      header.version != columnVersion ||
+      align8(sizeof(header) + header.typeNameSize) > m_dataMap.size()) {
+    throw std::runtime_error("Native_Column_ContainerImp::read invalid column " + m_dataPath);
+  }
+  m_typeName.assign(m_dataMap.data() + sizeof(header), header.typeNameSize);
+  m_recordSize = header.recordSize;
+  m_dataStart = align8(sizeof(header) + header.typeNameSize);
+
+  if (m_recordSize != 0) {
+    m_mappedRows = (m_dataMap.size() - m_dataStart) / m_recordSize;
+  } else {
+    m_offsetsMap.open(m_offsetsPath);
+    m_mappedRows = m_offsetsMap.size() / sizeof(std::uint64_t);
+    if (m_mappedRows != 0 && reinterpret_cast<std::uint64_t const*>(
+                               m_offsetsMap.data())[m_mappedRows - 1] >
+                               m_dataMap.size() - m_dataStart) {
+      throw std::runtime_error("Native_Column_ContainerImp::read truncated column " + m_dataPath);
+    }
+  }
+  m_mapped = true;
+  return;
+}
@@ -0,0 +1,105 @@
+// Copyright (C) 2025 ...
+
+#ifndef __NATIVE_COLUMN_CONTAINER_HPP__
+#define __NATIVE_COLUMN_CONTAINER_HPP__
+
+#include "storage/storage_container.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <span>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+/* @class Native_Column_ContainerImp
+ * @brief Append-only column of the records of one container, without any dependency on ROOT.
+ *
+ * The column file starts with a header that records the record size and the name of the type
+ * (see Native_Type), followed by the records.  Fixed-size records are stored back to back and
+ * are aligned for their type; variable-size records start at multiples of 8 bytes and are
+ * located through a second file holding the end offset of every record.  A view() of either
+ * can thus be reinterpreted as objects or elements of alignment up to 8 without a copy.  Both
+ * files are written through large buffers and are memory-mapped for reading: view() returns a record without copying it, while read() returns
+ * a new object, as for all containers.
+ */
+namespace form::detail::experimental {
+
+  class Native_File;
+  struct Native_Type;
+
+  class Native_Column_ContainerImp : public Storage_Container {
+  public:
+    Native_Column_ContainerImp(std::string const& name);
+    ~Native_Column_ContainerImp();
+
+    Native_Column_ContainerImp(Native_Column_ContainerImp const&) = delete;
+    Native_Column_ContainerImp& operator=(Native_Column_ContainerImp const&) = delete;
+
+    void setAttribute(std::string const& key, std::string const& value) override;
+    void setFile(std::shared_ptr<IStorage_File> file) override;
+
+    void setupWrite(std::type_info const& type = typeid(void)) override;
+    void fill(void const* data) override;
+    void commit() override;
+    bool read(int id, void const** data, std::type_info const& type) override;
+    /// Flush and close the column files; throws if their data cannot be written
+    void close() override;
+
+    /// Number of records, or of records written so far
+    std::uint64_t rows();
+    /// Bytes of a record in the memory-mapped column; valid until the container is destroyed
+    /// or written to.  Returns an empty span if there is no such record.
+    std::span<char const> view(std::uint64_t row);
+
+  private:
+    class Mapping {
+    public:
+      Mapping() = default;
+      ~Mapping();
+      Mapping(Mapping const&) = delete;
+      Mapping& operator=(Mapping const&) = delete;
+
+      void open(std::string const& path);
+      void close();
+      char const* data() const { return m_data; }
+      std::size_t size() const { return m_size; }
+
+    private:
+      void* m_map = nullptr;
+      char const* m_data = nullptr;
+      std::size_t m_size = 0;
+    };
+
+    void write(std::FILE* file, void const* bytes, std::size_t size);
+    void mapColumn();
+
+    Native_File* m_nativeFile;
+    std::string m_dataPath;
+    std::string m_offsetsPath;
+    std::size_t m_bufferSize;
+
+    // Writing
+    Native_Type const* m_type;
+    std::FILE* m_data;
+    std::FILE* m_offsets;
+    std::vector<char> m_dataBuffer;
+    std::vector<char> m_offsetsBuffer;
+    std::uint64_t m_dataSize;
+    std::uint64_t m_rows;
+
+    // Reading
+    Mapping m_dataMap;
+    Mapping m_offsetsMap;
+    std::string m_typeName;
+    std::uint64_t m_recordSize;
+    std::uint64_t m_dataStart;
+    std::uint64_t m_mappedRows;
+    bool m_mapped;
+  };
+
+} // namespace form::detail::experimental
+
+#endif
@@ -0,0 +1,75 @@
+// Copyright (C) 2025 ...
+
+#include "native_file.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+using namespace form::detail::experimental;
+
+namespace {
+  // Marks a directory as a native file, so that only such directories are reused for output
+  constexpr char markerName[] = ".form_native";
+
+  void prepareDirectory(std::string const& name)
+  {
+    namespace fs = std::filesystem;
+    fs::path const dir{name};
+    if (fs::exists(dir)) {
+      if (!fs::is_directory(dir)) {
+        throw std::runtime_error("Native_File can't replace " + name +
+                                 ", which is not a directory");
+      }
+      if (!fs::is_empty(dir) && !fs::exists(dir / markerName)) {
+        throw std::runtime_error("Native_File won't write into " + name +
+                                 ", a non-empty directory that is not a native file");
+      }
+      // Remove the columns of a previous file, and nothing else
+      for (auto const& entry : fs::directory_iterator{dir}) {
+        auto const extension = entry.path().extension();
+        if (entry.is_regular_file() && (extension == ".col" || extension == ".off")) {
+          fs::remove(entry.path());
+        }
+      }
+    } else {
+      fs::create_directories(dir);
+    }
+    if (!std::ofstream{dir / markerName}) {
+      throw std::runtime_error("Native_File can't create " + name);
+    }
+  }
+}
+
+Native_File::Native_File(std::string const& name, char mode) : Storage_File(name, mode)
+{
+  if (mode == 'c' || mode == 'r' || mode == 'o') {
+    prepareDirectory(name);
+  } else if (mode == 'm') {
+    throw std::runtime_error("Native_File can't merge the output of several writers into " +
+                             name);
+  } else if (!std::filesystem::is_directory(name)) {
+    throw std::runtime_error("Native_File can't open " + name);
+  }
+}
+
+void Native_File::setAttribute(std::string const& key, std::string const& /*value*/)
+{
+  throw std::runtime_error("Native_File does not recognize an attribute named " + key);
+}
+
+std::string Native_File::columnPath(std::string const& containerName, char const* extension)
+{
+  // Container names are "creator/label"; escape them into a single file name
+  std::string path = name() + '/';
+  for (char c : containerName) {
+    if (c == '/') {
+      path += "%2F";
+    } else if (c == '%') {
+      path += "%25";
+    } else {
+      path += c;
+    }
+  }
+  return path + extension;
+}
@@ -0,0 +1,32 @@
+// Copyright (C) 2025 ...
+
+#ifndef __NATIVE_FILE_HPP__
+#define __NATIVE_FILE_HPP__
+
+#include "storage/storage_file.hpp"
+
+#include <string>
+
+/* @class Native_File
+ * @brief A directory that holds one column file per container.
+ *
+ * The directory is marked as a native file when it is created.  Opening it for output removes
+ * the column files of a previous native file, but an existing directory that is not empty and
+ * not marked is never written into.
+ */
+namespace form::detail::experimental {
+
+  class Native_File : public Storage_File {
+  public:
+    Native_File(std::string const& name, char mode);
+    ~Native_File() = default;
+
+    void setAttribute(std::string const& key, std::string const& value) override;
+
+    /// Path of the column file of a container, with the given extension
+    std::string columnPath(std::string const& containerName, char const* extension);
+  };
+
+} // namespace form::detail::experimental
+
+#endif
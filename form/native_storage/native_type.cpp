@@ -0,0 +1,78 @@
+// Copyright (C) 2025 ...
+
+#include "native_type.hpp"
+
+#include <mutex>
+#include <typeindex>
+#include <unordered_map>
+
+using namespace form::detail::experimental;
+
+namespace {
+  struct Registry {
+    std::mutex mutex;
+    std::unordered_map<std::type_index, Native_Type> types;
+
+    template <typename T>
+    void add(std::string name)
+    {
+      types.emplace(typeid(T), makeNativeType<T>(std::move(name)));
+    }
+
+    Registry()
+    {
+      add<bool>("bool");
+      add<char>("char");
+      add<signed char>("signed char");
+      add<unsigned char>("unsigned char");
+      add<short>("short");
+      add<unsigned short>("unsigned short");
+      add<int>("int");
+      add<unsigned int>("unsigned int");
+      add<long>("long");
+      add<unsigned long>("unsigned long");
+      add<long long>("long long");
+      add<unsigned long long>("unsigned long long");
+      add<float>("float");
+      add<double>("double");
+      add<std::string>("std::string");
+      add<std::vector<char>>("std::vector<char>");
+      add<std::vector<unsigned char>>("std::vector<unsigned char>");
+      add<std::vector<short>>("std::vector<short>");
+      add<std::vector<unsigned short>>("std::vector<unsigned short>");
+      add<std::vector<int>>("std::vector<int>");
+      add<std::vector<unsigned int>>("std::vector<unsigned int>");
+      add<std::vector<long>>("std::vector<long>");
+      add<std::vector<unsigned long>>("std::vector<unsigned long>");
+      add<std::vector<long long>>("std::vector<long long>");
+      add<std::vector<unsigned long long>>("std::vector<unsigned long long>");
+      add<std::vector<float>>("std::vector<float>");
+      add<std::vector<double>>("std::vector<double>");
+    }
+  };
+
+  Registry& registry()
+  {
+    static Registry instance;
+    return instance;
+  }
+}
+
+namespace form::detail::experimental {
+
+  void registerNativeType(std::type_info const& type, Native_Type nativeType)
+  {
+    auto& reg = registry();
+    std::lock_guard lock{reg.mutex};
+    reg.types.insert_or_assign(type, std::move(nativeType));
+  }
+
+  Native_Type const* findNativeType(std::type_info const& type)
+  {
+    auto& reg = registry();
+    std::lock_guard lock{reg.mutex};
+    auto found = reg.types.find(type);
+    return (found != reg.types.end()) ? &found->second : nullptr;
+  }
+
+} // namespace form::detail::experimental
@@ -0,0 +1,99 @@
+// Copyright (C) 2025 ...
+
+#ifndef __NATIVE_TYPE_HPP__
+#define __NATIVE_TYPE_HPP__
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+/* @struct Native_Type
+ * @brief How objects of a type are stored as records of a native column.
+ *
+ * Trivially-copyable types (including aggregates of fundamental members) are stored as
+ * fixed-size records holding the bytes of the object.  Strings and vectors of trivially-copyable
+ * elements are stored as variable-size records holding the bytes of their elements.  The
+ * fundamental types, std::string and vectors of fundamental types are known; other types are
+ * added with form::experimental::register_native_type.
+ */
+namespace form::detail::experimental {
+
+  struct Native_Type {
+    std::string name;       // Stable name, recorded in the column file
+    std::size_t recordSize; // Size of every record, or 0 if the records have variable size
+    /// Pointer to and size of the bytes of a variable-size record
+    std::pair<void const*, std::size_t> (*bytes)(void const* object);
+    /// New object holding the record
+    void* (*create)(char const* record, std::size_t size);
+  };
+
+  void registerNativeType(std::type_info const& type, Native_Type nativeType);
+  /// Returns nullptr if the type cannot be stored in native columns
+  Native_Type const* findNativeType(std::type_info const& type);
+
+  template <typename T>
+  concept native_record = std::is_trivially_copyable_v<T> && std::is_default_constructible_v<T>;
+
+  template <typename T>
+  struct is_native_vector : std::false_type {};
+  template <native_record T>
+    requires(!std::is_same_v<T, bool>)
+  struct is_native_vector<std::vector<T>> : std::true_type {};
+
+  // Records are only aligned to 8 bytes in the mapped column files
+  constexpr std::size_t maxNativeAlignment = 8;
+
+  template <typename T>
+  Native_Type makeNativeType(std::string name)
+  {
+    if constexpr (native_record<T>) {
+      static_assert(alignof(T) <= maxNativeAlignment, "native records are aligned to 8 bytes");
+      return {std::move(name), sizeof(T), nullptr, [](char const* record, std::size_t) -> void* {
+                auto* object = new T;
+                std::memcpy(static_cast<void*>(object), record, sizeof(T));
+                return object;
+              }};
+    } else if constexpr (is_native_vector<T>::value || std::is_same_v<T, std::string>) {
+      using element_t = typename T::value_type;
+      static_assert(alignof(element_t) <= maxNativeAlignment,
+                    "native records are aligned to 8 bytes");
+      return {std::move(name),
+              0,
+              [](void const* object) -> std::pair<void const*, std::size_t> {
+                auto const& container = *static_cast<T const*>(object);
+                return {container.data(), container.size() * sizeof(element_t)};
+              },
+              [](char const* record, std::size_t size) -> void* {
+                auto* object = new T(size / sizeof(element_t), element_t{});
+                if (size != 0) {
+                  std::memcpy(static_cast<void*>(object->data()), record, size);
+                }
+                return object;
+              }};
+    } else {
+      static_assert(
+        native_record<T>,
+        "native columns hold trivially-copyable types, std::string, and vectors of those");
+    }
+  }
+
+} // namespace form::detail::experimental
+
+namespace form::experimental {
+
+  /// Allow products of type T to be written to native columns; the name is recorded in the
+  /// column files and checked when they are read.
+  template <typename T>
+  void register_native_type(std::string name)
+  {
+    detail::experimental::registerNativeType(
+      typeid(T), detail::experimental::makeNativeType<T>(std::move(name)));
+  }
+
+} // namespace form::experimental
+
+#endif
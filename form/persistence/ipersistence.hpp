@@ -3,10 +3,13 @@
 #ifndef __IPERSISTENCE_HPP__
 #define __IPERSISTENCE_HPP__
 
+#include <cstddef>
 #include <map>
 #include <memory>
 #include <string>
 #include <typeinfo>
+#include <utility>
+#include <vector>
 
 namespace form::experimental::config {
   class output_item_config;
@@ -26,6 +29,7 @@ namespace form::detail::experimental {
     virtual void configureOutputItems(
       form::experimental::config::output_item_config const& outputItems) = 0;
 
+    virtual bool hasContainer(std::string const& creator, std::string const& label) const = 0;
     virtual void createContainers(std::string const& creator,
                                   std::map<std::string, std::type_info const*> const& products) = 0;
     virtual void registerWrite(std::string const& creator,
@@ -34,14 +38,34 @@ namespace form::detail::experimental {
                                std::type_info const& type) = 0;
     virtual void commitOutput(std::string const& creator, std::string const& id) = 0;
 
+    /// Resolve the containers of the creator's products once, creating those that do not exist
+    /// yet.  The returned handle writes the products by their position in 'products', without
+    /// looking up containers; it stays valid for the lifetime of the persistence.  Binding the
+    /// same labels of a creator again, in the same order, returns the same handle.
+    virtual std::size_t bindProducts(
+      std::string const& creator,
+      std::vector<std::pair<std::string, std::type_info const*>> const& products) = 0;
+    virtual void registerWrite(std::size_t binding, std::size_t product, void const* data) = 0;
+    virtual void commitOutput(std::size_t binding, std::string const& id) = 0;
+
     virtual void read(std::string const& creator,
                       std::string const& label,
                       std::string const& id,
                       void const** data,
                       std::type_info const& type) = 0;
+
+    /// Segment IDs written by the creator, in the order in which they were written
+    virtual std::vector<std::string> readSegmentIds(std::string const& creator) = 0;
+
+    /// Rebuild the segment index of the creator's output from the index container
+    virtual void rebuildIndex(std::string const& creator) = 0;
+
+    /// Finish writing the output files; throws if they cannot be completed
+    virtual void close() = 0;
   };
 
-  std::unique_ptr<IPersistence> createPersistence();
+  /// outputMode 'm' creates output files that are merged with those of other persistences
+  std::unique_ptr<IPersistence> createPersistence(char outputMode = 'o');
 
 } // namespace form::detail::experimental
 
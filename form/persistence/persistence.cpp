@@ -13,11 +13,14 @@ using namespace form::detail::experimental;
 
 // Factory function implementation
 namespace form::detail::experimental {
-  std::unique_ptr<IPersistence> createPersistence() { return std::make_unique<Persistence>(); }
+  std::unique_ptr<IPersistence> createPersistence(char outputMode)
+  {
+    return std::make_unique<Persistence>(outputMode);
+  }
 } // namespace form::detail::experimental
 
-Persistence::Persistence() :
-  m_store(createStorage()), m_output_items(), m_tech_settings() // constructor takes form config
+Persistence::Persistence(char outputMode) :
+  m_store(createStorage(outputMode)), m_output_items(), m_tech_settings() // constructor takes form config
 {
 }
 
@@ -33,36 +36,137 @@ void Persistence::configureOutputItems(
   m_output_items = output_items;
 }
 
+bool Persistence::hasContainer(std::string const& creator, std::string const& label) const
+{
+  auto binding = m_bindings.find(creator);
+  if (binding == m_bindings.end()) {
+    return false;
+  }
+  return binding->second.slots.contains(label);
+}
+
 void Persistence::createContainers(std::string const& creator,
                                    std::map<std::string, std::type_info const*> const& products)
 {
+  auto& binding = m_bindings[creator];
   std::map<std::unique_ptr<Placement>, std::type_info const*> containers;
   for (auto const& [label, type] : products) {
-    containers.insert(std::make_pair(getPlacement(creator, label), type));
+    if (!hasContainer(creator, label)) {
+      containers.insert(std::make_pair(getPlacement(creator, label), type));
+    }
+  }
+  if (containers.empty() && binding.index) {
+    return;
   }
-  containers.insert(std::make_pair(getPlacement(creator, "index"), &typeid(std::string)));
+  auto indexPlacement = getPlacement(creator, "index");
+  Placement const indexPlcmnt = *indexPlacement;
+  containers.insert(std::make_pair(std::move(indexPlacement), &typeid(std::string)));
   m_store->createContainers(containers, m_tech_settings);
+
+  // Resolve the containers once, so that writing does not need to look them up again
+  for (auto const& [plcmnt, type] : containers) {
+    if (plcmnt->containerName() != indexPlcmnt.containerName()) {
+      auto label = plcmnt->containerName().substr(creator.size() + 1);
+      binding.slots.emplace(label, binding.products.size());
+      binding.products.emplace_back(std::move(label), m_store->getContainer(*plcmnt));
+    }
+  }
+  if (!binding.index) {
+    binding.index = m_store->getIndexContainer(indexPlcmnt);
+  }
   return;
 }
 
+Persistence::WriteBinding& Persistence::getBinding(std::string const& creator)
+{
+  auto binding = m_bindings.find(creator);
+  if (binding == m_bindings.end() || !binding->second.index) {
+    throw std::runtime_error("No containers created for creator: " + creator);
+  }
+  return binding->second;
+}
+
+IStorage_Container& Persistence::getBoundContainer(WriteBinding& binding,
+                                                   std::string const& creator,
+                                                   std::string const& label)
+{
+  std::size_t slot = binding.next;
+  if (slot >= binding.products.size() || binding.products[slot].first != label) {
+    auto found = binding.slots.find(label);
+    if (found == binding.slots.end()) {
+      throw std::runtime_error("No container created for product: " + label +
+                               " from creator: " + creator);
+    }
+    slot = found->second;
+  }
+  binding.next = slot + 1;
+  return *binding.products[slot].second;
+}
+
 void Persistence::registerWrite(std::string const& creator,
                                 std::string const& label,
                                 void const* data,
-                                std::type_info const& type)
+                                std::type_info const& /* type*/)
 {
-  std::unique_ptr<Placement> plcmnt = getPlacement(creator, label);
-  m_store->fillContainer(*plcmnt, data, type);
+  auto& binding = getBinding(creator);
+  getBoundContainer(binding, creator, label).fill(data);
   return;
 }
 
 void Persistence::commitOutput(std::string const& creator, std::string const& id)
 {
-  std::unique_ptr<Placement> plcmnt = getPlacement(creator, "index");
-  m_store->fillContainer(*plcmnt, &id, typeid(std::string));
-  m_store->commitContainers(*plcmnt);
+  auto& binding = getBinding(creator);
+  binding.index->fill(&id);
+  binding.index->commit();
+  binding.next = 0;
   return;
 }
 
+std::size_t Persistence::bindProducts(
+  std::string const& creator,
+  std::vector<std::pair<std::string, std::type_info const*>> const& products)
+{
+  std::pair<std::string, std::vector<std::string>> key{creator, {}};
+  key.second.reserve(products.size());
+  for (auto const& product : products) {
+    key.second.push_back(product.first);
+  }
+  if (auto found = m_boundProductSets.find(key); found != m_boundProductSets.end()) {
+    return found->second;
+  }
+
+  std::map<std::string, std::type_info const*> missing;
+  for (auto const& [label, type] : products) {
+    if (!hasContainer(creator, label)) {
+      missing.emplace(label, type);
+    }
+  }
+  createContainers(creator, missing);
+
+  auto& binding = getBinding(creator);
+  BoundProducts bound{{}, binding.index.get()};
+  bound.containers.reserve(products.size());
+  for (auto const& product : products) {
+    bound.containers.push_back(&getBoundContainer(binding, creator, product.first));
+  }
+  binding.next = 0;
+  m_boundProducts.push_back(std::move(bound));
+  m_boundProductSets.emplace(std::move(key), m_boundProducts.size() - 1);
+  return m_boundProducts.size() - 1;
+}
+
+void Persistence::registerWrite(std::size_t binding, std::size_t product, void const* data)
+{
+  m_boundProducts[binding].containers[product]->fill(data);
+}
+
+void Persistence::commitOutput(std::size_t binding, std::string const& id)
+{
+  auto* index = m_boundProducts[binding].index;
+  index->fill(&id);
+  index->commit();
+}
+
 void Persistence::read(std::string const& creator,
                        std::string const& label,
                        std::string const& id,
@@ -74,6 +178,35 @@ void Persistence::read(std::string const& creator,
   return;
 }
 
+std::vector<std::string> Persistence::readSegmentIds(std::string const& creator)
+{
+  auto const* config_item = findConfigItem("index");
+  if (!config_item) {
+    throw std::runtime_error("No configuration found for index of creator: " + creator);
+  }
+  return m_store->readIndex(
+    Token{config_item->file_name, buildFullLabel(creator, "index"), config_item->technology},
+    m_tech_settings);
+}
+
+void Persistence::rebuildIndex(std::string const& creator)
+{
+  auto const* config_item = findConfigItem("index");
+  if (!config_item) {
+    throw std::runtime_error("No configuration found for index of creator: " + creator);
+  }
+  m_store->rebuildIndex(
+    Token{config_item->file_name, buildFullLabel(creator, "index"), config_item->technology},
+    m_tech_settings);
+  return;
+}
+
+void Persistence::close()
+{
+  m_store->close();
+  return;
+}
+
 form::experimental::config::PersistenceItem const* Persistence::findConfigItem(
   std::string const& label) const
 {
@@ -9,9 +9,13 @@
 #include "core/token.hpp"
 #include "storage/istorage.hpp"
 
+#include <cstddef>
 #include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 // forward declaration for form config
 namespace form::experimental::config {
@@ -23,7 +27,7 @@ namespace form::detail::experimental {
 
   class Persistence : public IPersistence {
   public:
-    Persistence();
+    explicit Persistence(char outputMode = 'o');
     ~Persistence() = default;
     void configureTechSettings(
       form::experimental::config::tech_setting_config const& tech_config_settings) override;
@@ -31,6 +35,7 @@ namespace form::detail::experimental {
     void configureOutputItems(
       form::experimental::config::output_item_config const& output_items) override;
 
+    bool hasContainer(std::string const& creator, std::string const& label) const override;
     void createContainers(std::string const& creator,
                           std::map<std::string, std::type_info const*> const& products) override;
     void registerWrite(std::string const& creator,
@@ -39,13 +44,45 @@ namespace form::detail::experimental {
                        std::type_info const& type) override;
     void commitOutput(std::string const& creator, std::string const& id) override;
 
+    std::size_t bindProducts(
+      std::string const& creator,
+      std::vector<std::pair<std::string, std::type_info const*>> const& products) override;
+    void registerWrite(std::size_t binding, std::size_t product, void const* data) override;
+    void commitOutput(std::size_t binding, std::string const& id) override;
+
     void read(std::string const& creator,
               std::string const& label,
               std::string const& id,
               void const** data,
               std::type_info const& type) override;
 
+    std::vector<std::string> readSegmentIds(std::string const& creator) override;
+
+    void rebuildIndex(std::string const& creator) override;
+
+    void close() override;
+
   private:
+    // Containers of one creator, resolved when they are created.  Products are usually
+    // written in the same order for every segment, so the next product is looked for first.
+    struct WriteBinding {
+      std::vector<std::pair<std::string, std::shared_ptr<IStorage_Container>>> products;
+      std::unordered_map<std::string, std::size_t> slots; // Product label -> index in products
+      std::shared_ptr<IStorage_Container> index;
+      std::size_t next = 0;
+    };
+
+    // Containers of one creator's products in the order given to bindProducts
+    struct BoundProducts {
+      std::vector<IStorage_Container*> containers;
+      IStorage_Container* index;
+    };
+
+    WriteBinding& getBinding(std::string const& creator);
+    IStorage_Container& getBoundContainer(WriteBinding& binding,
+                                          std::string const& creator,
+                                          std::string const& label);
+
     std::unique_ptr<Placement> getPlacement(std::string const& creator, std::string const& label);
     std::unique_ptr<Token> getToken(std::string const& creator,
                                     std::string const& label,
@@ -59,6 +96,10 @@ namespace form::detail::experimental {
     std::unique_ptr<IStorage> m_store;
     form::experimental::config::output_item_config m_output_items;
     form::experimental::config::tech_setting_config m_tech_settings;
+    std::unordered_map<std::string, WriteBinding> m_bindings;
+    std::vector<BoundProducts> m_boundProducts;
+    // (creator, product labels in order) -> index in m_boundProducts
+    std::map<std::pair<std::string, std::vector<std::string>>, std::size_t> m_boundProductSets;
   };
 
 } // namespace form::detail::experimental
@@ -0,0 +1,77 @@
+// Copyright (C) 2025 ...
+
+#include "root_compression.hpp"
+
+#include "Compression.h"
+#include "TROOT.h"
+
+#include <cctype>
+#include <mutex>
+#include <stdexcept>
+
+namespace form::detail::experimental {
+
+  int rootCompressionSettings(std::string const& value)
+  {
+    if (value == "none") {
+      return 0;
+    }
+    if (!value.empty() && std::isdigit(static_cast<unsigned char>(value.front()))) {
+      return std::stoi(value);
+    }
+
+    using RAlgorithm = ROOT::RCompressionSetting::EAlgorithm;
+    using RLevel = ROOT::RCompressionSetting::ELevel;
+    auto const colon = value.find(':');
+    std::string name = value.substr(0, colon);
+    if (name.starts_with('k')) {
+      name.erase(0, 1);
+    }
+
+    RAlgorithm::EValues algorithm;
+    int level;
+    if (name == "ZLIB") {
+      algorithm = RAlgorithm::kZLIB;
+      level = RLevel::kDefaultZLIB;
+    } else if (name == "LZMA") {
+      algorithm = RAlgorithm::kLZMA;
+      level = RLevel::kDefaultLZMA;
+    } else if (name == "OldCompressionAlgo") {
+      algorithm = RAlgorithm::kOldCompressionAlgo;
+      level = RLevel::kDefaultOld;
+    } else if (name == "LZ4") {
+      algorithm = RAlgorithm::kLZ4;
+      level = RLevel::kDefaultLZ4;
+    } else if (name == "ZSTD") {
+      algorithm = RAlgorithm::kZSTD;
+      level = RLevel::kDefaultZSTD;
+    } else {
+      throw std::runtime_error("Unknown ROOT compression algorithm: " + value);
+    }
+
+    if (colon != std::string::npos) {
+      level = std::stoi(value.substr(colon + 1));
+      if (level < 1 || level > 9) {
+        throw std::runtime_error("ROOT compression level must be between 1 and 9: " + value);
+      }
+    }
+    return ROOT::CompressionSettings(algorithm, level);
+  }
+
+  void enableRootImplicitMT(unsigned int threads)
+  {
+    // ROOT runs its tasks in a TBB task arena of its own, whose worker threads come from the
+    // same TBB thread pool as those of the framework.
+    static std::mutex mutex;
+    std::lock_guard lock{mutex};
+    if (threads == 0) {
+      if (ROOT::IsImplicitMTEnabled()) {
+        ROOT::DisableImplicitMT();
+      }
+    } else if (!ROOT::IsImplicitMTEnabled()) {
+      // The size of ROOT's pool is fixed once it has been created
+      ROOT::EnableImplicitMT(threads);
+    }
+  }
+
+} // namespace form::detail::experimental
@@ -0,0 +1,21 @@
+// Copyright (C) 2025 ...
+
+#ifndef __ROOT_COMPRESSION_HPP__
+#define __ROOT_COMPRESSION_HPP__
+
+#include <string>
+
+namespace form::detail::experimental {
+
+  /// ROOT compression settings (100 * algorithm + level) of a "compression" attribute: the name
+  /// of the algorithm (e.g. "kZSTD" or "ZSTD"), optionally followed by ":level" (e.g. "kLZ4:1"),
+  /// "none" for uncompressed output, or the settings number itself (e.g. "505").  Without a
+  /// level, ROOT's default level for the algorithm is used.
+  int rootCompressionSettings(std::string const& value);
+
+  /// Enable ROOT's implicit multithreading with the given number of threads (0 disables it)
+  void enableRootImplicitMT(unsigned int threads);
+
+} // namespace form::detail::experimental
+
+#endif
@@ -0,0 +1,43 @@
+// Copyright (C) 2025 ...
+
+#include "root_fundamental.hpp"
+
+#include <stdexcept>
+#include <string>
+
+namespace {
+  template <typename... Ts>
+  void* newAnyOf(std::type_info const& type)
+  {
+    void* object = nullptr;
+    ((type == typeid(Ts) ? (object = new Ts{}, true) : false) || ...);
+    return object;
+  }
+}
+
+namespace form::detail::experimental {
+
+  void* newFundamental(std::type_info const& type)
+  {
+    void* object = newAnyOf<bool,
+                            char,
+                            signed char,
+                            unsigned char,
+                            short,
+                            unsigned short,
+                            int,
+                            unsigned int,
+                            long,
+                            unsigned long,
+                            long long,
+                            unsigned long long,
+                            float,
+                            double,
+                            long double>(type);
+    if (object == nullptr) {
+      throw std::runtime_error(std::string{"newFundamental unsupported type: "} + type.name());
+    }
+    return object;
+  }
+
+} // namespace form::detail::experimental
@@ -0,0 +1,17 @@
+// Copyright (C) 2025 ...
+
+#ifndef __ROOT_FUNDAMENTAL_HPP__
+#define __ROOT_FUNDAMENTAL_HPP__
+
+#include <typeinfo>
+
+namespace form::detail::experimental {
+
+  /// Value-initialized object of a fundamental type, allocated with `new T` so that a reader
+  /// releases it with `delete static_cast<T const*>(p)`, as it does for the objects of the
+  /// other backends.  Throws for types that are not fundamental.
+  void* newFundamental(std::type_info const& type);
+
+} // namespace form::detail::experimental
+
+#endif
@@ -0,0 +1,149 @@
+// Copyright (C) 2025 ...
+
+#include "root_rfield_container.hpp"
+#include "root_compression.hpp"
+#include "root_rntuple_container.hpp"
+#include "root_tfile.hpp"
+
+#include "ROOT/RField.hxx"
+#include "ROOT/RNTupleReader.hxx"
+#include "ROOT/RNTupleView.hxx"
+#include "TClass.h"
+#include "TDictionary.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+
+namespace {
+  // RNTuple field names may not contain dots
+  std::string FieldName(std::string name)
+  {
+    std::ranges::replace(name, '.', '_');
+    return name;
+  }
+}
+
+using namespace form::detail::experimental;
+
+ROOT_RField_ContainerImp::ROOT_RField_ContainerImp(std::string const& name) :
+  Storage_Associative_Container(name),
+  m_rootFile(nullptr),
+  m_ntuple(nullptr),
+  m_fieldName(FieldName(col_name())),
+  m_forceStreamer(false),
+  m_compression(-1)
+{
+}
+
+ROOT_RField_ContainerImp::~ROOT_RField_ContainerImp() = default;
+
+void ROOT_RField_ContainerImp::setAttribute(std::string const& key, std::string const& value)
+{
+  if (key == "force_streamer_field") {
+    m_forceStreamer = (value == "true");
+  } else if (key == "compression") {
+    m_compression = rootCompressionSettings(value);
+  } else {
+    throw std::runtime_error("ROOT_RField_ContainerImp accepts some attributes, but not " + key);
+  }
+}
+
+void ROOT_RField_ContainerImp::setFile(std::shared_ptr<IStorage_File> file)
+{
+  this->Storage_Associative_Container::setFile(file);
+  m_rootFile = dynamic_cast<ROOT_TFileImp*>(file.get());
+  if (m_rootFile == nullptr) {
+    throw std::runtime_error("ROOT_RField_ContainerImp::setFile can't attach to non-ROOT file");
+  }
+  return;
+}
+
+void ROOT_RField_ContainerImp::setParent(std::shared_ptr<IStorage_Container> parent)
+{
+  this->Storage_Associative_Container::setParent(parent);
+  m_ntuple = dynamic_cast<ROOT_RNTuple_ContainerImp*>(parent.get());
+  if (m_ntuple == nullptr) {
+    throw std::runtime_error("ROOT_RField_ContainerImp::setParent");
+  }
+  return;
+}
+
+void ROOT_RField_ContainerImp::setupWrite(std::type_info const& type)
+{
+  if (m_ntuple == nullptr) {
+    throw std::runtime_error("ROOT_RField_ContainerImp::setupWrite no RNTuple found");
+  }
+  auto dictInfo = TDictionary::GetDictionary(type);
+  if (!dictInfo) {
+    throw std::runtime_error(std::string{"ROOT_RField_ContainerImp::setupWrite unsupported type: "} +
+                             type.name());
+  }
+  std::unique_ptr<ROOT::RFieldBase> field;
+  if (m_forceStreamer) {
+    field = std::make_unique<ROOT::RStreamerField>(m_fieldName, dictInfo->GetName());
+  } else {
+    field = ROOT::RFieldBase::Create(m_fieldName, dictInfo->GetName()).Unwrap();
+  }
+  if (m_compression >= 0) {
+    m_ntuple->setCompression(m_compression);
+  }
+  m_ntuple->addField(std::move(field));
+  return;
+}
+
+void ROOT_RField_ContainerImp::fill(void const* data)
+{
+  if (m_ntuple == nullptr) {
+    throw std::runtime_error("ROOT_RField_ContainerImp::fill no RNTuple found");
+  }
+  m_ntuple->bindField(m_fieldName, data);
+  return;
+}
+
+void ROOT_RField_ContainerImp::commit()
+{
+  if (m_ntuple == nullptr) {
+    throw std::runtime_error("ROOT_RField_ContainerImp::commit no RNTuple attached");
+  }
+  m_ntuple->fillEntry();
+  return;
+}
+
+bool ROOT_RField_ContainerImp::read(int id, void const** data, std::type_info const& type)
+{
+  if (m_rootFile == nullptr) {
+    throw std::runtime_error("ROOT_RField_ContainerImp::read no file attached");
+  }
+  auto& reader = m_rootFile->getRNTupleReader(top_name());
+  if (id < 0 || static_cast<std::uint64_t>(id) >= reader.GetNEntries()) {
+    return false;
+  }
+
+  void* buffer = nullptr;
+  auto dictInfo = TDictionary::GetDictionary(type);
+  if (!dictInfo) {
+    throw std::runtime_error(std::string{"ROOT_RField_ContainerImp::read unsupported type: "} +
+                             type.name());
+  }
+  if (dictInfo->Property() & EProperty::kIsFundamental) {
+    buffer = newFundamental(type);
+  } else {
+    auto klass = TClass::GetClass(type);
+    if (!klass) {
+      throw std::runtime_error(std::string{"ROOT_RField_ContainerImp::read missing TClass"} +
+                               " (field='" + m_fieldName + "', type='" + type.name() + "')");
+    }
+    buffer = klass->New();
+  }
+
+  // The view is created once and reads into a new object for every entry
+  if (!m_view) {
+    m_view = std::make_unique<ROOT::RNTupleView<void>>(reader.GetView<void>(m_fieldName, buffer));
+  } else {
+    m_view->BindRawPtr(buffer);
+  }
+  (*m_view)(id);
+  *data = buffer;
+  return true;
+}
@@ -0,0 +1,48 @@
+// Copyright (C) 2025 ...
+
+#ifndef __ROOT_RFIELD_CONTAINER_HPP__
+#define __ROOT_RFIELD_CONTAINER_HPP__
+
+#include "storage/storage_associative_container.hpp"
+
+#include <memory>
+#include <string>
+#include <typeinfo>
+
+namespace ROOT {
+  template <typename T>
+  class RNTupleView;
+}
+
+namespace form::detail::experimental {
+
+  class ROOT_RNTuple_ContainerImp;
+  class ROOT_TFileImp;
+
+  class ROOT_RField_ContainerImp : public Storage_Associative_Container {
+  public:
+    ROOT_RField_ContainerImp(std::string const& name);
+    ~ROOT_RField_ContainerImp();
+
+    void setAttribute(std::string const& key, std::string const& value) override;
+
+    void setFile(std::shared_ptr<IStorage_File> file) override;
+    void setParent(std::shared_ptr<IStorage_Container> parent) override;
+
+    void setupWrite(std::type_info const& type = typeid(void)) override;
+    void fill(void const* data) override;
+    void commit() override;
+    bool read(int id, void const** data, std::type_info const& type) override;
+
+  private:
+    ROOT_TFileImp* m_rootFile;
+    ROOT_RNTuple_ContainerImp* m_ntuple;
+    std::string m_fieldName;
+    bool m_forceStreamer;
+    int m_compression; // ROOT compression settings; -1 for those of the RNTuple
+    std::unique_ptr<ROOT::RNTupleView<void>> m_view;
+  };
+
+} // namespace form::detail::experimental
+
+#endif
@@ -0,0 +1,227 @@
+// Copyright (C) 2025 ...
+
+#include "root_rntuple_container.hpp"
+#include "root_tfile.hpp"
+
+#include "ROOT/REntry.hxx"
+#include "ROOT/RField.hxx"
+#include "ROOT/RNTupleFillContext.hxx"
+#include "ROOT/RNTupleModel.hxx"
+#include "ROOT/RNTupleParallelWriter.hxx"
+#include "ROOT/RNTupleWriteOptions.hxx"
+#include "ROOT/RNTupleWriter.hxx"
+#include "TFile.h"
+
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+  // RNTuples that are written in parallel, by file name.  Only one RNTuple per file can be
+  // written in parallel, because the parallel writers of a file would not synchronize their
+  // writes with each other.
+  struct ParallelWriterEntry {
+    std::string ntupleName;
+    std::weak_ptr<ROOT::RNTupleParallelWriter> writer;
+  };
+  std::mutex parallelWritersMutex;
+  std::map<std::string, ParallelWriterEntry> parallelWriters;
+}
+
+using namespace form::detail::experimental;
+
+ROOT_RNTuple_ContainerImp::ROOT_RNTuple_ContainerImp(std::string const& name) :
+  Storage_Association(name),
+  m_tfile(nullptr),
+  m_parallel(false),
+  m_closed(false),
+  m_model(ROOT::RNTupleModel::CreateBare()),
+  m_fieldCount(0),
+  m_boundCount(0),
+  m_compression(-1)
+{
+}
+
+ROOT_RNTuple_ContainerImp::~ROOT_RNTuple_ContainerImp()
+{
+  // RNTuples that are not closed explicitly are still committed, but errors can then only be
+  // reported here.
+  try {
+    close();
+  } catch (std::exception const& e) {
+    std::cerr << e.what() << '\n';
+  }
+}
+
+void ROOT_RNTuple_ContainerImp::close()
+{
+  if (m_closed) {
+    return;
+  }
+  m_closed = true;
+  m_entry.reset();
+  if (m_writer) {
+    m_writer->CommitDataset();
+    m_writer.reset();
+  } else if (m_parallelWriter) {
+    // Releasing the fill context flushes this writer's entries.  The last writer commits the
+    // RNTuple; keep the registry locked until it is done, so that no other writer starts
+    // writing to the file meanwhile.
+    m_fillContext.reset();
+    std::lock_guard lock{parallelWritersMutex};
+    if (m_parallelWriter.use_count() == 1) {
+      m_parallelWriter->CommitDataset();
+    }
+    m_parallelWriter.reset();
+  } else {
+    return;
+  }
+  if (m_tfile->TestBit(TFile::kWriteError)) {
+    throw std::runtime_error("ROOT_RNTuple_ContainerImp::close failed to write " + name());
+  }
+}
+
+void ROOT_RNTuple_ContainerImp::setFile(std::shared_ptr<IStorage_File> file)
+{
+  this->Storage_Association::setFile(file);
+  ROOT_TFileImp* root_tfile_imp = dynamic_cast<ROOT_TFileImp*>(file.get());
+  if (root_tfile_imp == nullptr) {
+    throw std::runtime_error("ROOT_RNTuple_ContainerImp::setFile can't attach to non-ROOT file");
+  }
+  m_tfile = root_tfile_imp->getTFile();
+  m_parallel = (file->mode() == 'm');
+  return;
+}
+
+void ROOT_RNTuple_ContainerImp::setupWrite(std::type_info const& /*type*/)
+{
+  if (m_tfile == nullptr) {
+    throw std::runtime_error("ROOT_RNTuple_ContainerImp::setupWrite no file attached");
+  }
+  return;
+}
+
+void ROOT_RNTuple_ContainerImp::fill(void const* /* data*/)
+{
+  throw std::runtime_error("ROOT_RNTuple_ContainerImp::fill not implemented");
+}
+
+void ROOT_RNTuple_ContainerImp::commit()
+{
+  throw std::runtime_error("ROOT_RNTuple_ContainerImp::commit not implemented");
+}
+
+bool ROOT_RNTuple_ContainerImp::read(int /* id*/,
+                                     void const** /* data*/,
+                                     std::type_info const& /* type*/)
+{
+  throw std::runtime_error("ROOT_RNTuple_ContainerImp::read not implemented");
+}
+
+void ROOT_RNTuple_ContainerImp::setCompression(int settings)
+{
+  if (m_compression >= 0 && m_compression != settings) {
+    throw std::runtime_error("ROOT_RNTuple_ContainerImp::setCompression fields of " + name() +
+                             " ask for different compression settings");
+  }
+  if (m_compression < 0 && (m_writer || m_parallelWriter)) {
+    throw std::runtime_error("ROOT_RNTuple_ContainerImp::setCompression " + name() +
+                             " is already being written");
+  }
+  m_compression = settings;
+  return;
+}
+
+void ROOT_RNTuple_ContainerImp::addField(std::unique_ptr<ROOT::RFieldBase> field)
+{
+  if (m_closed) {
+    throw std::runtime_error("ROOT_RNTuple_ContainerImp::addField " + name() + " is closed");
+  }
+  if (m_writer) {
+    // Late model extension: the field holds default values for the entries written so far.
+    // The entry is recreated, which drops the products bound to the old one.
+    if (m_boundCount != 0) {
+      throw std::runtime_error("ROOT_RNTuple_ContainerImp::addField can't add field " +
+                               field->GetFieldName() + " to " + name() +
+                               " while an entry is partially filled");
+    }
+    auto updater = m_writer->CreateModelUpdater();
+    updater->BeginUpdate();
+    updater->AddField(std::move(field));
+    updater->CommitUpdate();
+    m_entry = m_writer->CreateEntry();
+  } else if (m_parallelWriter) {
+    throw std::runtime_error("ROOT_RNTuple_ContainerImp::addField can't add field " +
+                             field->GetFieldName() + " to " + name() +
+                             " after parallel writing has started");
+  } else {
+    m_model->AddField(std::move(field));
+  }
+  ++m_fieldCount;
+  return;
+}
+
+void ROOT_RNTuple_ContainerImp::bindField(std::string const& fieldName, void const* data)
+{
+  if (!m_entry) {
+    createWriter();
+  }
+  m_entry->BindRawPtr(fieldName, const_cast<void*>(data)); //FIXME: const_cast?
+  ++m_boundCount;
+  return;
+}
+
+void ROOT_RNTuple_ContainerImp::fillEntry()
+{
+  if (!m_entry) {
+    createWriter();
+  }
+  if (m_boundCount != m_fieldCount) {
+    throw std::runtime_error("ROOT_RNTuple_ContainerImp::fillEntry not all fields of " + name() +
+                             " were filled");
+  }
+  if (m_fillContext) {
+    m_fillContext->Fill(*m_entry);
+  } else {
+    m_writer->Fill(*m_entry);
+  }
+  m_boundCount = 0;
+  return;
+}
+
+void ROOT_RNTuple_ContainerImp::createWriter()
+{
+  if (m_tfile == nullptr) {
+    throw std::runtime_error("ROOT_RNTuple_ContainerImp::createWriter no file attached");
+  }
+  if (m_closed) {
+    throw std::runtime_error("ROOT_RNTuple_ContainerImp::createWriter " + name() + " is closed");
+  }
+  ROOT::RNTupleWriteOptions options;
+  options.SetCompression(m_compression >= 0 ? m_compression : m_tfile->GetCompressionSettings());
+
+  if (m_parallel) {
+    std::lock_guard lock{parallelWritersMutex};
+    auto& entry = parallelWriters[m_tfile->GetName()];
+    m_parallelWriter = entry.writer.lock();
+    if (!m_parallelWriter) {
+      m_parallelWriter =
+        ROOT::RNTupleParallelWriter::Append(std::move(m_model), name(), *m_tfile, options);
+      entry.ntupleName = name();
+      entry.writer = m_parallelWriter;
+    } else if (entry.ntupleName != name()) {
+      throw std::runtime_error("ROOT_RNTuple_ContainerImp::createWriter can't write " + name() +
+                               " in parallel to " + m_tfile->GetName() + ", which already has " +
+                               entry.ntupleName);
+    }
+    m_fillContext = m_parallelWriter->CreateFillContext();
+    m_entry = m_fillContext->CreateEntry();
+  } else {
+    m_writer = ROOT::RNTupleWriter::Append(std::move(m_model), name(), *m_tfile, options);
+    m_entry = m_writer->CreateEntry();
+  }
+  m_model.reset();
+  return;
+}
@@ -0,0 +1,76 @@
+// Copyright (C) 2025 ...
+
+#ifndef __ROOT_RNTUPLE_CONTAINER_HPP__
+#define __ROOT_RNTUPLE_CONTAINER_HPP__
+
+#include "storage/storage_association.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <typeinfo>
+
+class TFile;
+
+namespace ROOT {
+  class REntry;
+  class RFieldBase;
+  class RNTupleFillContext;
+  class RNTupleModel;
+  class RNTupleParallelWriter;
+  class RNTupleWriter;
+}
+
+/* @class ROOT_RNTuple_ContainerImp
+ * @brief The RNTuple that holds the fields (see ROOT_RField_ContainerImp) of one creator.
+ *
+ * The fields bind the products of a segment to the entry of the RNTuple, which is filled when
+ * the segment is committed.  The writer is created on the first fill; fields that are added
+ * later extend the model of the writer.  If the file is written by several writers in
+ * parallel (mode 'm'), the RNTuples of the same name share a ROOT::RNTupleParallelWriter, and
+ * each of them fills through its own fill context.  The RNTuple is committed by close(); in
+ * parallel, each writer releases its fill context, and the last one commits the RNTuple.
+ */
+namespace form::detail::experimental {
+
+  class ROOT_RNTuple_ContainerImp : public Storage_Association {
+  public:
+    ROOT_RNTuple_ContainerImp(std::string const& name);
+    ~ROOT_RNTuple_ContainerImp();
+
+    ROOT_RNTuple_ContainerImp(ROOT_RNTuple_ContainerImp const& other) = delete;
+    ROOT_RNTuple_ContainerImp& operator=(ROOT_RNTuple_ContainerImp& other) = delete;
+
+    void setFile(std::shared_ptr<IStorage_File> file) override;
+    void setupWrite(std::type_info const& type = typeid(void)) override;
+    void fill(void const* data) override;
+    void commit() override;
+    bool read(int id, void const** data, std::type_info const& type) override;
+    /// Commit the RNTuple (or this writer's share of it); throws if it cannot be written
+    void close() override;
+
+    /// RNTuple compresses all of its fields alike, so fields may not ask for different settings
+    void setCompression(int settings);
+    void addField(std::unique_ptr<ROOT::RFieldBase> field);
+    void bindField(std::string const& fieldName, void const* data);
+    void fillEntry();
+
+  private:
+    void createWriter();
+
+    std::shared_ptr<TFile> m_tfile;
+    bool m_parallel;
+    bool m_closed;
+    std::unique_ptr<ROOT::RNTupleModel> m_model; // Until the writer is created
+    std::unique_ptr<ROOT::RNTupleWriter> m_writer;
+    std::shared_ptr<ROOT::RNTupleParallelWriter> m_parallelWriter;
+    std::shared_ptr<ROOT::RNTupleFillContext> m_fillContext;
+    std::unique_ptr<ROOT::REntry> m_entry;
+    std::size_t m_fieldCount;
+    std::size_t m_boundCount;
+    int m_compression; // -1 for the compression settings of the file
+  };
+
+} //namespace form::detail::experimental
+
+#endif
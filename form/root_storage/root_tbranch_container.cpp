@@ -1,6 +1,9 @@
 // Copyright (C) 2025 ...
 
 #include "root_tbranch_container.hpp"
+#include "root_compression.hpp"
+#include "root_fundamental.hpp"
+#include "root_tbuffermerger_file.hpp"
 #include "root_tfile.hpp"
 #include "root_ttree_container.hpp"
 
@@ -10,6 +13,7 @@
 #include "TLeaf.h"
 #include "TTree.h"
 
+#include <cstring>
 #include <unordered_map>
 
 namespace {
@@ -43,14 +47,43 @@ namespace {
 using namespace form::detail::experimental;
 
 ROOT_TBranch_ContainerImp::ROOT_TBranch_ContainerImp(std::string const& name) :
-  Storage_Associative_Container(name), m_tfile(nullptr), m_tree(nullptr), m_branch(nullptr)
+  Storage_Associative_Container(name),
+  m_tfile(nullptr),
+  m_mergerFile(nullptr),
+  m_treeContainer(nullptr),
+  m_tree(nullptr),
+  m_branch(nullptr),
+  m_basketSize(0),
+  m_compression(-1),
+  m_readType(nullptr),
+  m_readClass(nullptr),
+  m_readObject(nullptr),
+  m_cacheSize(0),
+  m_clusterPrefetch(false)
 {
 }
 
+ROOT_TBranch_ContainerImp::~ROOT_TBranch_ContainerImp()
+{
+  if (m_readClass != nullptr && m_readObject != nullptr) {
+    m_readClass->Destructor(m_readObject);
+  }
+}
+
 void ROOT_TBranch_ContainerImp::setAttribute(std::string const& key, std::string const& value)
 {
-  if (key == "auto_flush") {
-    m_tree->SetAutoFlush(std::stol(value));
+  if (key == "auto_flush" || key == "basket_sample" || key == "optimize_baskets" ||
+      key == "report") {
+    // Attributes of the tree, which are passed on when the branch is set up for writing
+    m_treeAttributes.emplace_back(key, value);
+  } else if (key == "basket_size") {
+    m_basketSize = std::stoi(value);
+  } else if (key == "compression") {
+    m_compression = rootCompressionSettings(value);
+  } else if (key == "cache_size") {
+    m_cacheSize = std::stol(value);
+  } else if (key == "cluster_prefetch") {
+    m_clusterPrefetch = (value == "true");
   } else {
     throw std::runtime_error("ROOT_TTree_ContainerImp accepts some attributes, but not " + key);
   }
@@ -64,6 +97,7 @@ void ROOT_TBranch_ContainerImp::setFile(std::shared_ptr<IStorage_File> file)
     throw std::runtime_error("ROOT_TBranch_ContainerImp::setFile can't attach to non-ROOT file");
   }
   m_tfile = root_tfile_imp->getTFile();
+  m_mergerFile = dynamic_cast<ROOT_TBufferMerger_FileImp*>(root_tfile_imp);
   return;
 }
 
@@ -74,6 +108,7 @@ void ROOT_TBranch_ContainerImp::setParent(std::shared_ptr<IStorage_Container> pa
   if (root_ttree_imp == nullptr) {
     throw std::runtime_error("ROOT_TBranch_ContainerImp::setParent");
   }
+  m_treeContainer = root_ttree_imp;
   m_tree = root_ttree_imp->getTTree();
   return;
 }
@@ -91,19 +126,33 @@ void ROOT_TBranch_ContainerImp::setupWrite(std::type_info const& type)
         std::string{"ROOT_TBranch_ContainerImp::setupWrite unsupported type: "} +
         DemangleName(type));
     }
+    // Initial basket sizes; unless fixed, they are resized once the first entries are measured
     if (dictInfo->Property() & EProperty::kIsFundamental) {
       m_branch = m_tree->Branch(col_name().c_str(),
                                 static_cast<void**>(nullptr),
                                 (col_name() + typeNameToLeafList[dictInfo->GetName()]).c_str(),
-                                4096);
+                                m_basketSize > 0 ? m_basketSize : 4096);
     } else {
-      m_branch =
-        m_tree->Branch(col_name().c_str(), dictInfo->GetName(), static_cast<void**>(nullptr));
+      m_branch = m_tree->Branch(col_name().c_str(),
+                                dictInfo->GetName(),
+                                static_cast<void**>(nullptr),
+                                m_basketSize > 0 ? m_basketSize : 32000);
+    }
+    if (m_branch != nullptr && m_basketSize > 0 && m_treeContainer != nullptr) {
+      m_treeContainer->setFixedBasketSize(m_branch, m_basketSize);
+    }
+    if (m_branch != nullptr && m_compression >= 0) {
+      m_branch->SetCompressionSettings(m_compression);
     }
   }
   if (m_branch == nullptr) {
     throw std::runtime_error("ROOT_TBranch_ContainerImp::setupWrite no branch created");
   }
+  if (m_treeContainer != nullptr) {
+    for (auto const& [key, value] : m_treeAttributes) {
+      m_treeContainer->setAttribute(key, value);
+    }
+  }
   return;
 }
 
@@ -131,6 +180,12 @@ void ROOT_TBranch_ContainerImp::commit()
     throw std::runtime_error("ROOT_TBranch_ContainerImp::commit no tree attached");
   }
   m_tree->SetEntries(m_branch->GetEntries());
+  if (m_treeContainer != nullptr) {
+    m_treeContainer->entryCommitted();
+  }
+  if (m_mergerFile != nullptr) {
+    m_mergerFile->segmentCommitted();
+  }
   return;
 }
 
@@ -151,10 +206,36 @@ bool ROOT_TBranch_ContainerImp::read(int id, void const** data, std::type_info c
   if (m_branch == nullptr) {
     throw std::runtime_error("ROOT_TBranch_ContainerImp::read no branch found");
   }
-  if (id > m_tree->GetEntries())
+  if (id < 0 || id >= m_tree->GetEntries())
     return false;
 
-  void* branchBuffer = nullptr;
+  if (m_readType != &type) {
+    setupRead(type);
+  }
+
+  Long64_t tentry = m_tree->LoadTree(id);
+  if (m_readClass == nullptr) {
+    m_branch->GetEntry(tentry);
+    void* value = newFundamental(type);
+    std::memcpy(value, m_readValue.data(), m_readValue.size());
+    *data = value;
+  } else {
+    // The caller owns the object that is read, so the branch is pointed at the next object;
+    // unlike SetBranchAddress, this needs neither a branch lookup nor a type check.
+    m_branch->GetEntry(tentry);
+    *data = m_readObject;
+    m_readObject = m_readClass->New();
+    m_branch->SetAddress(&m_readObject);
+  }
+  return true;
+}
+
+void ROOT_TBranch_ContainerImp::setupRead(std::type_info const& type)
+{
+  if (m_readClass != nullptr && m_readObject != nullptr) {
+    m_readClass->Destructor(m_readObject);
+    m_readObject = nullptr;
+  }
   auto dictInfo = TDictionary::GetDictionary(type);
   int branchStatus = 0;
   if (!dictInfo) {
@@ -164,19 +245,20 @@ bool ROOT_TBranch_ContainerImp::read(int id, void const** data, std::type_info c
 
   if (dictInfo->Property() & EProperty::kIsFundamental) {
     auto fundInfo = static_cast<TDataType*>(dictInfo);
-    branchBuffer = new char[fundInfo->Size()];
+    m_readClass = nullptr;
+    m_readValue.resize(fundInfo->Size());
     branchStatus = m_tree->SetBranchAddress(
-      col_name().c_str(), &branchBuffer, nullptr, EDataType(fundInfo->GetType()), true);
+      col_name().c_str(), m_readValue.data(), nullptr, EDataType(fundInfo->GetType()), false);
   } else {
-    auto klass = TClass::GetClass(type);
-    if (!klass) {
+    m_readClass = TClass::GetClass(type);
+    if (!m_readClass) {
       throw std::runtime_error(std::string{"ROOT_TBranch_ContainerImp::read missing TClass"} +
                                " (col_name='" + col_name() + "', type='" + DemangleName(type) +
                                "')");
     }
-    branchBuffer = klass->New();
-    branchStatus =
-      m_tree->SetBranchAddress(col_name().c_str(), &branchBuffer, klass, EDataType::kOther_t, true);
+    m_readObject = m_readClass->New();
+    branchStatus = m_tree->SetBranchAddress(
+      col_name().c_str(), &m_readObject, m_readClass, EDataType::kOther_t, true);
   }
 
   if (branchStatus < 0) {
@@ -185,9 +267,15 @@ bool ROOT_TBranch_ContainerImp::read(int id, void const** data, std::type_info c
       col_name() + "', type='" + DemangleName(type) + "')" + " with error code " +
       std::to_string(branchStatus));
   }
+  m_readType = &type;
 
-  Long64_t tentry = m_tree->LoadTree(id);
-  m_branch->GetEntry(tentry);
-  *data = branchBuffer;
-  return true;
+  // Read the baskets of the branch cluster by cluster through the TTree cache
+  if (m_cacheSize > 0) {
+    m_tree->SetCacheSize(m_cacheSize);
+  }
+  m_tree->AddBranchToCache(m_branch, true);
+  if (m_clusterPrefetch) {
+    m_tree->SetClusterPrefetch(true);
+  }
+  return;
 }
@@ -8,17 +8,23 @@
 #include <memory>
 #include <string>
 #include <typeinfo>
+#include <utility>
+#include <vector>
 
+class TClass;
 class TFile;
 class TTree;
 class TBranch;
 
 namespace form::detail::experimental {
 
+  class ROOT_TBufferMerger_FileImp;
+  class ROOT_TTree_ContainerImp;
+
   class ROOT_TBranch_ContainerImp : public Storage_Associative_Container {
   public:
     ROOT_TBranch_ContainerImp(std::string const& name);
-    ~ROOT_TBranch_ContainerImp() = default;
+    ~ROOT_TBranch_ContainerImp();
 
     void setAttribute(std::string const& key, std::string const& value) override;
 
@@ -31,9 +37,26 @@ namespace form::detail::experimental {
     bool read(int id, void const** data, std::type_info const& type) override;
 
   private:
+    void setupRead(std::type_info const& type);
+
     std::shared_ptr<TFile> m_tfile;
+    ROOT_TBufferMerger_FileImp* m_mergerFile; // Only set if the file is merged
+    ROOT_TTree_ContainerImp* m_treeContainer; // Only set for writing
     TTree* m_tree;
     TBranch* m_branch;
+
+    // Writing: a basket size of 0 is tuned by the tree container (see ROOT_TTree_ContainerImp)
+    int m_basketSize;
+    int m_compression; // ROOT compression settings; -1 for those of the file
+    std::vector<std::pair<std::string, std::string>> m_treeAttributes;
+
+    // Reading: the branch address is bound once per type
+    std::type_info const* m_readType;
+    TClass* m_readClass;           // Class objects are read into m_readObject
+    void* m_readObject;            //  which is handed to the caller after each read
+    std::vector<char> m_readValue; // Fundamental values are read here and copied out
+    long m_cacheSize;              // TTree cache size in bytes; 0 for ROOT's default
+    bool m_clusterPrefetch;
   };
 
 } // namespace form::detail::experimental
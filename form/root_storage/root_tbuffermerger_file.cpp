@@ -0,0 +1,95 @@
+// Copyright (C) 2025 ...
+
+#include "root_tbuffermerger_file.hpp"
+
+#include "ROOT/TBufferMerger.hxx"
+#include "TFile.h"
+#include "TROOT.h"
+
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+  // Mergers of the output files that are currently being written
+  std::mutex mergersMutex;
+  std::map<std::string, std::weak_ptr<ROOT::TBufferMerger>> mergers;
+
+  std::shared_ptr<ROOT::TBufferMerger> getMerger(std::string const& name)
+  {
+    std::lock_guard lock{mergersMutex};
+    auto& entry = mergers[name];
+    auto merger = entry.lock();
+    if (!merger) {
+      ROOT::EnableThreadSafety();
+      merger = std::make_shared<ROOT::TBufferMerger>(name.c_str(), "RECREATE");
+      entry = merger;
+    }
+    return merger;
+  }
+}
+
+using namespace form::detail::experimental;
+
+ROOT_TBufferMerger_FileImp::ROOT_TBufferMerger_FileImp(std::string const& name, char mode) :
+  ROOT_TBufferMerger_FileImp(name, mode, getMerger(name))
+{
+}
+
+ROOT_TBufferMerger_FileImp::ROOT_TBufferMerger_FileImp(
+  std::string const& name, char mode, std::shared_ptr<ROOT::TBufferMerger> merger) :
+  ROOT_TFileImp(name, mode, merger->GetFile()),
+  m_merger(std::move(merger)),
+  m_mergerFile(std::static_pointer_cast<ROOT::TBufferMergerFile>(getTFile())),
+  m_mergeEvery(1000),
+  m_uncommitted(0),
+  m_closed(false)
+{
+}
+
+ROOT_TBufferMerger_FileImp::~ROOT_TBufferMerger_FileImp()
+{
+  try {
+    close();
+  } catch (std::exception const& e) {
+    std::cerr << "ROOT_TBufferMerger_FileImp: " << e.what() << '\n';
+  }
+  // The in-memory file must be gone before the merger, which closes the output file once the
+  // last writer has released it.  The registry stays locked meanwhile, so that the file is not
+  // recreated by a new writer before it has been closed.
+  m_mergerFile.reset();
+  releaseTFile();
+  std::lock_guard lock{mergersMutex};
+  m_merger.reset();
+}
+
+void ROOT_TBufferMerger_FileImp::setAttribute(std::string const& key, std::string const& value)
+{
+  if (key == "merge_every") {
+    m_mergeEvery = std::stol(value);
+  } else {
+    ROOT_TFileImp::setAttribute(key, value);
+  }
+}
+
+void ROOT_TBufferMerger_FileImp::close()
+{
+  if (m_closed) {
+    return;
+  }
+  m_closed = true;
+  m_mergerFile->Write();
+  if (m_mergerFile->TestBit(TFile::kWriteError)) {
+    throw std::runtime_error("ROOT_TBufferMerger_FileImp::close failed to write " + name());
+  }
+}
+
+void ROOT_TBufferMerger_FileImp::segmentCommitted()
+{
+  if (m_mergeEvery > 0 && ++m_uncommitted >= m_mergeEvery) {
+    m_mergerFile->Write();
+    m_uncommitted = 0;
+  }
+}
@@ -0,0 +1,52 @@
+// Copyright (C) 2025 ...
+
+#ifndef __ROOT_TBUFFERMERGER_FILE_HPP__
+#define __ROOT_TBUFFERMERGER_FILE_HPP__
+
+#include "root_tfile.hpp"
+
+#include <memory>
+#include <string>
+
+namespace ROOT {
+  class TBufferMerger;
+  class TBufferMergerFile;
+}
+
+/* @class ROOT_TBufferMerger_FileImp
+ * @brief One writer's share of a ROOT file that is written by several writers concurrently.
+ *
+ * All ROOT_TBufferMerger_FileImp objects with the same name share a ROOT::TBufferMerger.  Each
+ * of them writes into its own in-memory file, which is handed to the merger (and appended to
+ * the output file by the merger's thread) every "merge_every" committed segments and when the
+ * object is destroyed.  The output file is closed when the last of them is destroyed.
+ */
+namespace form::detail::experimental {
+
+  class ROOT_TBufferMerger_FileImp : public ROOT_TFileImp {
+  public:
+    ROOT_TBufferMerger_FileImp(std::string const& name, char mode);
+    ~ROOT_TBufferMerger_FileImp();
+
+    void setAttribute(std::string const& key, std::string const& value) override;
+    /// Hand the remaining buffers to the merger; throws if they cannot be written
+    void close() override;
+
+    /// Called by the containers of this file whenever a segment has been committed
+    void segmentCommitted();
+
+  private:
+    ROOT_TBufferMerger_FileImp(std::string const& name,
+                               char mode,
+                               std::shared_ptr<ROOT::TBufferMerger> merger);
+
+    std::shared_ptr<ROOT::TBufferMerger> m_merger;
+    std::shared_ptr<ROOT::TBufferMergerFile> m_mergerFile;
+    long m_mergeEvery;
+    long m_uncommitted;
+    bool m_closed;
+  };
+
+} // namespace form::detail::experimental
+
+#endif
@@ -1,44 +1,82 @@
 // Copyright (C) 2025 ...
 
 #include "root_tfile.hpp"
+#include "root_compression.hpp"
 
+#include "ROOT/RNTuple.hxx"
+#include "ROOT/RNTupleReader.hxx"
 #include "TFile.h"
+#include "TROOT.h"
+
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+  // Files that are written by several RNTuple parallel writers at once
+  std::mutex sharedFilesMutex;
+  std::map<std::string, std::weak_ptr<TFile>> sharedFiles;
+
+  std::shared_ptr<TFile> openSharedFile(std::string const& name)
+  {
+    std::lock_guard lock{sharedFilesMutex};
+    auto& entry = sharedFiles[name];
+    auto file = entry.lock();
+    if (!file) {
+      ROOT::EnableThreadSafety();
+      file.reset(TFile::Open(name.c_str(), "RECREATE"));
+      entry = file;
+    }
+    return file;
+  }
+}
 
 using namespace form::detail::experimental;
 ROOT_TFileImp::ROOT_TFileImp(std::string const& name, char mode) :
   Storage_File(name, mode), m_file(nullptr)
 {
-  if (mode == 'c' || mode == 'r' || mode == 'o') {
+  if (mode == 'm') {
+    m_file = openSharedFile(name);
+  } else if (mode == 'c' || mode == 'r' || mode == 'o') {
     m_file.reset(TFile::Open(name.c_str(), "RECREATE"));
   } else {
     m_file.reset(TFile::Open(name.c_str(), "READ"));
   }
 }
 
+ROOT_TFileImp::ROOT_TFileImp(std::string const& name, char mode, std::shared_ptr<TFile> file) :
+  Storage_File(name, mode), m_file(std::move(file))
+{
+}
+
 ROOT_TFileImp::~ROOT_TFileImp() = default;
 
 void ROOT_TFileImp::setAttribute(std::string const& key, std::string const& value)
 {
   if (key == "compression") {
-    using RComp = ROOT::RCompressionSetting::EAlgorithm;
-    RComp::EValues compression;
-    if (value == "kZLIB")
-      compression = RComp::kZLIB;
-    else if (value == "kLZMA")
-      compression = RComp::kLZMA;
-    else if (value == "kOldCompressionAlgo")
-      compression = RComp::kOldCompressionAlgo;
-    else if (value == "kLZ4")
-      compression = RComp::kLZ4;
-    else if (value == "kZSTD")
-      compression = RComp::kZSTD;
-    else
-      compression = RComp::kUndefined;
-
-    m_file->SetCompressionAlgorithm(compression);
+    m_file->SetCompressionSettings(rootCompressionSettings(value));
+  } else if (key == "implicit_mt") {
+    // Process-wide: baskets and pages are then compressed by ROOT's tasks in parallel
+    enableRootImplicitMT(static_cast<unsigned int>(std::stoul(value)));
   } else {
     throw std::runtime_error("ROOT_TFileImp does not recognize an attribute named " + key);
   }
 }
 
 std::shared_ptr<TFile> ROOT_TFileImp::getTFile() { return m_file; }
+
+ROOT::RNTupleReader& ROOT_TFileImp::getRNTupleReader(std::string const& name)
+{
+  auto reader = m_readers.find(name);
+  if (reader == m_readers.end()) {
+    std::unique_ptr<ROOT::RNTuple> anchor{m_file->Get<ROOT::RNTuple>(name.c_str())};
+    if (!anchor) {
+      throw std::runtime_error("ROOT_TFileImp::getRNTupleReader no RNTuple named " + name +
+                               " in " + m_file->GetName());
+    }
+    reader = m_readers.emplace(name, ROOT::RNTupleReader::Open(*anchor)).first;
+  }
+  return *reader->second;
+}
+
+void ROOT_TFileImp::releaseTFile() { m_file.reset(); }
@@ -5,11 +5,16 @@
 
 #include "storage/storage_file.hpp"
 
+#include <map>
 #include <memory>
 #include <string>
 
 class TFile;
 
+namespace ROOT {
+  class RNTupleReader;
+}
+
 namespace form::detail::experimental {
 
   class ROOT_TFileImp : public Storage_File {
@@ -20,9 +25,18 @@ namespace form::detail::experimental {
     void setAttribute(std::string const& key, std::string const& value) override;
 
     std::shared_ptr<TFile> getTFile();
+    /// Reader of an RNTuple in this file, opened on first use and shared by its fields
+    ROOT::RNTupleReader& getRNTupleReader(std::string const& name);
+
+  protected:
+    /// Wrap a TFile that is owned elsewhere (e.g. by a TBufferMerger)
+    ROOT_TFileImp(std::string const& name, char mode, std::shared_ptr<TFile> file);
+    /// Drop this object's reference to the TFile
+    void releaseTFile();
 
   private:
     std::shared_ptr<TFile> m_file;
+    std::map<std::string, std::unique_ptr<ROOT::RNTupleReader>> m_readers;
   };
 
 } // namespace form::detail::experimental
@@ -3,30 +3,90 @@
 #include "root_ttree_container.hpp"
 #include "root_tfile.hpp"
 
+#include "TBranch.h"
 #include "TFile.h"
+#include "TObjArray.h"
 #include "TTree.h"
 
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+
+namespace {
+  // ROOT's default cluster size (see TTree::SetAutoFlush)
+  constexpr long defaultFlushBytes = 30000000;
+}
+
 using namespace form::detail::experimental;
 
 ROOT_TTree_ContainerImp::ROOT_TTree_ContainerImp(std::string const& name) :
-  Storage_Association(name), m_tfile(nullptr), m_tree(nullptr)
+  Storage_Association(name),
+  m_tfile(nullptr),
+  m_tree(nullptr),
+  m_autoFlush(-defaultFlushBytes),
+  m_basketSample(100),
+  m_optimizeBaskets(true),
+  m_report(false),
+  m_closed(false),
+  m_tuned(false),
+  m_entries(0),
+  m_flushEntries(0),
+  m_unflushedEntries(0),
+  m_flushedBytes(0)
 {
 }
 
 ROOT_TTree_ContainerImp::~ROOT_TTree_ContainerImp()
 {
   if (m_tree != nullptr) {
-    // Calling:
-    //   m_tree->Write();
-    // requires the TTree's directory to be the current directory, so we could do
-    //   TDirectory::TContext ctxt(m_tree->GetDirectory());
-    //   m_tree->Write();
-    // or let's just do:
-    m_tree->AutoSave("flushbaskets");
+    if (!m_closed) {
+      // Errors can only be reported by close()
+      m_tree->AutoSave("flushbaskets");
+      if (m_report) {
+        report();
+      }
+    }
     delete m_tree;
   }
 }
 
+void ROOT_TTree_ContainerImp::close()
+{
+  if (m_tree == nullptr || m_closed) {
+    return;
+  }
+  m_closed = true;
+  // Calling:
+  //   m_tree->Write();
+  // requires the TTree's directory to be the current directory, so we could do
+  //   TDirectory::TContext ctxt(m_tree->GetDirectory());
+  //   m_tree->Write();
+  // or let's just do:
+  m_tree->AutoSave("flushbaskets");
+  if (m_tfile->TestBit(TFile::kWriteError)) {
+    throw std::runtime_error("ROOT_TTree_ContainerImp::close failed to write " + name());
+  }
+  if (m_report) {
+    report();
+  }
+}
+
+void ROOT_TTree_ContainerImp::setAttribute(std::string const& key, std::string const& value)
+{
+  if (key == "auto_flush") {
+    m_autoFlush = std::stol(value);
+  } else if (key == "basket_sample") {
+    m_basketSample = std::max(std::stol(value), 1L);
+  } else if (key == "optimize_baskets") {
+    m_optimizeBaskets = (value == "true");
+  } else if (key == "report") {
+    m_report = (value == "true");
+  } else {
+    throw std::runtime_error("ROOT_TTree_ContainerImp accepts some attributes, but not " + key);
+  }
+}
+
 void ROOT_TTree_ContainerImp::setFile(std::shared_ptr<IStorage_File> file)
 {
   this->Storage_Association::setFile(file);
@@ -77,3 +137,76 @@ bool ROOT_TTree_ContainerImp::read(int /* id*/,
 }
 
 TTree* ROOT_TTree_ContainerImp::getTTree() { return m_tree; }
+
+void ROOT_TTree_ContainerImp::setFixedBasketSize(TBranch* branch, int size)
+{
+  branch->SetBasketSize(size);
+  m_fixedBasketSizes.emplace_back(branch, size);
+}
+
+void ROOT_TTree_ContainerImp::entryCommitted()
+{
+  ++m_entries;
+  ++m_unflushedEntries;
+  if (!m_tuned) {
+    // Large entries are measured over fewer entries, so that no more than a cluster is buffered
+    long long const flushBytes = (m_autoFlush < 0) ? -m_autoFlush : defaultFlushBytes;
+    if (m_entries >= m_basketSample || m_tree->GetTotBytes() - m_flushedBytes >= flushBytes) {
+      tuneBaskets();
+    }
+    return;
+  }
+  if (m_flushEntries > 0 && m_unflushedEntries >= m_flushEntries) {
+    m_tree->FlushBaskets(true);
+    m_unflushedEntries = 0;
+    m_flushedBytes = m_tree->GetTotBytes();
+  }
+}
+
+void ROOT_TTree_ContainerImp::tuneBaskets()
+{
+  m_tuned = true;
+  long long const sampleBytes = m_tree->GetTotBytes() - m_flushedBytes;
+  long long const bytesPerEntry = std::max(sampleBytes / std::max(m_unflushedEntries, 1L), 1LL);
+  if (m_autoFlush > 0) {
+    m_flushEntries = m_autoFlush;
+  } else if (m_autoFlush < 0) {
+    m_flushEntries = std::max(static_cast<long>(-m_autoFlush / bytesPerEntry), 1L);
+  }
+  // Recorded for readers, which size their TTree cache from it
+  m_tree->SetAutoFlush(m_flushEntries);
+
+  if (m_optimizeBaskets) {
+    // Share the memory of a cluster among the branches in proportion to their sizes, so that
+    // each branch writes about one basket per cluster.
+    long long const clusterBytes =
+      bytesPerEntry * (m_flushEntries > 0 ? m_flushEntries : m_unflushedEntries);
+    m_tree->OptimizeBaskets(static_cast<ULong64_t>(clusterBytes), 1.1, "");
+    for (auto const& [branch, size] : m_fixedBasketSizes) {
+      branch->SetBasketSize(size);
+    }
+  }
+
+  // The measured entries form the first cluster
+  if (m_flushEntries > 0) {
+    m_tree->FlushBaskets(true);
+    m_unflushedEntries = 0;
+    m_flushedBytes = m_tree->GetTotBytes();
+  }
+}
+
+void ROOT_TTree_ContainerImp::report()
+{
+  std::cout << "FORM TTree " << name() << ": " << m_tree->GetEntries() << " entries\n";
+  TObjArray* branches = m_tree->GetListOfBranches();
+  for (int i = 0; i != branches->GetEntriesFast(); ++i) {
+    auto* branch = static_cast<TBranch*>(branches->UncheckedAt(i));
+    auto const totBytes = branch->GetTotBytes("*");
+    auto const zipBytes = branch->GetZipBytes("*");
+    std::cout << "  " << branch->GetName() << ": " << totBytes << " bytes, " << zipBytes
+              << " compressed, ratio " << std::fixed << std::setprecision(2)
+              << (zipBytes > 0 ? static_cast<double>(totBytes) / zipBytes : 0.0)
+              << ", basket size " << branch->GetBasketSize() << '\n';
+  }
+  std::cout << std::defaultfloat;
+}
@@ -8,12 +8,26 @@
 #include <memory>
 #include <string>
 #include <typeinfo>
+#include <utility>
+#include <vector>
 
+class TBranch;
 class TFile;
 class TTree;
 
 namespace form::detail::experimental {
 
+  /* Branches are filled one by one rather than through TTree::Fill, which is where ROOT flushes
+   * baskets and optimizes their sizes.  The tree container does this instead, once all
+   * branches of an entry have been filled (entryCommitted): the sizes of the first entries are
+   * measured, from which the number of entries per cluster (auto-flush) and the basket size of
+   * each branch are derived.  Tree attributes, set through the attributes of its branches:
+   *   auto_flush       entries per cluster if positive, uncompressed bytes per cluster if
+   *                    negative (default -30000000), 0 to only flush when the tree is closed
+   *   basket_sample    number of entries measured before the baskets are sized (default 100)
+   *   optimize_baskets "false" keeps the basket sizes set when the branches were created
+   *   report           "true" prints the bytes written and compression of each branch on close
+   */
   class ROOT_TTree_ContainerImp : public Storage_Association {
   public:
     ROOT_TTree_ContainerImp(std::string const& name);
@@ -22,17 +36,39 @@ namespace form::detail::experimental {
     ROOT_TTree_ContainerImp(ROOT_TTree_ContainerImp const& other) = delete;
     ROOT_TTree_ContainerImp& operator=(ROOT_TTree_ContainerImp& other) = delete;
 
+    void setAttribute(std::string const& key, std::string const& value) override;
     void setFile(std::shared_ptr<IStorage_File> file) override;
     void setupWrite(std::type_info const& type = typeid(void)) override;
     void fill(void const* data) override;
     void commit() override;
     bool read(int id, void const** data, std::type_info const& type) override;
+    void close() override;
 
     TTree* getTTree();
 
+    /// The basket size of the branch is not changed by the basket optimization
+    void setFixedBasketSize(TBranch* branch, int size);
+    /// All branches of the next entry have been filled
+    void entryCommitted();
+
   private:
+    void tuneBaskets();
+    void report();
+
     std::shared_ptr<TFile> m_tfile;
     TTree* m_tree;
+    long m_autoFlush;
+    long m_basketSample;
+    bool m_optimizeBaskets;
+    bool m_report;
+    bool m_closed;
+
+    bool m_tuned;
+    long m_entries;           // Entries committed to this container
+    long m_flushEntries;      // Entries per cluster once tuned; 0 if baskets are not flushed
+    long m_unflushedEntries;
+    long long m_flushedBytes; // Uncompressed bytes of the tree when its baskets were last flushed
+    std::vector<std::pair<TBranch*, int>> m_fixedBasketSizes;
   };
 
 } //namespace form::detail::experimental
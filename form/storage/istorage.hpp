@@ -15,6 +15,8 @@
 
 namespace form::detail::experimental {
 
+  class IStorage_Container;
+
   class IStorage {
   public:
     IStorage() = default;
@@ -26,8 +28,14 @@ namespace form::detail::experimental {
     virtual void fillContainer(Placement const& plcmnt,
                                void const* data,
                                std::type_info const& type) = 0;
+    virtual void fillIndex(Placement const& plcmnt, std::string const& id) = 0;
     virtual void commitContainers(Placement const& plcmnt) = 0;
 
+    // Direct handles to containers created by createContainers, for callers that write
+    // repeatedly to the same containers.  Filling the index container records the segment ID.
+    virtual std::shared_ptr<IStorage_Container> getContainer(Placement const& plcmnt) = 0;
+    virtual std::shared_ptr<IStorage_Container> getIndexContainer(Placement const& plcmnt) = 0;
+
     virtual int getIndex(Token const& token,
                          std::string const& id,
                          form::experimental::config::tech_setting_config const& settings) = 0;
@@ -35,6 +43,14 @@ namespace form::detail::experimental {
                                void const** data,
                                std::type_info const& type,
                                form::experimental::config::tech_setting_config const& settings) = 0;
+    /// Segment IDs of all rows of an index container, in row order
+    virtual std::vector<std::string> readIndex(
+      Token const& token, form::experimental::config::tech_setting_config const& settings) = 0;
+    /// Rebuild the segment index of an index container by reading all of its rows
+    virtual void rebuildIndex(Token const& token,
+                              form::experimental::config::tech_setting_config const& settings) = 0;
+    /// Finish writing: persist the segment index of every output file.  Throws if that fails.
+    virtual void close() = 0;
   };
 
   class IStorage_File {
@@ -46,6 +62,8 @@ namespace form::detail::experimental {
     virtual char const mode() = 0;
 
     virtual void setAttribute(std::string const& name, std::string const& value) = 0;
+    /// Finish writing the file; throws if the written data cannot be completed
+    virtual void close() = 0;
   };
 
   class IStorage_Container {
@@ -59,12 +77,16 @@ namespace form::detail::experimental {
     virtual void setupWrite(std::type_info const& type = typeid(void)) = 0;
     virtual void fill(void const* data) = 0;
     virtual void commit() = 0;
+    /// The object read is allocated as if by `new T` for the requested type T, and the caller
+    /// releases it with `delete static_cast<T const*>(*data)`, whatever the backend.
     virtual bool read(int id, void const** data, std::type_info const& type) = 0;
 
     virtual void setAttribute(std::string const& name, std::string const& value) = 0;
+    /// Finish writing the container; throws if the written data cannot be made durable
+    virtual void close() = 0;
   };
 
-  std::unique_ptr<IStorage> createStorage();
+  std::unique_ptr<IStorage> createStorage(char outputMode = 'o');
 
 } // namespace form::detail::experimental
 
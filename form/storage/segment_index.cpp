@@ -0,0 +1,252 @@
+// Copyright (C) 2025 ...
+
+#include "segment_index.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <ranges>
+#include <stdexcept>
+
+using namespace form::detail::experimental;
+
+namespace {
+  // On-disk layout (native byte order):
+  //   Header, TableDescriptor[tableCount], names, then per table: entries (8-byte aligned), keys
+  constexpr char indexMagic[8] = {'F', 'O', 'R', 'M', 'S', 'I', 'D', 'X'};
+  constexpr std::uint64_t indexVersion = 1;
+
+  struct Header {
+    char magic[8];
+    std::uint64_t version;
+    std::uint64_t tableCount;
+  };
+
+  struct TableDescriptor {
+    std::uint64_t nameOffset;
+    std::uint64_t nameSize;
+    std::uint64_t entriesOffset;
+    std::uint64_t entryCount;
+    std::uint64_t keysOffset;
+    std::uint64_t keysSize;
+  };
+
+  static_assert(sizeof(Segment_Index_Entry) == 24);
+
+  std::uint64_t align8(std::uint64_t offset) { return (offset + 7) & ~std::uint64_t{7}; }
+}
+
+namespace form::detail::experimental {
+
+  std::uint64_t segmentHash(std::string_view id)
+  {
+    std::uint64_t hash = 14695981039346656037ull;
+    for (unsigned char c : id) {
+      hash ^= c;
+      hash *= 1099511628211ull;
+    }
+    return hash;
+  }
+
+  std::string segmentIndexFileName(std::string const& fileName) { return fileName + ".fidx"; }
+
+} // namespace form::detail::experimental
+
+int Segment_Index_Table::add(std::string_view id)
+{
+  if (m_entries.size() >= static_cast<std::size_t>(std::numeric_limits<std::int32_t>::max())) {
+    throw std::runtime_error("Segment_Index_Table::add too many rows in index container");
+  }
+  auto const row = static_cast<std::int32_t>(m_entries.size());
+  m_entries.push_back({segmentHash(id),
+                       static_cast<std::uint64_t>(m_keys.size()),
+                       static_cast<std::uint32_t>(id.size()),
+                       row});
+  m_keys.append(id);
+  return row;
+}
+
+Segment_Index_Table& Segment_Index_Writer::table(std::string const& containerName)
+{
+  return m_tables[containerName];
+}
+
+int Segment_Index_Writer::add(std::string const& containerName, std::string_view id)
+{
+  return table(containerName).add(id);
+}
+
+void Segment_Index_Writer::write(std::string const& indexFileName) const
+{
+  Header header{};
+  std::memcpy(header.magic, indexMagic, sizeof(indexMagic));
+  header.version = indexVersion;
+  header.tableCount = m_tables.size();
+
+  // Compute the layout
+  std::vector<TableDescriptor> descriptors;
+  descriptors.reserve(m_tables.size());
+  std::uint64_t offset = sizeof(Header) + m_tables.size() * sizeof(TableDescriptor);
+  for (auto const& [name, table] : m_tables) {
+    descriptors.push_back(
+      {offset, name.size(), 0, table.entries().size(), 0, table.keys().size()});
+    offset += name.size();
+  }
+  auto descriptor = descriptors.begin();
+  for (auto const& table : m_tables | std::views::values) {
+    offset = align8(offset);
+    descriptor->entriesOffset = offset;
+    offset += table.entries().size() * sizeof(Segment_Index_Entry);
+    descriptor->keysOffset = offset;
+    offset += table.keys().size();
+    ++descriptor;
+  }
+
+  // Write to a temporary file first so that readers never see a partial index
+  std::string const tmpName = indexFileName + ".tmp";
+  {
+    std::ofstream out(tmpName, std::ios::binary | std::ios::trunc);
+    if (!out) {
+      throw std::runtime_error("Segment_Index_Writer::write cannot open " + tmpName);
+    }
+    char const padding[8] = {};
+    std::uint64_t position = 0;
+    auto put = [&out, &position](void const* data, std::uint64_t size) {
+      out.write(static_cast<char const*>(data), static_cast<std::streamsize>(size));
+      position += size;
+    };
+    put(&header, sizeof(Header));
+    put(descriptors.data(), descriptors.size() * sizeof(TableDescriptor));
+    for (auto const& name : m_tables | std::views::keys) {
+      put(name.data(), name.size());
+    }
+    descriptor = descriptors.begin();
+    for (auto const& table : m_tables | std::views::values) {
+      put(padding, (descriptor++)->entriesOffset - position);
+      // Rows were added in increasing order, so a stable sort keeps the first row of a
+      // duplicated segment ID in front.
+      std::vector<Segment_Index_Entry> sorted(table.entries());
+      std::ranges::stable_sort(sorted, {}, &Segment_Index_Entry::hash);
+      put(sorted.data(), sorted.size() * sizeof(Segment_Index_Entry));
+      put(table.keys().data(), table.keys().size());
+    }
+    if (!out) {
+      throw std::runtime_error("Segment_Index_Writer::write failed writing " + tmpName);
+    }
+  }
+  std::filesystem::rename(tmpName, indexFileName);
+}
+
+std::unique_ptr<Segment_Index_Reader> Segment_Index_Reader::open(std::string const& indexFileName)
+{
+  std::error_code ec;
+  if (!std::filesystem::is_regular_file(indexFileName, ec)) {
+    return nullptr;
+  }
+  return std::make_unique<Segment_Index_Reader>(indexFileName);
+}
+
+Segment_Index_Reader::Segment_Index_Reader(std::string const& indexFileName) :
+  m_name(indexFileName), m_map(nullptr), m_size(0), m_buffer(), m_data(nullptr), m_tables()
+{
+  int const fd = ::open(indexFileName.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("Segment_Index_Reader cannot open " + indexFileName);
+  }
+  struct stat st;
+  if (::fstat(fd, &st) != 0) {
+    ::close(fd);
+    throw std::runtime_error("Segment_Index_Reader cannot stat " + indexFileName);
+  }
+  m_size = static_cast<std::size_t>(st.st_size);
+  if (m_size != 0) {
+    void* map = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (map != MAP_FAILED) {
+      m_map = map;
+      m_data = static_cast<char const*>(map);
+    }
+  }
+  ::close(fd);
+
+  if (m_data == nullptr) {
+    std::ifstream in(indexFileName, std::ios::binary);
+    m_buffer.resize(m_size);
+    in.read(m_buffer.data(), static_cast<std::streamsize>(m_size));
+    if (!in) {
+      throw std::runtime_error("Segment_Index_Reader cannot read " + indexFileName);
+    }
+    m_data = m_buffer.data();
+  }
+
+  Header header;
+  if (m_size < sizeof(Header)) {
+    throw std::runtime_error("Segment_Index_Reader truncated index file " + indexFileName);
+  }
+  std::memcpy(&header, m_data, sizeof(Header));
+  if (std::memcmp(header.magic, indexMagic, sizeof(indexMagic)) != 0 ||
+      header.version != indexVersion) {
+    throw std::runtime_error("Segment_Index_Reader unsupported index file " + indexFileName);
+  }
+  if (header.tableCount > (m_size - sizeof(Header)) / sizeof(TableDescriptor)) {
+    throw std::runtime_error("Segment_Index_Reader truncated index file " + indexFileName);
+  }
+  for (std::uint64_t i = 0; i != header.tableCount; ++i) {
+    TableDescriptor d;
+    std::memcpy(&d, m_data + sizeof(Header) + i * sizeof(TableDescriptor), sizeof(d));
+    bool const valid = d.nameOffset + d.nameSize <= m_size && d.entriesOffset % 8 == 0 &&
+                       d.entriesOffset + d.entryCount * sizeof(Segment_Index_Entry) <= m_size &&
+                       d.keysOffset + d.keysSize <= m_size;
+    if (!valid) {
+      throw std::runtime_error("Segment_Index_Reader corrupt index file " + indexFileName);
+    }
+    m_tables.emplace(std::string(m_data + d.nameOffset, d.nameSize),
+                     Table{reinterpret_cast<Segment_Index_Entry const*>(m_data + d.entriesOffset),
+                           d.entryCount,
+                           m_data + d.keysOffset,
+                           d.keysSize});
+  }
+}
+
+Segment_Index_Reader::~Segment_Index_Reader()
+{
+  if (m_map != nullptr) {
+    ::munmap(m_map, m_size);
+  }
+}
+
+bool Segment_Index_Reader::hasContainer(std::string const& containerName) const
+{
+  return m_tables.contains(containerName);
+}
+
+std::optional<int> Segment_Index_Reader::find(std::string const& containerName,
+                                              std::string_view id) const
+{
+  auto it = m_tables.find(containerName);
+  if (it == m_tables.end()) {
+    return std::nullopt;
+  }
+  auto const& table = it->second;
+  std::uint64_t const hash = segmentHash(id);
+  auto const* first = table.entries;
+  auto const* last = table.entries + table.entryCount;
+  auto const* entry = std::lower_bound(
+    first, last, hash, [](Segment_Index_Entry const& e, std::uint64_t h) { return e.hash < h; });
+  for (; entry != last && entry->hash == hash; ++entry) {
+    // Resolve hash collisions by comparing the segment IDs themselves
+    if (entry->keyOffset + entry->keySize > table.keysSize) {
+      throw std::runtime_error("Segment_Index_Reader corrupt index file " + m_name);
+    }
+    if (std::string_view(table.keys + entry->keyOffset, entry->keySize) == id) {
+      return entry->row;
+    }
+  }
+  return std::nullopt;
+}
@@ -0,0 +1,100 @@
+// Copyright (C) 2025 ...
+
+#ifndef __SEGMENT_INDEX_HPP__
+#define __SEGMENT_INDEX_HPP__
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/* @class Segment_Index_Writer, Segment_Index_Reader
+ * @brief Persistent lookup table from segment ID to row number of the index containers of a file.
+ *
+ * The table is written next to the data file (see segmentIndexFileName) when the file is closed.
+ * For each index container, it holds the entries sorted by a 64-bit hash of the segment ID; the
+ * segment IDs themselves are kept in a separate key pool and are only compared to resolve hash
+ * collisions.  The reader memory-maps the table, so that a lookup is a binary search that
+ * neither reads the index container nor materializes its strings.
+ */
+namespace form::detail::experimental {
+
+  /// Stable (FNV-1a) hash of a segment ID
+  std::uint64_t segmentHash(std::string_view id);
+
+  /// Name of the segment-index file that accompanies a data file
+  std::string segmentIndexFileName(std::string const& fileName);
+
+  struct Segment_Index_Entry {
+    std::uint64_t hash;
+    std::uint64_t keyOffset;
+    std::uint32_t keySize;
+    std::int32_t row;
+  };
+
+  /// Segment IDs of the rows of one index container, in row order
+  class Segment_Index_Table {
+  public:
+    /// Record that the next row of the index container holds the segment ID
+    int add(std::string_view id);
+
+    std::vector<Segment_Index_Entry> const& entries() const { return m_entries; }
+    std::string const& keys() const { return m_keys; }
+
+  private:
+    std::vector<Segment_Index_Entry> m_entries;
+    std::string m_keys;
+  };
+
+  class Segment_Index_Writer {
+  public:
+    Segment_Index_Writer() = default;
+
+    /// The returned reference stays valid for the lifetime of the writer
+    Segment_Index_Table& table(std::string const& containerName);
+    int add(std::string const& containerName, std::string_view id);
+    /// Write the sorted tables of all index containers
+    void write(std::string const& indexFileName) const;
+
+  private:
+    std::map<std::string, Segment_Index_Table> m_tables;
+  };
+
+  class Segment_Index_Reader {
+  public:
+    /// Returns nullptr if no segment-index file exists
+    static std::unique_ptr<Segment_Index_Reader> open(std::string const& indexFileName);
+
+    explicit Segment_Index_Reader(std::string const& indexFileName);
+    ~Segment_Index_Reader();
+
+    Segment_Index_Reader(Segment_Index_Reader const&) = delete;
+    Segment_Index_Reader& operator=(Segment_Index_Reader const&) = delete;
+
+    bool hasContainer(std::string const& containerName) const;
+    std::optional<int> find(std::string const& containerName, std::string_view id) const;
+
+  private:
+    struct Table {
+      Segment_Index_Entry const* entries;
+      std::size_t entryCount;
+      char const* keys;
+      std::size_t keysSize;
+    };
+
+    std::string m_name;
+    void* m_map;
+    std::size_t m_size;
+    std::vector<char> m_buffer; // Used if the file cannot be memory-mapped
+    char const* m_data;
+    std::unordered_map<std::string, Table> m_tables;
+  };
+
+} // namespace form::detail::experimental
+
+#endif
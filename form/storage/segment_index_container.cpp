@@ -0,0 +1,47 @@
+// Copyright (C) 2025 ...
+
+#include "segment_index_container.hpp"
+
+#include <string>
+#include <utility>
+
+using namespace form::detail::experimental;
+
+Segment_Index_Container::Segment_Index_Container(std::shared_ptr<IStorage_Container> container,
+                                                 Segment_Index_Table& table) :
+  m_container(std::move(container)), m_table(table)
+{
+}
+
+std::string const& Segment_Index_Container::name() { return m_container->name(); }
+
+void Segment_Index_Container::setFile(std::shared_ptr<IStorage_File> file)
+{
+  m_container->setFile(file);
+}
+
+void Segment_Index_Container::setupWrite(std::type_info const& type)
+{
+  m_container->setupWrite(type);
+}
+
+void Segment_Index_Container::fill(void const* data)
+{
+  m_container->fill(data);
+  m_table.add(*static_cast<std::string const*>(data));
+  return;
+}
+
+void Segment_Index_Container::commit() { m_container->commit(); }
+
+bool Segment_Index_Container::read(int id, void const** data, std::type_info const& type)
+{
+  return m_container->read(id, data, type);
+}
+
+void Segment_Index_Container::setAttribute(std::string const& name, std::string const& value)
+{
+  m_container->setAttribute(name, value);
+}
+
+void Segment_Index_Container::close() { m_container->close(); }
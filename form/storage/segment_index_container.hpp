@@ -0,0 +1,45 @@
+// Copyright (C) 2025 ...
+
+#ifndef __SEGMENT_INDEX_CONTAINER_HPP__
+#define __SEGMENT_INDEX_CONTAINER_HPP__
+
+#include "istorage.hpp"
+#include "segment_index.hpp"
+
+#include <memory>
+#include <string>
+#include <typeinfo>
+
+namespace form::detail::experimental {
+
+  /* @class Segment_Index_Container
+   * @brief Index container that also records the row of each segment ID it is filled with.
+   *
+   * Fills are forwarded to the technology-specific index container; the data passed to fill()
+   * must be a std::string holding the segment ID.
+   */
+  class Segment_Index_Container : public IStorage_Container {
+  public:
+    Segment_Index_Container(std::shared_ptr<IStorage_Container> container,
+                            Segment_Index_Table& table);
+    ~Segment_Index_Container() = default;
+
+    std::string const& name() override;
+
+    void setFile(std::shared_ptr<IStorage_File> file) override;
+    void setupWrite(std::type_info const& type = typeid(void)) override;
+    void fill(void const* data) override;
+    void commit() override;
+    bool read(int id, void const** data, std::type_info const& type) override;
+
+    void setAttribute(std::string const& name, std::string const& value) override;
+    void close() override;
+
+  private:
+    std::shared_ptr<IStorage_Container> m_container;
+    Segment_Index_Table& m_table;
+  };
+
+} // namespace form::detail::experimental
+
+#endif
@@ -1,13 +1,17 @@
 // Copyright (C) 2025 ...
 
 #include "storage.hpp"
+#include "segment_index_container.hpp"
 #include "storage_association.hpp"
 #include "storage_associative_container.hpp"
 #include "storage_file.hpp"
 
 #include "util/factories.hpp"
 
+#include <filesystem>
+#include <iostream>
 #include <memory>
+#include <ranges>
 #include <stdexcept>
 #include <typeinfo>
 
@@ -15,7 +19,51 @@ using namespace form::detail::experimental;
 
 // Factory function implementation
 namespace form::detail::experimental {
-  std::unique_ptr<IStorage> createStorage() { return std::unique_ptr<IStorage>(new Storage()); }
+  std::unique_ptr<IStorage> createStorage(char outputMode)
+  {
+    return std::unique_ptr<IStorage>(new Storage(outputMode));
+  }
+}
+
+Storage::Storage(char outputMode) : m_outputMode(outputMode) {}
+
+Storage::~Storage()
+{
+  // Storages that are not closed explicitly still persist their segment indices, but errors
+  // can then only be reported here.
+  if (m_closed) {
+    return;
+  }
+  try {
+    close();
+  } catch (std::exception const& e) {
+    std::cerr << "Storage: " << e.what() << '\n';
+  }
+}
+
+void Storage::close()
+{
+  if (m_closed) {
+    return;
+  }
+  m_closed = true;
+  // The data must be complete before the segment index that refers to it is written.  The
+  // index containers wrap containers of m_containers, so they are closed with them.
+  for (auto const& container : m_containers | std::views::values) {
+    container->close();
+  }
+  for (auto const& file : m_files | std::views::values) {
+    file->close();
+  }
+  // Rows of a file that is merged with the output of other storages are not final; the
+  // segment index of such a file is rebuilt once it has been merged (see rebuildIndex).
+  if (m_outputMode == 'm') {
+    return;
+  }
+  // Persist the segment indices next to their data files
+  for (auto const& [fileName, writer] : m_indexWriters) {
+    writer.write(segmentIndexFileName(fileName));
+  }
 }
 
 void Storage::createContainers(
@@ -31,7 +79,11 @@ void Storage::createContainers(
       auto file = m_files.find(plcmnt->fileName());
       if (file == m_files.end()) {
         m_files.insert(
-          {plcmnt->fileName(), createFile(plcmnt->technology(), plcmnt->fileName(), 'o')});
+          {plcmnt->fileName(),
+           createFile(plcmnt->technology(), plcmnt->fileName(), m_outputMode)});
+        // The file is recreated, so a segment index left over from a previous file is stale
+        std::error_code ec;
+        std::filesystem::remove(segmentIndexFileName(plcmnt->fileName()), ec);
         file = m_files.find(plcmnt->fileName());
         for (auto const& [key, value] :
              settings.getFileTable(plcmnt->technology(), plcmnt->fileName()))
@@ -88,6 +140,12 @@ void Storage::fillContainer(Placement const& plcmnt,
   return;
 }
 
+void Storage::fillIndex(Placement const& plcmnt, std::string const& id)
+{
+  getIndexContainer(plcmnt)->fill(&id);
+  return;
+}
+
 void Storage::commitContainers(Placement const& plcmnt)
 {
   auto key = std::make_pair(plcmnt.fileName(), plcmnt.containerName());
@@ -96,31 +154,58 @@ void Storage::commitContainers(Placement const& plcmnt)
   return;
 }
 
+std::shared_ptr<IStorage_Container> Storage::getContainer(Placement const& plcmnt)
+{
+  auto cont = m_containers.find(std::make_pair(plcmnt.fileName(), plcmnt.containerName()));
+  if (cont == m_containers.end()) {
+    throw std::runtime_error("Storage::getContainer Container doesn't exist: " +
+                             plcmnt.containerName());
+  }
+  return cont->second;
+}
+
+std::shared_ptr<IStorage_Container> Storage::getIndexContainer(Placement const& plcmnt)
+{
+  auto key = std::make_pair(plcmnt.fileName(), plcmnt.containerName());
+  auto cont = m_indexContainers.find(key);
+  if (cont == m_indexContainers.end()) {
+    auto index = std::make_shared<Segment_Index_Container>(
+      getContainer(plcmnt),
+      m_indexWriters[plcmnt.fileName()].table(plcmnt.containerName()));
+    cont = m_indexContainers.emplace(std::move(key), std::move(index)).first;
+  }
+  return cont->second;
+}
+
 int Storage::getIndex(Token const& token,
                       std::string const& id,
                       form::experimental::config::tech_setting_config const& settings)
 {
-  if (m_indexMaps[token.containerName()].empty()) {
-    auto key = std::make_pair(token.fileName(), token.containerName());
-    auto cont = m_containers.find(key);
-    if (cont == m_containers.end()) {
-      auto file = m_files.find(token.fileName());
-      if (file == m_files.end()) {
-        m_files.insert({token.fileName(), createFile(token.technology(), token.fileName(), 'i')});
-        file = m_files.find(token.fileName());
-        for (auto const& [key, value] : settings.getFileTable(token.technology(), token.fileName()))
-          file->second->setAttribute(key, value);
-      }
-      m_containers.insert({key, createContainer(token.technology(), token.containerName())});
-      cont = m_containers.find(key);
-      for (auto const& [key, value] :
-           settings.getContainerTable(token.technology(), token.containerName()))
-        cont->second->setAttribute(key, value);
-      cont->second->setFile(file->second);
+  // The segment index of a file that is still being written is only persisted when the
+  // file is closed.
+  auto reader = m_indexReaders.find(token.fileName());
+  if (reader == m_indexReaders.end() && !m_indexWriters.contains(token.fileName())) {
+    reader = m_indexReaders
+               .emplace(token.fileName(),
+                        Segment_Index_Reader::open(segmentIndexFileName(token.fileName())))
+               .first;
+  }
+  if (reader != m_indexReaders.end() && reader->second &&
+      reader->second->hasContainer(token.containerName())) {
+    auto const row = reader->second->find(token.containerName(), id);
+    if (!row) {
+      throw std::runtime_error("Storage::getIndex segment " + id + " not found in container " +
+                               token.containerName());
     }
+    return *row;
+  }
+
+  // Files written without a segment index: scan the index container
+  if (m_indexMaps[token.containerName()].empty()) {
+    auto cont = getInputContainer(token, settings);
     void const* data;
-    int entry = 1;
-    while (cont->second->read(entry, &data, typeid(std::string))) {
+    int entry = 0;
+    while (cont->read(entry, &data, typeid(std::string))) {
       m_indexMaps[token.containerName()].insert(
         std::make_pair(*(static_cast<std::string const*>(data)), entry));
       delete static_cast<std::string const*>(
@@ -128,14 +213,49 @@ int Storage::getIndex(Token const& token,
       entry++;
     }
   }
-  int entry = m_indexMaps[token.containerName()][id];
-  return entry;
+  auto const& indexMap = m_indexMaps[token.containerName()];
+  auto const row = indexMap.find(id);
+  if (row == indexMap.end()) {
+    throw std::runtime_error("Storage::getIndex segment " + id + " not found in container " +
+                             token.containerName());
+  }
+  return row->second;
 }
 
 void Storage::readContainer(Token const& token,
                             void const** data,
                             std::type_info const& type,
                             form::experimental::config::tech_setting_config const& settings)
+{
+  getInputContainer(token, settings)->read(token.id(), data, type);
+  return;
+}
+
+std::vector<std::string> Storage::readIndex(
+  Token const& token, form::experimental::config::tech_setting_config const& settings)
+{
+  auto cont = getInputContainer(token, settings);
+  std::vector<std::string> ids;
+  void const* data;
+  for (int row = 0; cont->read(row, &data, typeid(std::string)); ++row) {
+    std::unique_ptr<std::string const> id{static_cast<std::string const*>(data)};
+    ids.push_back(*id);
+  }
+  return ids;
+}
+
+void Storage::rebuildIndex(Token const& token,
+                           form::experimental::config::tech_setting_config const& settings)
+{
+  auto& table = m_indexWriters[token.fileName()].table(token.containerName());
+  for (auto const& id : readIndex(token, settings)) {
+    table.add(id);
+  }
+  return;
+}
+
+std::shared_ptr<IStorage_Container> Storage::getInputContainer(
+  Token const& token, form::experimental::config::tech_setting_config const& settings)
 {
   auto key = std::make_pair(token.fileName(), token.containerName());
   auto cont = m_containers.find(key);
@@ -154,6 +274,5 @@ void Storage::readContainer(Token const& token,
          settings.getContainerTable(token.technology(), token.containerName()))
       cont->second->setAttribute(key, value);
   }
-  cont->second->read(token.id(), data, type);
-  return;
+  return cont->second;
 }
@@ -4,12 +4,14 @@
 #define __STORAGE_HPP__
 
 #include "istorage.hpp"
+#include "segment_index.hpp"
 
 #include <map>
 #include <memory>
 #include <string>
 #include <unordered_map>
 #include <utility> // for std::pair
+#include <vector>
 
 namespace form::detail::experimental {
 
@@ -26,8 +28,10 @@ namespace form::detail::experimental {
 
   class Storage : public IStorage {
   public:
-    Storage() = default;
-    ~Storage() = default;
+    /// Output files are created with the given mode ('o' to create a file, 'm' to contribute to
+    /// a file that is merged from several storages)
+    explicit Storage(char outputMode = 'o');
+    ~Storage();
 
     using table_t = form::experimental::config::tech_setting_config::table_t;
     void createContainers(
@@ -36,8 +40,12 @@ namespace form::detail::experimental {
     void fillContainer(Placement const& plcmnt,
                        void const* data,
                        std::type_info const& type) override;
+    void fillIndex(Placement const& plcmnt, std::string const& id) override;
     void commitContainers(Placement const& plcmnt) override;
 
+    std::shared_ptr<IStorage_Container> getContainer(Placement const& plcmnt) override;
+    std::shared_ptr<IStorage_Container> getIndexContainer(Placement const& plcmnt) override;
+
     int getIndex(Token const& token,
                  std::string const& id,
                  form::experimental::config::tech_setting_config const& settings) override;
@@ -45,14 +53,30 @@ namespace form::detail::experimental {
                        void const** data,
                        std::type_info const& type,
                        form::experimental::config::tech_setting_config const& settings) override;
+    std::vector<std::string> readIndex(
+      Token const& token, form::experimental::config::tech_setting_config const& settings) override;
+    void rebuildIndex(Token const& token,
+                      form::experimental::config::tech_setting_config const& settings) override;
+    void close() override;
 
   private:
+    std::shared_ptr<IStorage_Container> getInputContainer(
+      Token const& token, form::experimental::config::tech_setting_config const& settings);
+
+    char m_outputMode;
+    bool m_closed = false;
     std::map<std::string, std::shared_ptr<IStorage_File>> m_files;
     std::unordered_map<std::pair<std::string, std::string>,
                        std::shared_ptr<IStorage_Container>,
                        pair_hash>
       m_containers;
+    std::unordered_map<std::pair<std::string, std::string>,
+                       std::shared_ptr<IStorage_Container>,
+                       pair_hash>
+      m_indexContainers;
     std::map<std::string, std::map<std::string, int>> m_indexMaps;
+    std::map<std::string, Segment_Index_Writer> m_indexWriters;
+    std::map<std::string, std::unique_ptr<Segment_Index_Reader>> m_indexReaders;
   };
 
 } // namespace form::detail::experimental
@@ -30,3 +30,5 @@ void Storage_Container::setAttribute(std::string const& /*name*/, std::string co
     "Storage_Container::setAttribute does not accept any attributes for a container named " +
     m_name);
 }
+
+void Storage_Container::close() { return; }
@@ -26,6 +26,7 @@ namespace form::detail::experimental {
     bool read(int id, void const** data, std::type_info const& type) override;
 
     void setAttribute(std::string const& name, std::string const& value) override;
+    void close() override;
 
   private:
     std::string m_name;
@@ -15,3 +15,5 @@ void Storage_File::setAttribute(std::string const& /*name*/, std::string const&
   throw std::runtime_error(
     "StorageFile::setAttribute does not accept any attributes for a file named " + m_name);
 }
+
+void Storage_File::close() { return; }
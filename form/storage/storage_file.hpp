@@ -17,6 +17,7 @@ namespace form::detail::experimental {
     char const mode() override;
 
     void setAttribute(std::string const& name, std::string const& value) override;
+    void close() override;
 
   private:
     std::string m_name;
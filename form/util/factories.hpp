@@ -5,13 +5,18 @@
 
 #include "form/technology.hpp"
 
+#include "native_storage/native_column_container.hpp"
+#include "native_storage/native_file.hpp"
 #include "storage/istorage.hpp"
 #include "storage/storage_association.hpp"
 #include "storage/storage_container.hpp"
 #include "storage/storage_file.hpp"
 
 #ifdef USE_ROOT_STORAGE
+#include "root_storage/root_rfield_container.hpp"
+#include "root_storage/root_rntuple_container.hpp"
 #include "root_storage/root_tbranch_container.hpp"
+#include "root_storage/root_tbuffermerger_file.hpp"
 #include "root_storage/root_tfile.hpp"
 #include "root_storage/root_ttree_container.hpp"
 #endif
@@ -25,10 +30,18 @@ namespace form::detail::experimental {
   {
     if (form::technology::GetMajor(tech) == form::technology::ROOT_MAJOR) {
 #ifdef USE_ROOT_STORAGE
+      // 'm': this file is merged with the files of other writers of the same name.  RNTuples
+      // are written to one shared file through a parallel writer instead.
+      if (mode == 'm' &&
+          form::technology::GetMinor(tech) != form::technology::ROOT_RNTUPLE_MINOR) {
+        return std::make_shared<ROOT_TBufferMerger_FileImp>(name, mode);
+      }
       return std::make_shared<ROOT_TFileImp>(name, mode);
 #endif
     } else if (form::technology::GetMajor(tech) == form::technology::HDF5_MAJOR) {
       // Handle HDF5 file creation when implemented
+    } else if (form::technology::GetMajor(tech) == form::technology::NATIVE_MAJOR) {
+      return std::make_shared<Native_File>(name, mode);
     }
     return std::make_shared<Storage_File>(name, mode);
   }
@@ -39,6 +52,10 @@ namespace form::detail::experimental {
       if (form::technology::GetMinor(tech) == form::technology::ROOT_TTREE_MINOR) {
 #ifdef USE_ROOT_STORAGE
         return std::make_shared<ROOT_TTree_ContainerImp>(name);
+#endif // USE_ROOT_STORAGE
+      } else if (form::technology::GetMinor(tech) == form::technology::ROOT_RNTUPLE_MINOR) {
+#ifdef USE_ROOT_STORAGE
+        return std::make_shared<ROOT_RNTuple_ContainerImp>(name);
 #endif // USE_ROOT_STORAGE
       }
     } else if (form::technology::GetMajor(tech) == form::technology::HDF5_MAJOR) {
@@ -59,6 +76,10 @@ namespace form::detail::experimental {
       if (form::technology::GetMinor(tech) == form::technology::ROOT_TTREE_MINOR) {
 #ifdef USE_ROOT_STORAGE
         return std::make_shared<ROOT_TBranch_ContainerImp>(name);
+#endif // USE_ROOT_STORAGE
+      } else if (form::technology::GetMinor(tech) == form::technology::ROOT_RNTUPLE_MINOR) {
+#ifdef USE_ROOT_STORAGE
+        return std::make_shared<ROOT_RField_ContainerImp>(name);
 #endif // USE_ROOT_STORAGE
       }
     } else if (form::technology::GetMajor(tech) == form::technology::HDF5_MAJOR) {
@@ -66,6 +87,10 @@ namespace form::detail::experimental {
       // Add HDF5 implementation when available
       // return std::make_shared<HDF5_Field_ContainerImp>(name);
 #endif // USE_HDF5_STORAGE
+    } else if (form::technology::GetMajor(tech) == form::technology::NATIVE_MAJOR) {
+      if (form::technology::GetMinor(tech) == form::technology::NATIVE_COLUMN_MINOR) {
+        return std::make_shared<Native_Column_ContainerImp>(name);
+      }
     }
 
     // Default fallback
@@ -24,7 +24,7 @@ namespace phlex::experimental {
     // bad.
     std::vector<std::function<detail::module_creator_t>> create_module;
     std::vector<std::function<detail::source_creator_t>> create_source;
-    std::function<detail::driver_creator_t> create_driver;
+    std::vector<std::function<detail::driver_creator_t>> create_driver;
 
     template <typename creator_t>
     std::function<creator_t> plugin_loader(std::string const& spec, std::string const& symbol_name)
@@ -92,16 +92,16 @@ namespace phlex::experimental {
 
   void load_source(framework_graph& g, std::string const& label, boost::json::object raw_config)
   {
-    auto const& spec = value_to<std::string>(raw_config.at("cpp"));
-    auto& creator =
-      create_source.emplace_back(plugin_loader<detail::source_creator_t>(spec, "create_source"));
-
     // FIXME: Should probably use the parameter name (e.g.) 'plugin_label' instead of
     //        'module_label', but that requires adjusting other parts of the system
     //        (e.g. make_algorithm_name).
-    raw_config["module_label"] = label;
+    auto const adjusted_config = detail::adjust_config(label, std::move(raw_config));
 
-    configuration const config{raw_config};
+    auto const& spec = value_to<std::string>(adjusted_config.at("cpp"));
+    auto& creator =
+      create_source.emplace_back(plugin_loader<detail::source_creator_t>(spec, "create_source"));
+
+    configuration const config{adjusted_config};
     creator(g.source_proxy(config), config);
   }
 
@@ -109,7 +109,24 @@ namespace phlex::experimental {
   {
     configuration const config{raw_config};
     auto const& spec = config.get<std::string>("cpp");
-    create_driver = plugin_loader<detail::driver_creator_t>(spec, "create_driver");
-    return create_driver(config);
+    auto& creator =
+      create_driver.emplace_back(plugin_loader<detail::driver_creator_t>(spec, "create_driver"));
+    return creator(config);
+  }
+
+  std::vector<detail::next_index_t> load_drivers(boost::json::value const& raw_config)
+  {
+    std::vector<detail::next_index_t> result;
+    if (auto const* driver_configs = raw_config.if_array()) {
+      if (driver_configs->empty()) {
+        throw std::runtime_error("The list of driver configurations is empty.");
+      }
+      for (auto const& driver_config : *driver_configs) {
+        result.push_back(load_driver(driver_config.as_object()));
+      }
+      return result;
+    }
+    result.push_back(load_driver(raw_config.as_object()));
+    return result;
   }
 }
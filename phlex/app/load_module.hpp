@@ -7,6 +7,7 @@
 #include "boost/json.hpp"
 
 #include <functional>
+#include <vector>
 
 namespace phlex::experimental {
   namespace detail {
@@ -18,6 +19,10 @@ namespace phlex::experimental {
   void load_module(framework_graph& g, std::string const& label, boost::json::object config);
   void load_source(framework_graph& g, std::string const& label, boost::json::object config);
   detail::next_index_t load_driver(boost::json::object const& config);
+
+  // The driver configuration may be a single object or an array of objects, in which case
+  // one driver per array element is created.  The drivers then run concurrently.
+  std::vector<detail::next_index_t> load_drivers(boost::json::value const& config);
 }
 
 #endif // PHLEX_APP_LOAD_MODULE_HPP
@@ -9,6 +9,7 @@
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <sstream>
 #include <string>
 
 using namespace std::string_literals;
@@ -25,6 +26,7 @@ int main(int argc, char* argv[])
 
   auto max_concurrency = oneapi::tbb::info::default_concurrency();
   std::string config_file;
+  std::string shard;
   // clang-format off
   desc.add_options()
     ("help,h", "Produce help message")
@@ -32,6 +34,14 @@ int main(int argc, char* argv[])
     ("parallel,j",
        bpo::value<int>()->default_value(max_concurrency),
        "Maximum parallelism requested for the program")
+    ("shard",
+       bpo::value<std::string>(&shard),
+       "Process only shard i of N shards of the top-level data cells (format: i/N)")
+    ("execution-report",
+       "Report the critical path, worker utilization, and serial bottlenecks of the job")
+    ("hardware-counters",
+       "Report the CPU cycles, instructions, cache misses, and branch misses of each node "
+       "(Linux only)")
     ("version", ("Print phlex version ("s + phlex::experimental::version() + ")").c_str());
   // clang-format on
 
@@ -92,6 +102,28 @@ int main(int argc, char* argv[])
   if (not vm["parallel"].defaulted()) {
     max_concurrency = vm["parallel"].as<int>();
   }
+
+  if (vm.count("shard")) {
+    std::size_t index{}, count{};
+    char separator{};
+    std::istringstream iss{shard};
+    if (not(iss >> index >> separator >> count) or separator != '/' or not iss.eof() or
+        count == 0 or index >= count) {
+      std::cerr << "Error: Invalid shard specification '" << shard
+                << "' (expected i/N with 0 <= i < N).\n";
+      return 2;
+    }
+    configurations["shard"] = {{"index", index}, {"count", count}};
+  }
+
+  if (vm.count("execution-report")) {
+    configurations["execution_report"] = true;
+  }
+
+  if (vm.count("hardware-counters")) {
+    configurations["hardware_counters"] = true;
+  }
+
   try {
     phlex::experimental::run(configurations, max_concurrency);
   } catch (std::exception const& e) {
@@ -6,6 +6,13 @@
 using namespace std::string_literals;
 
 namespace {
+  auto value_decorate_exception(boost::json::object const& obj, std::string const& key)
+  try {
+    return obj.at(key);
+  } catch (std::exception const& e) {
+    throw std::runtime_error("Error retrieving parameter '" + key + "':\n" + e.what());
+  }
+
   auto object_decorate_exception(boost::json::object const& obj, std::string const& key)
   try {
     return obj.at(key).as_object();
@@ -17,8 +24,24 @@ namespace {
 namespace phlex::experimental {
   void run(boost::json::object const& configurations, int const max_parallelism)
   {
-    auto const driver_config = object_decorate_exception(configurations, "driver");
-    framework_graph g{load_driver(driver_config), max_parallelism};
+    auto const driver_config = value_decorate_exception(configurations, "driver");
+    framework_graph g{load_drivers(driver_config), max_parallelism};
+
+    if (configurations.contains("shard")) {
+      auto const shard_config = object_decorate_exception(configurations, "shard");
+      g.restrict_to_shard({.index = value_to<std::size_t>(shard_config.at("index")),
+                           .count = value_to<std::size_t>(shard_config.at("count"))});
+    }
+
+    if (auto const* report = configurations.if_contains("execution_report");
+        report and report->as_bool()) {
+      g.enable_execution_report();
+    }
+
+    if (auto const* counters = configurations.if_contains("hardware_counters");
+        counters and counters->as_bool()) {
+      g.enable_hardware_counters();
+    }
 
     // It is allowed for users to not specify any modules
     boost::json::object module_configs;
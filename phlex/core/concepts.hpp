@@ -4,6 +4,7 @@
 #include "phlex/core/fwd.hpp"
 #include "phlex/metaprogramming/type_deduction.hpp"
 #include "phlex/model/fwd.hpp"
+#include "phlex/utilities/async_future.hpp"
 
 #include <concepts>
 #include <utility>
@@ -52,9 +53,15 @@ namespace phlex::experimental {
   template <typename T>
   concept is_observer_like = at_least_one_input_parameter<T> && returns<T, void>;
 
+  // An output function may instead receive shared ownership of the product store, which
+  // allows it to keep the products alive beyond the call (e.g. to write them asynchronously).
+  // An output that returns an async_future<void> is complete once the future is ready.
   template <typename T>
-  concept is_output_like = std::is_member_function_pointer_v<T> &&
-                           expects_input_parameters<T, product_store const&> && returns<T, void>;
+  concept is_output_like =
+    std::is_member_function_pointer_v<T> &&
+    (expects_input_parameters<T, product_store const&> ||
+     expects_input_parameters<T, product_store_const_ptr const&>) &&
+    (returns<T, void> || returns<T, async_future<void>>);
 
   template <typename T>
   concept is_provider_like =
@@ -71,6 +78,11 @@ namespace phlex::experimental {
 
   template <typename T>
   concept is_transform_like = at_least_one_input_parameter<T> && at_least_one_output_object<T>;
+
+  template <typename T>
+  concept is_async_transform_like = at_least_one_input_parameter<T> &&
+                                    is_future<return_type<T>>::value &&
+                                    not_void<future_value_t<return_type<T>>>;
 }
 
 #endif // PHLEX_CORE_CONCEPTS_HPP
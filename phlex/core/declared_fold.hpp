@@ -3,6 +3,7 @@
 
 #include "phlex/concurrency.hpp"
 #include "phlex/core/concepts.hpp"
+#include "phlex/core/execution_trace.hpp"
 #include "phlex/core/fold/send.hpp"
 #include "phlex/core/fwd.hpp"
 #include "phlex/core/input_arguments.hpp"
@@ -73,7 +74,8 @@ namespace phlex::experimental {
               std::string partition) :
       declared_fold{std::move(name), std::move(predicates), std::move(product_labels)},
       initializer_{std::move(initializer)},
-      output_{to_product_specifications(full_name(), std::move(output), make_type_ids<R>())},
+      output_{to_product_specifications(
+        full_name(), std::move(output), make_type_ids<sent_type_t<R>>())},
       partition_{std::move(partition)},
       join_{make_join_or_none(g, std::make_index_sequence<N>{})},
       fold_{g,
@@ -147,6 +149,7 @@ namespace phlex::experimental {
             .first;
       }
       ++calls_;
+      traced_invocation const trace{this, most_derived(messages).store->index()};
       return std::invoke(ft, *it->second, std::get<Is>(input_).retrieve(std::get<Is>(messages))...);
     }
 
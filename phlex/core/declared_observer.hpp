@@ -2,6 +2,7 @@
 #define PHLEX_CORE_DECLARED_OBSERVER_HPP
 
 #include "phlex/core/concepts.hpp"
+#include "phlex/core/execution_trace.hpp"
 #include "phlex/core/fwd.hpp"
 #include "phlex/core/input_arguments.hpp"
 #include "phlex/core/message.hpp"
@@ -112,6 +113,7 @@ namespace phlex::experimental {
     void call(function_t const& ft, messages_t<N> const& messages, std::index_sequence<Is...>)
     {
       ++calls_;
+      traced_invocation const trace{this, most_derived(messages).store->index()};
       return std::invoke(ft, std::get<Is>(input_).retrieve(std::get<Is>(messages))...);
     }
 
@@ -1,23 +1,148 @@
 #include "phlex/core/declared_output.hpp"
 #include "phlex/configuration.hpp"
 #include "phlex/core/detail/make_algorithm_name.hpp"
+#include "phlex/core/execution_trace.hpp"
+#include "phlex/utilities/async_future.hpp"
+
+#include <type_traits>
 
 namespace phlex::experimental {
+  namespace {
+    class output_node : public declared_output {
+    public:
+      output_node(algorithm_name name,
+                  std::size_t concurrency,
+                  std::vector<std::string> predicates,
+                  tbb::flow::graph& g,
+                  detail::output_function_t&& ft,
+                  std::function<void()> end_of_job) :
+        declared_output{std::move(name), std::move(predicates), std::move(end_of_job)},
+        node_{g, concurrency, [this, f = std::move(ft)](message const& msg) -> tbb::flow::continue_msg {
+                if (not msg.store->is_flush()) {
+                  traced_invocation const trace{this, msg.store->index()};
+                  f(msg.store);
+                  count_call();
+                }
+                return {};
+              }}
+      {
+      }
+
+      tbb::flow::receiver<message>& port() noexcept override { return node_; }
+
+    private:
+      tbb::flow::function_node<message> node_;
+    };
+
+    // Messages are buffered by the queue node until the limiter admits them; the limiter is
+    // decremented whenever a write has completed.  The output function is invoked on a TBB
+    // worker thread; the thread that completes the returned future hands it back to the
+    // graph, and any exception stored in it is rethrown on a TBB worker thread.
+    class async_output_node : public declared_output {
+      using result_t = std::shared_ptr<async_future<void>>; // Null for flush messages
+      using async_node_t = tbb::flow::async_node<message, result_t>;
+      using gateway_t = async_node_t::gateway_type;
+
+    public:
+      async_output_node(algorithm_name name,
+                        std::size_t concurrency,
+                        std::vector<std::string> predicates,
+                        tbb::flow::graph& g,
+                        detail::async_output_function_t&& ft,
+                        std::function<void()> end_of_job) :
+        declared_output{std::move(name), std::move(predicates), std::move(end_of_job)},
+        queue_{g},
+        limiter_{g, concurrency},
+        launch_{g,
+                tbb::flow::unlimited,
+                [this, &g, f = std::move(ft)](message const& msg, gateway_t& gateway) {
+                  if (msg.store->is_flush()) {
+                    gateway.try_put(nullptr);
+                    return;
+                  }
+                  auto result = [this, &f, &msg] {
+                    traced_invocation const trace{this, msg.store->index()};
+                    return std::make_shared<async_future<void>>(f(msg.store));
+                  }();
+                  count_call();
+                  // The store is captured so that the products remain alive until they have
+                  // been written.  The graph waits for the write even if this node has been
+                  // destroyed meanwhile.
+                  gateway.reserve_wait();
+                  auto put = scope_.guard([&gateway, result] { gateway.try_put(result); });
+                  result->on_ready([&g, put = std::move(put), store = msg.store]() mutable {
+                    put();
+                    g.release_wait();
+                  });
+                }},
+        complete_{g, tbb::flow::unlimited, [](result_t const& result) -> tbb::flow::continue_msg {
+                    if (result) {
+                      result->get();
+                    }
+                    return {};
+                  }}
+      {
+        make_edge(queue_, limiter_);
+        make_edge(limiter_, launch_);
+        make_edge(launch_, complete_);
+        make_edge(complete_, limiter_.decrementer());
+      }
+
+      ~async_output_node() { scope_.close(); }
+
+      tbb::flow::receiver<message>& port() noexcept override { return queue_; }
+
+    private:
+      async_scope scope_;
+      tbb::flow::queue_node<message> queue_;
+      tbb::flow::limiter_node<message> limiter_;
+      async_node_t launch_;
+      tbb::flow::function_node<result_t> complete_;
+    };
+  }
+
   declared_output::declared_output(algorithm_name name,
-                                   std::size_t concurrency,
                                    std::vector<std::string> predicates,
-                                   tbb::flow::graph& g,
-                                   detail::output_function_t&& ft) :
-    consumer{std::move(name), std::move(predicates)},
-    node_{g, concurrency, [this, f = std::move(ft)](message const& msg) -> tbb::flow::continue_msg {
-            if (not msg.store->is_flush()) {
-              f(*msg.store);
-              ++calls_;
-            }
-            return {};
-          }}
+                                   std::function<void()> end_of_job) :
+    consumer{std::move(name), std::move(predicates)}, end_of_job_{std::move(end_of_job)}
+  {
+  }
+
+  declared_output::~declared_output() = default;
+
+  void declared_output::end_job()
   {
+    if (end_of_job_) {
+      end_of_job_();
+    }
   }
 
-  tbb::flow::receiver<message>& declared_output::port() noexcept { return node_; }
+  declared_output_ptr make_declared_output(algorithm_name name,
+                                           std::size_t concurrency,
+                                           std::vector<std::string> predicates,
+                                           tbb::flow::graph& g,
+                                           detail::any_output_function_t&& ft,
+                                           std::function<void()> end_of_job)
+  {
+    return std::visit(
+      [&](auto&& f) -> declared_output_ptr {
+        using function_t = std::remove_cvref_t<decltype(f)>;
+        if constexpr (std::same_as<function_t, detail::output_function_t>) {
+          return std::make_unique<output_node>(std::move(name),
+                                               concurrency,
+                                               std::move(predicates),
+                                               g,
+                                               std::move(f),
+                                               std::move(end_of_job));
+        } else {
+          return std::make_unique<async_output_node>(std::move(name),
+                                                     concurrency,
+                                                     std::move(predicates),
+                                                     g,
+                                                     std::move(f),
+                                                     std::move(end_of_job));
+        }
+      },
+      std::move(ft));
+  }
 }
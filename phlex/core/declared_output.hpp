@@ -6,38 +6,77 @@
 #include "phlex/core/message.hpp"
 #include "phlex/model/algorithm_name.hpp"
 #include "phlex/model/product_store.hpp"
+#include "phlex/utilities/async_future.hpp"
 #include "phlex/utilities/simple_ptr_map.hpp"
 
 #include "oneapi/tbb/flow_graph.h"
 
+#include <atomic>
 #include <cstddef>
 #include <functional>
 #include <memory>
 #include <string>
+#include <utility>
+#include <variant>
 #include <vector>
 
 namespace phlex::experimental {
   namespace detail {
-    using output_function_t = std::function<void(product_store const&)>;
+    using output_function_t = std::function<void(product_store_const_ptr const&)>;
+    using async_output_function_t =
+      std::function<async_future<void>(product_store_const_ptr const&)>;
+    using any_output_function_t = std::variant<output_function_t, async_output_function_t>;
+
+    inline output_function_t make_output_function(std::function<void(product_store const&)> f)
+    {
+      return [f = std::move(f)](product_store_const_ptr const& store) { f(*store); };
+    }
+    inline output_function_t make_output_function(output_function_t f) { return f; }
+
+    inline async_output_function_t make_output_function(
+      std::function<async_future<void>(product_store const&)> f)
+    {
+      return [f = std::move(f)](product_store_const_ptr const& store) { return f(*store); };
+    }
+    inline async_output_function_t make_output_function(async_output_function_t f) { return f; }
   }
+
+  // =====================================================================================
+  // An output is either invoked synchronously, or it returns an async_future<void> that
+  // becomes ready once the products have been written.  In the latter case, the
+  // registered concurrency bounds the number of writes in flight: further messages wait in
+  // the graph (not on a worker thread) until one of the writes has completed.
+
   class declared_output : public consumer {
   public:
     declared_output(algorithm_name name,
-                    std::size_t concurrency,
                     std::vector<std::string> predicates,
-                    tbb::flow::graph& g,
-                    detail::output_function_t&& ft);
+                    std::function<void()> end_of_job);
+    virtual ~declared_output();
 
-    tbb::flow::receiver<message>& port() noexcept;
+    virtual tbb::flow::receiver<message>& port() noexcept = 0;
     std::size_t num_calls() const { return calls_; }
 
+    // Called once the graph has processed all data cells
+    void end_job();
+
+  protected:
+    void count_call() noexcept { ++calls_; }
+
   private:
-    tbb::flow::function_node<message> node_;
+    std::function<void()> end_of_job_;
     std::atomic<std::size_t> calls_;
   };
 
   using declared_output_ptr = std::unique_ptr<declared_output>;
   using declared_outputs = simple_ptr_map<declared_output_ptr>;
+
+  declared_output_ptr make_declared_output(algorithm_name name,
+                                           std::size_t concurrency,
+                                           std::vector<std::string> predicates,
+                                           tbb::flow::graph& g,
+                                           detail::any_output_function_t&& ft,
+                                           std::function<void()> end_of_job);
 }
 
 #endif // PHLEX_CORE_DECLARED_OUTPUT_HPP
@@ -3,6 +3,7 @@
 
 #include "phlex/core/concepts.hpp"
 #include "phlex/core/detail/filter_impl.hpp"
+#include "phlex/core/execution_trace.hpp"
 #include "phlex/core/fwd.hpp"
 #include "phlex/core/input_arguments.hpp"
 #include "phlex/core/message.hpp"
@@ -115,6 +116,7 @@ namespace phlex::experimental {
     bool call(function_t const& ft, messages_t<N> const& messages, std::index_sequence<Is...>)
     {
       ++calls_;
+      traced_invocation const trace{this, most_derived(messages).store->index()};
       return std::invoke(ft, std::get<Is>(input_).retrieve(std::get<Is>(messages))...);
     }
 
@@ -2,6 +2,7 @@
 #define PHLEX_CORE_DECLARED_PROVIDER_HPP
 
 #include "phlex/core/concepts.hpp"
+#include "phlex/core/execution_trace.hpp"
 #include "phlex/core/fwd.hpp"
 #include "phlex/core/message.hpp"
 #include "phlex/core/store_counters.hpp"
@@ -87,7 +88,10 @@ namespace phlex::experimental {
             }
 
             // Cache miss - compute the result
-            auto result = std::invoke(ft, *msg.store->index());
+            auto result = [&] {
+              traced_invocation const trace{this, msg.store->index()};
+              return std::invoke(ft, *msg.store->index());
+            }();
             ++calls_;
 
             products new_products;
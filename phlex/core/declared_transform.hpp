@@ -5,6 +5,7 @@
 //        of the process a given section of code is addressing.
 
 #include "phlex/core/concepts.hpp"
+#include "phlex/core/execution_trace.hpp"
 #include "phlex/core/fwd.hpp"
 #include "phlex/core/input_arguments.hpp"
 #include "phlex/core/message.hpp"
@@ -17,6 +18,7 @@
 #include "phlex/model/handle.hpp"
 #include "phlex/model/product_specification.hpp"
 #include "phlex/model/product_store.hpp"
+#include "phlex/utilities/async_future.hpp"
 #include "phlex/utilities/simple_ptr_map.hpp"
 
 #include "oneapi/tbb/concurrent_hash_map.h"
@@ -34,6 +36,7 @@
 #include <string>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 namespace phlex::experimental {
 
@@ -140,6 +143,7 @@ namespace phlex::experimental {
     template <std::size_t... Is>
     auto call(function_t const& ft, messages_t<N> const& messages, std::index_sequence<Is...>)
     {
+      traced_invocation const trace{this, most_derived(messages).store->index()};
       return std::invoke(ft, std::get<Is>(input_).retrieve(std::get<Is>(messages))...);
     }
 
@@ -162,6 +166,181 @@ namespace phlex::experimental {
     tbb::concurrent_unordered_map<std::size_t, std::atomic<std::size_t>> product_count_;
   };
 
+  // =====================================================================================
+  // An asynchronous transform is registered with an algorithm that returns an
+  // async_future.  The algorithm is invoked on a TBB worker thread, which is released as
+  // soon as the future has been created.  The thread that completes the future hands it
+  // back to the graph through the gateway of a tbb::flow::async_node, so no thread waits
+  // for it.  The data products are then created on a TBB worker thread, where any
+  // exception stored in the future is rethrown.
+
+  template <typename AlgorithmBits>
+  class async_transform_node : public declared_transform, private detect_flush_flag {
+    using function_t = typename AlgorithmBits::bound_type;
+    using input_parameter_types = typename AlgorithmBits::input_parameter_types;
+    using future_t = return_type<function_t>;
+    using result_t = future_value_t<future_t>;
+
+    static constexpr auto N = AlgorithmBits::number_inputs;
+    static constexpr auto M = number_types<result_t>;
+
+    struct completion {
+      message msg;
+      std::shared_ptr<future_t> result; // Null for flush messages and cached stores
+    };
+
+    using async_node_t = tbb::flow::async_node<messages_t<N>, completion>;
+    using gateway_t = typename async_node_t::gateway_type;
+    using waiting_ids_t =
+      tbb::concurrent_hash_map<data_cell_index::hash_type, std::vector<std::size_t>>;
+
+  public:
+    using node_ptr_type = declared_transform_ptr;
+    static constexpr auto number_output_products = M;
+
+    async_transform_node(algorithm_name name,
+                         std::size_t concurrency,
+                         std::vector<std::string> predicates,
+                         tbb::flow::graph& g,
+                         AlgorithmBits alg,
+                         product_queries input_products,
+                         std::vector<std::string> output) :
+      declared_transform{std::move(name), std::move(predicates), std::move(input_products)},
+      output_{to_product_specifications(
+        full_name(), std::move(output), make_type_ids<result_t>())},
+      join_{make_join_or_none(g, std::make_index_sequence<N>{})},
+      launch_{g,
+              concurrency,
+              [this, &g, ft = alg.release_algorithm()](messages_t<N> const& messages,
+                                                       gateway_t& gateway) {
+                auto const& msg = most_derived(messages);
+                auto const& store = msg.store;
+                if (store->is_flush()) {
+                  mark_flush_received(store->index()->hash(), msg.original_id);
+                  gateway.try_put({msg, nullptr});
+                  return;
+                }
+
+                accessor a;
+                if (stores_.insert(a, store->index()->hash())) {
+                  auto result =
+                    std::make_shared<future_t>(call(ft, messages, std::make_index_sequence<N>{}));
+                  ++calls_;
+                  // The messages are captured so that the input data products remain alive
+                  // until the asynchronous work has completed.  The graph waits for the work
+                  // even if this node has been destroyed meanwhile.
+                  gateway.reserve_wait();
+                  auto put =
+                    scope_.guard([&gateway, msg, result] { gateway.try_put({msg, result}); });
+                  result->on_ready([&g, put = std::move(put), messages]() mutable {
+                    put();
+                    g.release_wait();
+                  });
+                } else if (a->second) {
+                  gateway.try_put({{a->second, msg.id}, nullptr});
+                } else {
+                  // The products for this data cell are still being created; the message
+                  // is forwarded once they are available.
+                  waiting_ids_t::accessor wa;
+                  waiting_ids_.insert(wa, store->index()->hash());
+                  wa->second.push_back(msg.id);
+                }
+              }},
+      dispatch_{g,
+                tbb::flow::unlimited,
+                [this](completion const& c, auto& output) {
+                  auto const& [msg, result] = c;
+                  auto const& store = msg.store;
+                  auto& [stay_in_graph, to_output] = output;
+                  if (store->is_flush()) {
+                    stay_in_graph.try_put(msg);
+                    to_output.try_put(msg);
+                  } else if (not result) {
+                    stay_in_graph.try_put(msg);
+                  } else {
+                    products new_products;
+                    new_products.add_all(output_, result->get());
+                    ++product_count_[store->index()->layer_hash()];
+                    auto new_store = std::make_shared<product_store>(
+                      store->index(), this->full_name(), std::move(new_products));
+
+                    std::vector<std::size_t> waiting_ids;
+                    {
+                      accessor a;
+                      stores_.find(a, store->index()->hash());
+                      a->second = new_store;
+                      if (waiting_ids_t::accessor wa;
+                          waiting_ids_.find(wa, store->index()->hash())) {
+                        waiting_ids = std::move(wa->second);
+                        waiting_ids_.erase(wa);
+                      }
+                    }
+
+                    message const new_msg{new_store, msg.id};
+                    stay_in_graph.try_put(new_msg);
+                    to_output.try_put(new_msg);
+                    for (auto const id : waiting_ids) {
+                      stay_in_graph.try_put({new_store, id});
+                    }
+                    mark_processed(store->index()->hash());
+                  }
+
+                  if (done_with(store)) {
+                    stores_.erase(store->index()->hash());
+                  }
+                }}
+    {
+      make_edge(join_, launch_);
+      make_edge(launch_, dispatch_);
+    }
+
+    ~async_transform_node()
+    {
+      scope_.close();
+      report_cached_stores(stores_);
+    }
+
+  private:
+    tbb::flow::receiver<message>& port_for(product_query const& product_label) override
+    {
+      return receiver_for<N>(join_, input(), product_label);
+    }
+
+    std::vector<tbb::flow::receiver<message>*> ports() override { return input_ports<N>(join_); }
+
+    tbb::flow::sender<message>& sender() override { return output_port<0>(dispatch_); }
+    tbb::flow::sender<message>& to_output() override { return output_port<1>(dispatch_); }
+    product_specifications const& output() const override { return output_; }
+
+    template <std::size_t... Is>
+    auto call(function_t const& ft, messages_t<N> const& messages, std::index_sequence<Is...>)
+    {
+      traced_invocation const trace{this, most_derived(messages).store->index()};
+      return std::invoke(ft, std::get<Is>(input_).retrieve(std::get<Is>(messages))...);
+    }
+
+    std::size_t num_calls() const final { return calls_.load(); }
+    std::size_t product_count() const final
+    {
+      std::size_t result{};
+      for (auto const& count : product_count_ | std::views::values) {
+        result += count.load();
+      }
+      return result;
+    }
+
+    input_retriever_types<input_parameter_types> input_{input_arguments<input_parameter_types>()};
+    product_specifications output_;
+    join_or_none_t<N> join_;
+    async_scope scope_;
+    async_node_t launch_;
+    tbb::flow::multifunction_node<completion, messages_t<2u>> dispatch_;
+    stores_t stores_;
+    waiting_ids_t waiting_ids_;
+    std::atomic<std::size_t> calls_;
+    tbb::concurrent_unordered_map<std::size_t, std::atomic<std::size_t>> product_count_;
+  };
+
 }
 
 #endif // PHLEX_CORE_DECLARED_TRANSFORM_HPP
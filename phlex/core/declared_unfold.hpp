@@ -2,6 +2,7 @@
 #define PHLEX_CORE_DECLARED_UNFOLD_HPP
 
 #include "phlex/core/concepts.hpp"
+#include "phlex/core/execution_trace.hpp"
 #include "phlex/core/fwd.hpp"
 #include "phlex/core/input_arguments.hpp"
 #include "phlex/core/message.hpp"
@@ -150,6 +151,7 @@ namespace phlex::experimental {
               std::index_sequence<Is...>)
     {
       ++calls_;
+      traced_invocation const trace{this, unfolded_id};
       Object obj(std::get<Is>(input_).retrieve(std::get<Is>(messages))...);
       std::size_t counter = 0;
       auto running_value = obj.initial_value();
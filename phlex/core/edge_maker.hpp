@@ -33,8 +33,7 @@ namespace phlex::experimental {
     edge_maker(Args&... args);
 
     template <typename... Args>
-    void operator()(tbb::flow::input_node<message>& source,
-                    multiplexer& multi,
+    void operator()(multiplexer& multi,
                     std::map<std::string, filter>& filters,
                     declared_outputs& outputs,
                     declared_providers& providers,
@@ -80,15 +79,12 @@ namespace phlex::experimental {
   }
 
   template <typename... Args>
-  void edge_maker::operator()(tbb::flow::input_node<message>& source,
-                              multiplexer& multi,
+  void edge_maker::operator()(multiplexer& multi,
                               std::map<std::string, filter>& filters,
                               declared_outputs& outputs,
                               declared_providers& providers,
                               Args&... consumers)
   {
-    make_edge(source, multi);
-
     // Create edges to outputs
     for (auto const& [output_name, output_node] : outputs) {
       for (auto& [_, provider] : providers) {
@@ -0,0 +1,421 @@
+#include "phlex/core/execution_trace.hpp"
+#include "phlex/model/data_cell_index.hpp"
+#include "phlex/utilities/hashing.hpp"
+
+#include "fmt/format.h"
+#include "spdlog/spdlog.h"
+
+#include <algorithm>
+#include <atomic>
+#include <ranges>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+
+using namespace std::chrono;
+
+namespace phlex::experimental {
+  namespace {
+    std::atomic<execution_trace*> active_trace{nullptr};
+
+    constexpr std::size_t time_intervals{10};
+    constexpr std::size_t reported_nodes{5};
+    // A node, the critical path, or the worker threads are considered to limit the job when
+    // they account for at least this fraction of its real time.
+    constexpr double limiting_fraction{0.8};
+
+    double seconds(execution_trace::clock::duration const d) noexcept
+    {
+      return duration<double>(d).count();
+    }
+
+    struct cell_key {
+      std::size_t node;
+      std::size_t cell;
+      bool operator==(cell_key const&) const = default;
+    };
+
+    struct cell_key_hash {
+      std::size_t operator()(cell_key const& key) const { return hash(key.node, key.cell); }
+    };
+
+    template <typename Map, typename Key>
+    void keep_latest(Map& map, Key const& key, std::size_t const i, auto const& entries)
+    {
+      auto [it, inserted] = map.try_emplace(key, i);
+      if (not inserted and entries[it->second].finish < entries[i].finish) {
+        it->second = i;
+      }
+    }
+
+    std::size_t peak_concurrency(std::vector<std::pair<double, int>>& transitions)
+    {
+      // Finishes (-1) sort before starts (+1) at the same time
+      std::ranges::sort(transitions);
+      int current{};
+      int peak{};
+      for (auto const& [_, change] : transitions) {
+        current += change;
+        peak = std::max(peak, current);
+      }
+      return static_cast<std::size_t>(peak);
+    }
+
+    std::string verdict_for(execution_summary const& summary)
+    {
+      auto const serial = std::ranges::find_if(
+        summary.nodes, [](auto const& node) { return node.peak_concurrency == 1ull; });
+      if (summary.threads > 1ull and serial != summary.nodes.end() and
+          serial->occupancy >= limiting_fraction) {
+        auto const busy = serial->occupancy * 100.;
+        if (serial->kind == "driver") {
+          return fmt::format(
+            "limited by the driver, which is busy for {:.0f}% of the real time", busy);
+        }
+        if (serial->kind == "output") {
+          return fmt::format(
+            "limited by the output '{}', which is busy for {:.0f}% of the real time",
+            serial->name,
+            busy);
+        }
+        return fmt::format(
+          "limited by the serial node '{}', which is busy for {:.0f}% of the real time",
+          serial->name,
+          busy);
+      }
+      if (summary.real_time > 0. and
+          summary.critical_path_time / summary.real_time >= limiting_fraction) {
+        return fmt::format("limited by the critical path, which spans {:.0f}% of the real time",
+                           summary.critical_path_time / summary.real_time * 100.);
+      }
+      if (summary.utilization >= limiting_fraction) {
+        return fmt::format("limited by the number of worker threads ({})", summary.threads);
+      }
+      return fmt::format("limited by a lack of parallelism: the worker threads are idle for "
+                         "{:.0f}% of the real time",
+                         (1. - summary.utilization) * 100.);
+    }
+  }
+
+  void execution_trace::add_node(void const* key, node_info info)
+  {
+    nodes_.insert_or_assign(key, std::move(info));
+  }
+
+  void execution_trace::activate()
+  {
+    begin_ = clock::now();
+    end_ = begin_;
+    active_trace = this;
+  }
+
+  void execution_trace::deactivate()
+  {
+    auto* expected = this;
+    if (active_trace.compare_exchange_strong(expected, nullptr)) {
+      end_ = clock::now();
+    }
+  }
+
+  execution_trace* execution_trace::active() noexcept
+  {
+    return active_trace.load(std::memory_order_relaxed);
+  }
+
+  void execution_trace::record(void const* node,
+                               data_cell_index_ptr index,
+                               clock::time_point const start,
+                               clock::time_point const finish)
+  {
+    invocations_.local().push_back({node, std::move(index), start, finish});
+  }
+
+  execution_summary execution_trace::summarize(std::size_t const threads) const
+  {
+    std::vector<node_info const*> infos;
+    std::unordered_map<void const*, std::size_t> node_ids;
+    std::unordered_map<std::string, std::size_t> ids_by_name;
+    for (auto const& [key, info] : nodes_) {
+      node_ids.emplace(key, infos.size());
+      ids_by_name.emplace(info.name, infos.size());
+      infos.push_back(&info);
+    }
+
+    std::vector<std::vector<std::size_t>> upstream(infos.size());
+    for (std::size_t i = 0; i != infos.size(); ++i) {
+      for (auto const& name : infos[i]->upstream) {
+        if (auto it = ids_by_name.find(name); it != ids_by_name.end()) {
+          upstream[i].push_back(it->second);
+        }
+      }
+    }
+
+    struct entry {
+      std::size_t node;
+      data_cell_index const* index;
+      double start;
+      double finish;
+    };
+
+    std::vector<entry> entries;
+    for (auto const& local : invocations_) {
+      for (auto const& inv : local) {
+        auto it = node_ids.find(inv.node);
+        if (it == node_ids.end() or not inv.index) {
+          continue;
+        }
+        entries.push_back(
+          {it->second, inv.index.get(), seconds(inv.start - begin_), seconds(inv.finish - begin_)});
+      }
+    }
+    std::ranges::sort(entries, [](entry const& a, entry const& b) {
+      return std::tie(a.start, a.finish) < std::tie(b.start, b.finish);
+    });
+
+    execution_summary summary{};
+    summary.threads = threads;
+    summary.invocations = entries.size();
+    summary.real_time = seconds(end_ - begin_);
+    for (auto const& e : entries) {
+      summary.real_time = std::max(summary.real_time, e.finish);
+    }
+
+    // The earliest finish of each invocation is its duration plus the latest earliest finish
+    // of the invocations it depends on.  An invocation depends on
+    //   - the invocation that emitted its data cell (a driver or an unfold),
+    //   - the invocations of its upstream nodes for the same data cell, for an enclosing data
+    //     cell, or (for folds) for the data cells the fold result is accumulated from, and
+    //   - for a driver, its previous invocation.
+    // Because the invocations are visited in order of their start times, only invocations
+    // that started before a given invocation are available as its dependencies.
+    using cell_map = std::unordered_map<cell_key, std::size_t, cell_key_hash>;
+    cell_map at_cell;
+    cell_map below_cell;
+    std::unordered_map<std::size_t, std::size_t> emitted;
+    std::unordered_map<std::size_t, std::size_t> unfolded;
+    std::unordered_map<std::size_t, std::size_t> previous_driver_call;
+
+    std::size_t const none = entries.size();
+    std::vector<double> earliest_finish(entries.size());
+    std::vector<std::size_t> predecessor(entries.size(), none);
+
+    for (std::size_t i = 0; i != entries.size(); ++i) {
+      auto const& e = entries[i];
+      auto const& kind = infos[e.node]->kind;
+      auto const cell = e.index->hash();
+
+      double latest{};
+      auto consider = [&](std::size_t const d) {
+        // A dependency that is still running (e.g. an unfold emitting data cells) gates
+        // the invocation only up to the invocation's start.
+        auto const finish = earliest_finish[d] - std::max(0., entries[d].finish - e.start);
+        if (finish > latest) {
+          latest = finish;
+          predecessor[i] = d;
+        }
+      };
+
+      if (auto it = emitted.find(cell); it != emitted.end()) {
+        consider(it->second);
+      } else if (auto const parent = e.index->parent()) {
+        if (auto it = unfolded.find(parent->hash()); it != unfolded.end()) {
+          consider(it->second);
+        }
+      }
+
+      if (kind == "driver") {
+        if (auto it = previous_driver_call.find(e.node); it != previous_driver_call.end()) {
+          consider(it->second);
+        }
+      }
+
+      for (auto const u : upstream[e.node]) {
+        if (auto it = at_cell.find({u, cell}); it != at_cell.end()) {
+          consider(it->second);
+        } else if (auto it = below_cell.find({u, cell}); it != below_cell.end()) {
+          consider(it->second);
+        } else {
+          for (auto a = e.index->parent(); a; a = a->parent()) {
+            if (auto it = at_cell.find({u, a->hash()}); it != at_cell.end()) {
+              consider(it->second);
+              break;
+            }
+          }
+        }
+      }
+
+      earliest_finish[i] = latest + (e.finish - e.start);
+
+      keep_latest(at_cell, cell_key{e.node, cell}, i, entries);
+      if (kind == "driver") {
+        emitted.insert_or_assign(cell, i);
+        previous_driver_call.insert_or_assign(e.node, i);
+      } else if (kind == "unfold") {
+        keep_latest(unfolded, cell, i, entries);
+      } else if (kind == "fold") {
+        for (auto a = e.index->parent(); a; a = a->parent()) {
+          keep_latest(below_cell, cell_key{e.node, a->hash()}, i, entries);
+        }
+      }
+    }
+
+    // Per-node usage
+    std::vector<execution_summary::node_usage> usage(infos.size());
+    std::vector<std::vector<std::pair<double, int>>> transitions(infos.size());
+    summary.utilization_over_time.assign(time_intervals, 0.);
+    auto const interval = summary.real_time / time_intervals;
+    for (auto const& e : entries) {
+      auto& u = usage[e.node];
+      ++u.invocations;
+      u.busy_time += e.finish - e.start;
+      summary.busy_time += e.finish - e.start;
+      transitions[e.node].emplace_back(e.start, +1);
+      transitions[e.node].emplace_back(e.finish, -1);
+
+      if (interval <= 0.) {
+        continue;
+      }
+      auto const first = std::min(static_cast<std::size_t>(e.start / interval), time_intervals - 1);
+      for (auto b = first; b != time_intervals; ++b) {
+        auto const lo = std::max(e.start, b * interval);
+        auto const hi = std::min(e.finish, (b + 1) * interval);
+        if (hi <= lo) {
+          break;
+        }
+        summary.utilization_over_time[b] += hi - lo;
+      }
+    }
+
+    if (summary.real_time > 0. and threads > 0ull) {
+      summary.utilization = summary.busy_time / (summary.real_time * threads);
+      for (auto& busy : summary.utilization_over_time) {
+        busy /= interval * threads;
+      }
+    }
+
+    // Critical path
+    if (not entries.empty()) {
+      auto const last = std::ranges::max_element(earliest_finish) - earliest_finish.begin();
+      summary.critical_path_time = earliest_finish[last];
+      for (auto i = static_cast<std::size_t>(last); i != none; i = predecessor[i]) {
+        ++summary.critical_path_length;
+        usage[entries[i].node].critical_time += entries[i].finish - entries[i].start;
+      }
+    }
+
+    for (std::size_t i = 0; i != infos.size(); ++i) {
+      auto& u = usage[i];
+      if (u.invocations == 0ull) {
+        continue;
+      }
+      u.name = infos[i]->name;
+      u.kind = infos[i]->kind;
+      u.occupancy = summary.real_time > 0. ? u.busy_time / summary.real_time : 0.;
+      u.peak_concurrency = peak_concurrency(transitions[i]);
+      summary.nodes.push_back(std::move(u));
+    }
+    std::ranges::sort(
+      summary.nodes, std::ranges::greater{}, &execution_summary::node_usage::occupancy);
+
+    summary.verdict = verdict_for(summary);
+    return summary;
+  }
+
+  void report_execution(execution_summary const& summary)
+  {
+    spdlog::info("Execution report: {} invocations over {:.5f}s real time",
+                 summary.invocations,
+                 summary.real_time);
+    spdlog::info("  Worker utilization: {:.2f}% of {} threads ({:.5f}s busy)",
+                 summary.utilization * 100.,
+                 summary.threads,
+                 summary.busy_time);
+
+    std::string over_time;
+    for (auto const busy : summary.utilization_over_time) {
+      over_time += fmt::format(" {:3.0f}%", busy * 100.);
+    }
+    spdlog::info("  Utilization over time:{}", over_time);
+
+    spdlog::info("  Critical path: {:.5f}s ({:.2f}% of real time) through {} invocations",
+                 summary.critical_path_time,
+                 summary.real_time > 0. ? summary.critical_path_time / summary.real_time * 100.
+                                        : 0.,
+                 summary.critical_path_length);
+
+    spdlog::info("  {:<40} {:>10} {:>10} {:>12} {:>10} {:>6} {:>14}",
+                 "Busiest nodes",
+                 "Kind",
+                 "Calls",
+                 "Busy time",
+                 "Occupancy",
+                 "Peak",
+                 "Critical path");
+    for (auto const& node : summary.nodes | std::views::take(reported_nodes)) {
+      spdlog::info("  {:<40} {:>10} {:>10} {:>11.5f}s {:>9.2f}% {:>6} {:>13.5f}s",
+                   node.name,
+                   node.kind,
+                   node.invocations,
+                   node.busy_time,
+                   node.occupancy * 100.,
+                   node.peak_concurrency,
+                   node.critical_time);
+    }
+    spdlog::info("  Verdict: {}", summary.verdict);
+  }
+
+  traced_invocation::traced_invocation(consumer const* node,
+                                       data_cell_index_ptr const& index) noexcept :
+    traced_invocation{node_key(node), &index}
+  {
+  }
+
+  traced_invocation::traced_invocation(declared_provider const* node,
+                                       data_cell_index_ptr const& index) noexcept :
+    traced_invocation{node_key(node), &index}
+  {
+  }
+
+  traced_invocation::traced_invocation(driver_stream const* node) noexcept :
+    traced_invocation{node_key(node), nullptr}
+  {
+  }
+
+  traced_invocation::traced_invocation(void const* node, data_cell_index_ptr const* index) noexcept
+    : trace_{execution_trace::active()}, counters_{hardware_counters::active()}
+  {
+    if (not trace_ and not counters_) {
+      return;
+    }
+    node_ = node;
+    if (trace_) {
+      if (index) {
+        index_ = *index;
+      }
+      start_ = execution_trace::clock::now();
+    }
+    // The counters are read last so that as little as possible of the bookkeeping is counted
+    if (counters_ and not hardware_counters::read(start_counts_)) {
+      counters_ = nullptr;
+    }
+  }
+
+  traced_invocation::~traced_invocation()
+  {
+    if (counters_) {
+      if (hardware_event_counts end_counts; hardware_counters::read(end_counts)) {
+        counters_->record(node_, start_counts_, end_counts);
+      }
+    }
+    if (trace_ and index_) {
+      trace_->record(node_, std::move(index_), start_, execution_trace::clock::now());
+    }
+  }
+
+  void traced_invocation::set_index(data_cell_index_ptr const& index)
+  {
+    if (trace_) {
+      index_ = index;
+    }
+  }
+}
@@ -0,0 +1,134 @@
+#ifndef PHLEX_CORE_EXECUTION_TRACE_HPP
+#define PHLEX_CORE_EXECUTION_TRACE_HPP
+
+// =======================================================================================
+// The execution_trace class records when each node of a framework graph starts and
+// finishes processing a data cell.  At the end of the job, the recorded invocations are
+// analyzed to determine:
+//
+//   - the critical path through the data-cell DAG, i.e. the longest chain of invocations
+//     that depend on each other's results, which bounds the real time of the job no matter
+//     how many threads are available;
+//   - the utilization of the worker threads over the course of the job; and
+//   - the nodes that are busy for the largest fraction of the job while never running
+//     more than one invocation at a time (the serial bottlenecks).
+//
+// A trace is recorded only while it is active (see framework_graph::enable_execution_report).
+// Otherwise, a traced_invocation costs only the checks for an active trace and for active
+// hardware counters.
+// =======================================================================================
+
+#include "phlex/core/hardware_counters.hpp"
+#include "phlex/model/fwd.hpp"
+
+#include "oneapi/tbb/enumerable_thread_specific.h"
+
+#include <chrono>
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace phlex::experimental {
+  class consumer;
+  class declared_provider;
+  class driver_stream;
+
+  // Nodes are identified by the address of the base-class subobject through which the
+  // framework graph refers to them.
+  inline void const* node_key(consumer const* node) noexcept { return node; }
+  inline void const* node_key(declared_provider const* node) noexcept { return node; }
+  inline void const* node_key(driver_stream const* node) noexcept { return node; }
+
+  struct execution_summary {
+    struct node_usage {
+      std::string name;
+      std::string kind;
+      std::size_t invocations{};
+      double busy_time{};     // Summed over all invocations, in seconds
+      double occupancy{};     // Busy time divided by the real time of the job
+      std::size_t peak_concurrency{};
+      double critical_time{}; // Time spent by the node on the critical path, in seconds
+    };
+
+    std::size_t threads{};
+    std::size_t invocations{};
+    double real_time{};
+    double busy_time{};
+    double utilization{};
+    std::vector<double> utilization_over_time;
+    double critical_path_time{};
+    std::size_t critical_path_length{};
+    std::vector<node_usage> nodes; // Sorted by decreasing occupancy
+    std::string verdict;
+  };
+
+  class execution_trace {
+  public:
+    using clock = std::chrono::steady_clock;
+
+    struct node_info {
+      std::string name;
+      std::string kind;
+      std::vector<std::string> upstream; // Nodes whose results must precede an invocation
+    };
+
+    void add_node(void const* key, node_info info);
+
+    void activate();
+    void deactivate();
+    static execution_trace* active() noexcept;
+
+    void record(void const* node,
+                data_cell_index_ptr index,
+                clock::time_point start,
+                clock::time_point finish);
+
+    execution_summary summarize(std::size_t threads) const;
+
+  private:
+    struct invocation {
+      void const* node;
+      data_cell_index_ptr index;
+      clock::time_point start;
+      clock::time_point finish;
+    };
+
+    std::map<void const*, node_info> nodes_;
+    tbb::enumerable_thread_specific<std::vector<invocation>> invocations_;
+    clock::time_point begin_;
+    clock::time_point end_;
+  };
+
+  void report_execution(execution_summary const& summary);
+
+  // A traced_invocation records the time between its construction and its destruction as
+  // an invocation of the given node for the given data cell, if a trace is active.  If
+  // hardware counters are active, the events counted by the calling thread in that time
+  // are attributed to the node.
+  class traced_invocation {
+  public:
+    traced_invocation(consumer const* node, data_cell_index_ptr const& index) noexcept;
+    traced_invocation(declared_provider const* node, data_cell_index_ptr const& index) noexcept;
+    explicit traced_invocation(driver_stream const* node) noexcept;
+    ~traced_invocation();
+
+    traced_invocation(traced_invocation const&) = delete;
+    traced_invocation& operator=(traced_invocation const&) = delete;
+
+    // For invocations (like those of a driver) that learn their data cell only once done
+    void set_index(data_cell_index_ptr const& index);
+
+  private:
+    traced_invocation(void const* node, data_cell_index_ptr const* index) noexcept;
+
+    execution_trace* trace_;
+    hardware_counters* counters_;
+    void const* node_{nullptr};
+    data_cell_index_ptr index_{};
+    execution_trace::clock::time_point start_{};
+    hardware_event_counts start_counts_{};
+  };
+}
+
+#endif // PHLEX_CORE_EXECUTION_TRACE_HPP
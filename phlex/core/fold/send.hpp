@@ -13,6 +13,8 @@
 
 #include <atomic>
 #include <concepts>
+#include <type_traits>
+#include <utility>
 
 namespace phlex::experimental {
   template <typename T>
@@ -20,6 +22,21 @@ namespace phlex::experimental {
   {
     return a.load();
   }
+
+  // The type of the data product made from a fold result of type T
+  template <typename T>
+  struct sent_type {
+    using type = T;
+  };
+
+  template <typename T>
+    requires requires(T const& t) { send(t); }
+  struct sent_type<T> {
+    using type = std::decay_t<decltype(send(std::declval<T const&>()))>;
+  };
+
+  template <typename T>
+  using sent_type_t = typename sent_type<T>::type;
 }
 
 #endif // PHLEX_CORE_FOLD_SEND_HPP
@@ -11,6 +11,8 @@
 
 #include <cassert>
 #include <iostream>
+#include <ranges>
+#include <stdexcept>
 
 namespace phlex::experimental {
   layer_sentry::layer_sentry(flush_counters& counters,
@@ -37,50 +39,133 @@ namespace phlex::experimental {
 
   std::size_t layer_sentry::depth() const noexcept { return depth_; }
 
+  driver_stream::driver_stream(tbb::flow::graph& g,
+                               detail::next_index_t next_index,
+                               message_sender& sender,
+                               std::atomic_flag& job_sent) :
+    driver_{std::move(next_index)},
+    sender_{sender},
+    job_sent_{job_sent},
+    src_{g, [this](tbb::flow_control& fc) mutable -> message {
+           while (true) {
+             auto item = [this] {
+               traced_invocation trace{this};
+               auto item = driver_();
+               if (item) {
+                 trace.set_index(*item);
+               }
+               return item;
+             }();
+             if (not item) {
+               drain();
+               if (not saw_job_) {
+                 sender_.stream_without_job();
+               }
+               fc.stop();
+               return {};
+             }
+             auto index = *item;
+             if (shard_.count > 1ull and index->depth() > 0ull) {
+               if (index->depth() == 1ull) {
+                 in_shard_ = top_level_cells_++ % shard_.count == shard_.index;
+               }
+               if (not in_shard_) {
+                 continue;
+               }
+             }
+             auto store = accept(std::make_shared<product_store>(index, "Source"));
+             if (index->depth() == 0ull) {
+               saw_job_ = true;
+               if (job_sent_.test_and_set()) {
+                 // Another stream has already emitted the job data cell.
+                 continue;
+               }
+             }
+             return sender_.make_message(std::move(store));
+           }
+         }}
+  {
+  }
+
+  void driver_stream::stop() { driver_.stop(); }
+
+  product_store_ptr driver_stream::accept(product_store_ptr store)
+  {
+    assert(store);
+    auto const new_depth = store->index()->depth();
+    while (not empty(layers_) and new_depth <= layers_.top().depth()) {
+      layers_.pop();
+    }
+    layers_.emplace(counters_, sender_, store);
+    return store;
+  }
+
+  void driver_stream::drain()
+  {
+    while (not empty(layers_)) {
+      layers_.pop();
+    }
+  }
+
   framework_graph::framework_graph(data_cell_index_ptr index, int const max_parallelism) :
     framework_graph{[index](framework_driver& driver) { driver.yield(index); }, max_parallelism}
   {
   }
 
-  // FIXME: The algorithm below should support user-specified flush stores.
   framework_graph::framework_graph(detail::next_index_t next_index, int const max_parallelism) :
+    framework_graph{std::vector{std::move(next_index)}, max_parallelism}
+  {
+  }
+
+  // FIXME: The algorithm below should support user-specified flush stores.
+  framework_graph::framework_graph(std::vector<detail::next_index_t> next_indices,
+                                   int const max_parallelism) :
     parallelism_limit_{static_cast<std::size_t>(max_parallelism)},
-    driver_{std::move(next_index)},
-    src_{graph_,
-         [this](tbb::flow_control& fc) mutable -> message {
-           auto item = driver_();
-           if (not item) {
-             drain();
-             fc.stop();
-             return {};
-           }
-           auto index = *item;
-           auto store = std::make_shared<product_store>(index, "Source");
-           return sender_.make_message(accept(std::move(store)));
-         }},
     multiplexer_{graph_},
     hierarchy_node_{
-      graph_, tbb::flow::unlimited, [this](message const& msg) -> tbb::flow::continue_msg {
+      graph_,
+      tbb::flow::unlimited,
+      [this](message const& msg) -> tbb::flow::continue_msg {
         if (not msg.store->is_flush()) {
           hierarchy_.increment_count(msg.store->index());
         }
         return {};
-      }}
+      }},
+    sender_{multiplexer_, next_indices.size()}
   {
+    if (next_indices.empty()) {
+      throw std::runtime_error("At least one driver must be provided to the framework graph.");
+    }
+
+    streams_.reserve(next_indices.size());
+    for (auto& next_index : next_indices) {
+      streams_.push_back(
+        std::make_unique<driver_stream>(graph_, std::move(next_index), sender_, job_sent_));
+    }
+
     // FIXME: Should the loading of env levels happen in the phlex app only?
     spdlog::cfg::load_env_levels();
     spdlog::info("Number of worker threads: {}", max_allowed_parallelism::active_value());
+    if (streams_.size() > 1ull) {
+      spdlog::info("Number of driver streams: {}", streams_.size());
+    }
   }
 
   framework_graph::~framework_graph()
   {
     if (shutdown_on_error_) {
       // When in an error state, we need to sanely pop the layer stack and wait for any tasks to finish.
-      while (!layers_.empty()) {
-        layers_.pop();
+      for (auto& stream : streams_) {
+        stream->drain();
       }
       graph_.wait_for_all();
     }
+    if (trace_) {
+      trace_->deactivate();
+    }
+    if (counters_) {
+      counters_->deactivate();
+    }
   }
 
   std::size_t framework_graph::seen_cell_count(std::string const& layer_name,
@@ -98,22 +183,92 @@ namespace phlex::experimental {
   try {
     finalize();
     run();
+    for (auto const& node : nodes_.outputs | std::views::values) {
+      node->end_job();
+    }
+    if (trace_) {
+      execution_report_ = trace_->summarize(max_allowed_parallelism::active_value());
+      report_execution(*execution_report_);
+    }
+    if (counters_) {
+      hardware_counter_report_ = counters_->summarize();
+      report_hardware_counters(*hardware_counter_report_);
+    }
   } catch (std::exception const& e) {
-    driver_.stop();
+    stop_drivers();
     spdlog::error(e.what());
     shutdown_on_error_ = true;
     throw;
   } catch (...) {
-    driver_.stop();
+    stop_drivers();
     spdlog::error("Unknown exception during graph execution");
     shutdown_on_error_ = true;
     throw;
   }
 
+  void framework_graph::restrict_to_shard(shard_spec const shard)
+  {
+    if (shard.count == 0ull or shard.index >= shard.count) {
+      throw std::runtime_error(fmt::format(
+        "Invalid shard specification {}/{}: the shard index must be less than the number of "
+        "shards.",
+        shard.index,
+        shard.count));
+    }
+    for (auto& stream : streams_) {
+      stream->restrict_to_shard(shard);
+    }
+    if (shard.count > 1ull) {
+      spdlog::info("Processing shard {} of {}", shard.index, shard.count);
+    }
+  }
+
+  void framework_graph::enable_execution_report()
+  {
+    trace_ = std::make_unique<execution_trace>();
+  }
+
+  std::optional<execution_summary> const& framework_graph::execution_report() const noexcept
+  {
+    return execution_report_;
+  }
+
+  void framework_graph::enable_hardware_counters()
+  {
+    counters_ = std::make_unique<hardware_counters>();
+  }
+
+  std::optional<hardware_counter_summary> const& framework_graph::hardware_counter_report()
+    const noexcept
+  {
+    return hardware_counter_report_;
+  }
+
   void framework_graph::run()
   {
-    src_.activate();
+    if (trace_) {
+      trace_->activate();
+    }
+    if (counters_) {
+      counters_->activate();
+    }
+    for (auto& stream : streams_) {
+      stream->source().activate();
+    }
     graph_.wait_for_all();
+    if (trace_) {
+      trace_->deactivate();
+    }
+    if (counters_) {
+      counters_->deactivate();
+    }
+  }
+
+  void framework_graph::stop_drivers()
+  {
+    for (auto& stream : streams_) {
+      stream->stop();
+    }
   }
 
   namespace {
@@ -161,8 +316,7 @@ namespace phlex::experimental {
     filters_.merge(internal_edges_for_predicates(graph_, nodes_.predicates, nodes_.transforms));
 
     edge_maker make_edges{nodes_.transforms, nodes_.folds, nodes_.unfolds};
-    make_edges(src_,
-               multiplexer_,
+    make_edges(multiplexer_,
                filters_,
                nodes_.outputs,
                nodes_.providers,
@@ -173,29 +327,94 @@ namespace phlex::experimental {
                nodes_.transforms);
 
     // The hierarchy node is used to report which data layers have been seen by the
-    // framework.  To assemble the report, data-cell indices emitted by the input node are
+    // framework.  To assemble the report, data-cell indices emitted by the input nodes are
     // recorded as well as any data-cell indices emitted by an unfold.
-    make_edge(src_, hierarchy_node_);
+    for (auto& stream : streams_) {
+      make_edge(stream->source(), multiplexer_);
+      make_edge(stream->source(), hierarchy_node_);
+    }
     for (auto& [_, node] : nodes_.unfolds) {
       make_edge(node->sender(), hierarchy_node_);
     }
-  }
 
-  product_store_ptr framework_graph::accept(product_store_ptr store)
-  {
-    assert(store);
-    auto const new_depth = store->index()->depth();
-    while (not empty(layers_) and new_depth <= layers_.top().depth()) {
-      layers_.pop();
+    if (trace_ or counters_) {
+      instrument_nodes();
     }
-    layers_.emplace(counters_, sender_, store);
-    return store;
   }
 
-  void framework_graph::drain()
+  void framework_graph::instrument_nodes()
   {
-    while (not empty(layers_)) {
-      layers_.pop();
+    auto describe = [this](auto const* node, execution_trace::node_info info) {
+      if (counters_) {
+        counters_->add_node(node_key(node), info.name, info.kind);
+      }
+      if (trace_) {
+        trace_->add_node(node_key(node), std::move(info));
+      }
+    };
+
+    // The upstream nodes of a consumer are its predicates and the nodes that produce its
+    // input products, as determined by the same rules used to create the graph edges.
+    edge_creation_policy const producers{nodes_.transforms, nodes_.folds, nodes_.unfolds};
+    std::map<tbb::flow::sender<message> const*, std::string> producer_names;
+    auto add_producers = [&](auto& nodes) {
+      for (auto& [name, node] : nodes) {
+        producer_names.emplace(&node->sender(), name);
+      }
+    };
+    add_producers(nodes_.transforms);
+    add_producers(nodes_.folds);
+    add_producers(nodes_.unfolds);
+
+    auto upstream_of = [&](products_consumer const& node) {
+      std::vector<std::string> result{node.when()};
+      for (auto const& query : node.input()) {
+        if (auto const* producer = producers.find_producer(query)) {
+          result.push_back(producer_names.at(producer->port));
+          continue;
+        }
+        for (auto const& [name, provider] : nodes_.providers) {
+          if (query == provider->output_product()) {
+            result.push_back(name);
+            break;
+          }
+        }
+      }
+      return result;
+    };
+
+    auto describe_consumers = [&](auto& nodes, std::string const& kind) {
+      for (auto const& [name, node] : nodes) {
+        describe(node.get(), {name, kind, upstream_of(*node)});
+      }
+    };
+    describe_consumers(nodes_.predicates, "predicate");
+    describe_consumers(nodes_.observers, "observer");
+    describe_consumers(nodes_.folds, "fold");
+    describe_consumers(nodes_.unfolds, "unfold");
+    describe_consumers(nodes_.transforms, "transform");
+
+    // Outputs may write the products of any producing node.
+    std::vector<std::string> all_producers;
+    for (auto const& name : producer_names | std::views::values) {
+      all_producers.push_back(name);
+    }
+    for (auto const& [name, _] : nodes_.providers) {
+      all_producers.push_back(name);
+    }
+    for (auto const& [name, node] : nodes_.outputs) {
+      auto upstream = node->when();
+      upstream.insert(upstream.end(), all_producers.begin(), all_producers.end());
+      describe(node.get(), {name, "output", std::move(upstream)});
+    }
+
+    for (auto const& [name, node] : nodes_.providers) {
+      describe(node.get(), {name, "provider", {}});
+    }
+
+    for (std::size_t i = 0; i != streams_.size(); ++i) {
+      auto name = streams_.size() > 1ull ? fmt::format("[driver {}]", i) : "[driver]";
+      describe(streams_[i].get(), {std::move(name), "driver", {}});
     }
   }
 }
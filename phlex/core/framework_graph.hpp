@@ -3,6 +3,7 @@
 
 #include "phlex/core/declared_fold.hpp"
 #include "phlex/core/declared_unfold.hpp"
+#include "phlex/core/execution_trace.hpp"
 #include "phlex/core/filter.hpp"
 #include "phlex/core/glue.hpp"
 #include "phlex/core/message.hpp"
@@ -20,9 +21,11 @@
 #include "oneapi/tbb/flow_graph.h"
 #include "oneapi/tbb/info.h"
 
+#include <atomic>
 #include <functional>
 #include <map>
-#include <queue>
+#include <memory>
+#include <optional>
 #include <stack>
 #include <string>
 #include <tuple>
@@ -47,16 +50,65 @@ namespace phlex::experimental {
     std::size_t depth_;
   };
 
+  // A driver_stream owns one driver, the input node that pulls data-cell indices from it,
+  // and the stack of layer sentries and flush counters for the data cells it yields.  Each
+  // stream's input node feeds the shared multiplexer.  The job data cell is emitted only
+  // once per graph, by whichever stream yields it first; its flush is merged across
+  // streams by the message_sender.
+  class driver_stream {
+  public:
+    driver_stream(tbb::flow::graph& g,
+                  detail::next_index_t next_index,
+                  message_sender& sender,
+                  std::atomic_flag& job_sent);
+
+    tbb::flow::input_node<message>& source() noexcept { return src_; }
+    void restrict_to_shard(shard_spec shard) noexcept { shard_ = shard; }
+    void stop();
+    void drain();
+
+  private:
+    product_store_ptr accept(product_store_ptr store);
+
+    framework_driver driver_;
+    message_sender& sender_;
+    std::atomic_flag& job_sent_;
+    bool saw_job_{false};
+    shard_spec shard_{};
+    std::size_t top_level_cells_{};
+    bool in_shard_{true};
+    flush_counters counters_;
+    std::stack<layer_sentry> layers_;
+    tbb::flow::input_node<message> src_;
+  };
+
   class framework_graph {
   public:
     explicit framework_graph(data_cell_index_ptr index,
                              int max_parallelism = oneapi::tbb::info::default_concurrency());
     explicit framework_graph(detail::next_index_t f,
                              int max_parallelism = oneapi::tbb::info::default_concurrency());
+    explicit framework_graph(std::vector<detail::next_index_t> fs,
+                             int max_parallelism = oneapi::tbb::info::default_concurrency());
     ~framework_graph();
 
     void execute();
 
+    // Must be called before execute()
+    void restrict_to_shard(shard_spec shard);
+
+    // Must be called before execute().  Each node invocation is then timed, and a report of
+    // the critical path, the worker utilization, and the serial bottlenecks of the job is
+    // logged once the graph has been executed.
+    void enable_execution_report();
+    std::optional<execution_summary> const& execution_report() const noexcept;
+
+    // Must be called before execute().  On Linux, the cycles, instructions, cache misses, and
+    // branch misses of each node invocation are then counted (if the kernel permits it), and
+    // the per-node totals are logged once the graph has been executed.
+    void enable_hardware_counters();
+    std::optional<hardware_counter_summary> const& hardware_counter_report() const noexcept;
+
     std::size_t seen_cell_count(std::string const& layer_name, bool missing_ok = false) const;
     std::size_t execution_count(std::string const& node_name) const;
 
@@ -115,6 +167,13 @@ namespace phlex::experimental {
       return make_glue().transform(std::move(name), std::move(f), c);
     }
 
+    auto async_transform(std::string name,
+                         is_async_transform_like auto f,
+                         concurrency c = concurrency::serial)
+    {
+      return make_glue().async_transform(std::move(name), std::move(f), c);
+    }
+
     auto provide(std::string name, auto f, concurrency c = concurrency::serial)
     {
       return make_glue().provide(std::move(name), std::move(f), c);
@@ -164,10 +223,8 @@ namespace phlex::experimental {
 
     void run();
     void finalize();
-
-    product_store_ptr accept(product_store_ptr store);
-    void drain();
-    std::size_t original_message_id(product_store_ptr const& store);
+    void instrument_nodes();
+    void stop_drivers();
 
     resource_usage graph_resource_usage_{};
     max_allowed_parallelism parallelism_limit_;
@@ -176,15 +233,16 @@ namespace phlex::experimental {
     std::map<std::string, filter> filters_{};
     // The graph_ object uses the filters_, nodes_, and hierarchy_ objects implicitly.
     tbb::flow::graph graph_{};
-    framework_driver driver_;
     std::vector<std::string> registration_errors_{};
-    tbb::flow::input_node<message> src_;
     multiplexer multiplexer_;
     tbb::flow::function_node<message> hierarchy_node_;
-    message_sender sender_{multiplexer_};
-    std::queue<product_store_ptr> pending_stores_;
-    flush_counters counters_;
-    std::stack<layer_sentry> layers_;
+    message_sender sender_;
+    std::atomic_flag job_sent_{};
+    std::vector<std::unique_ptr<driver_stream>> streams_;
+    std::unique_ptr<execution_trace> trace_;
+    std::optional<execution_summary> execution_report_;
+    std::unique_ptr<hardware_counters> counters_;
+    std::optional<hardware_counter_summary> hardware_counter_report_;
     bool shutdown_on_error_{false};
   };
 }
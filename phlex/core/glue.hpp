@@ -105,6 +105,19 @@ namespace phlex::experimental {
                                                errors_);
     }
 
+    template <typename FT>
+    auto async_transform(std::string name, FT f, concurrency c)
+    {
+      detail::verify_name(name, config_);
+      return make_registration<async_transform_node>(config_,
+                                                     std::move(name),
+                                                     algorithm_bits{bound_obj_, std::move(f)},
+                                                     c,
+                                                     graph_,
+                                                     nodes_,
+                                                     errors_);
+    }
+
     template <typename FT>
     auto predicate(std::string name, FT f, concurrency c)
     {
@@ -144,7 +157,8 @@ namespace phlex::experimental {
                         config_,
                         std::move(name),
                         graph_,
-                        delegate(bound_obj_, f),
+                        bound_obj_,
+                        detail::make_output_function(delegate(bound_obj_, f)),
                         c};
     }
 
@@ -80,13 +80,22 @@ namespace phlex::experimental {
       return create_glue().transform(std::move(name), std::move(f), c);
     }
 
+    auto async_transform(std::string name,
+                         is_async_transform_like auto f,
+                         concurrency c = concurrency::serial)
+    {
+      return create_glue().async_transform(std::move(name), std::move(f), c);
+    }
+
     template <typename Splitter>
     auto unfold(std::string name,
                 is_predicate_like auto pred,
                 auto unf,
-                concurrency c = concurrency::serial)
+                concurrency c,
+                std::string destination_data_layer)
     {
-      return create_glue(false).unfold(std::move(name), std::move(pred), std::move(unf), c);
+      return glue<Splitter>{graph_, nodes_, nullptr, errors_, config_}.unfold(
+        std::move(name), std::move(pred), std::move(unf), c, std::move(destination_data_layer));
     }
 
     auto output(std::string name, is_output_like auto f, concurrency c = concurrency::serial)
@@ -105,10 +114,7 @@ namespace phlex::experimental {
     {
     }
 
-    glue<T> create_glue(bool use_bound_object = true)
-    {
-      return glue{graph_, nodes_, (use_bound_object ? bound_obj_ : nullptr), errors_, config_};
-    }
+    glue<T> create_glue() { return glue{graph_, nodes_, bound_obj_, errors_, config_}; }
 
     configuration const* config_;
     tbb::flow::graph& graph_;
@@ -0,0 +1,305 @@
+#include "phlex/core/hardware_counters.hpp"
+
+#include "fmt/format.h"
+#include "spdlog/spdlog.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <ranges>
+#include <utility>
+
+#if __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace phlex::experimental {
+  namespace {
+    std::atomic<hardware_counters*> active_counters{nullptr};
+
+    constexpr std::size_t reported_nodes{10};
+    constexpr int not_linux{-1};
+
+    constexpr auto index(hardware_event const event) noexcept
+    {
+      return static_cast<std::size_t>(event);
+    }
+
+    // The counters opened by one thread.  The first supported event leads the group, so
+    // that all events of the thread are read with a single system call.
+    class thread_counters {
+    public:
+      thread_counters();
+      ~thread_counters();
+
+      thread_counters(thread_counters const&) = delete;
+      thread_counters& operator=(thread_counters const&) = delete;
+
+      bool opened() const noexcept { return leader_ != -1; }
+      std::array<bool, number_hardware_events> supported() const noexcept;
+      bool read(hardware_event_counts& counts) const noexcept;
+      int error() const noexcept { return error_; }
+
+    private:
+      int leader_{-1};
+      std::array<int, number_hardware_events> fds_{-1, -1, -1, -1};
+      std::array<std::size_t, number_hardware_events> slots_{};
+      std::size_t opened_{};
+      int error_{};
+    };
+
+#if __linux__
+    constexpr std::array<std::uint64_t, number_hardware_events> perf_configs{
+      PERF_COUNT_HW_CPU_CYCLES,
+      PERF_COUNT_HW_INSTRUCTIONS,
+      PERF_COUNT_HW_CACHE_MISSES,
+      PERF_COUNT_HW_BRANCH_MISSES};
+
+    thread_counters::thread_counters()
+    {
+      for (std::size_t i = 0; i != number_hardware_events; ++i) {
+        perf_event_attr attr{};
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = perf_configs[i];
+        attr.read_format =
+          PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        // pid = 0 and cpu = -1: count the calling thread on whichever CPU it runs
+        auto const fd = static_cast<int>(
+          syscall(SYS_perf_event_open, &attr, 0, -1, leader_, PERF_FLAG_FD_CLOEXEC));
+        if (fd == -1) {
+          if (error_ == 0) {
+            error_ = errno;
+          }
+          continue;
+        }
+        if (leader_ == -1) {
+          leader_ = fd;
+        }
+        fds_[i] = fd;
+        slots_[i] = opened_++;
+      }
+    }
+
+    thread_counters::~thread_counters()
+    {
+      for (auto const fd : fds_) {
+        if (fd != -1) {
+          close(fd);
+        }
+      }
+    }
+
+    bool thread_counters::read(hardware_event_counts& counts) const noexcept
+    {
+      if (leader_ == -1) {
+        return false;
+      }
+      // Layout for PERF_FORMAT_GROUP: nr, time_enabled, time_running, values[nr]
+      std::array<std::uint64_t, 3 + number_hardware_events> buffer{};
+      auto const expected = static_cast<ssize_t>((3 + opened_) * sizeof(std::uint64_t));
+      if (::read(leader_, buffer.data(), sizeof(buffer)) != expected) {
+        return false;
+      }
+      auto const [enabled, running] = std::pair{buffer[1], buffer[2]};
+      // Scale the counts if the kernel had to multiplex the counters
+      double const scale =
+        running > 0 and running < enabled ? static_cast<double>(enabled) / running : 1.;
+      for (std::size_t i = 0; i != number_hardware_events; ++i) {
+        counts[i] =
+          fds_[i] == -1 ? 0 : static_cast<std::uint64_t>(buffer[3 + slots_[i]] * scale);
+      }
+      return true;
+    }
+#else
+    thread_counters::thread_counters() : error_{not_linux} {}
+    thread_counters::~thread_counters() = default;
+    bool thread_counters::read(hardware_event_counts&) const noexcept { return false; }
+#endif
+
+    std::array<bool, number_hardware_events> thread_counters::supported() const noexcept
+    {
+      std::array<bool, number_hardware_events> result{};
+      std::ranges::transform(fds_, result.begin(), [](int const fd) { return fd != -1; });
+      return result;
+    }
+
+    thread_counters const& this_thread_counters()
+    {
+      thread_local thread_counters const counters;
+      return counters;
+    }
+
+    std::string unavailable_reason(int const error)
+    {
+      if (error == EACCES or error == EPERM) {
+        std::string paranoid{"unknown"};
+        std::ifstream{"/proc/sys/kernel/perf_event_paranoid"} >> paranoid;
+        return fmt::format("access to performance counters is not permitted "
+                           "(kernel.perf_event_paranoid = {})",
+                           paranoid);
+      }
+      if (error == not_linux) {
+        return "performance counters are only supported on Linux";
+      }
+      return fmt::format("no hardware performance counters are available ({})",
+                         std::strerror(error));
+    }
+
+    std::string format_count(std::uint64_t const count, bool const supported)
+    {
+      return supported ? fmt::format("{:.4g}", static_cast<double>(count)) : "n/a";
+    }
+
+    std::string format_rate(double const rate, bool const supported)
+    {
+      return supported ? fmt::format("{:.3f}", rate) : "n/a";
+    }
+  }
+
+  std::uint64_t hardware_counter_summary::node_usage::count(hardware_event const event) const
+  {
+    return counts[index(event)];
+  }
+
+  double hardware_counter_summary::node_usage::instructions_per_cycle() const
+  {
+    auto const cycles = count(hardware_event::cycles);
+    return cycles > 0 ? static_cast<double>(count(hardware_event::instructions)) / cycles : 0.;
+  }
+
+  double hardware_counter_summary::node_usage::misses_per_kilo_instruction(
+    hardware_event const event) const
+  {
+    auto const instructions = count(hardware_event::instructions);
+    return instructions > 0 ? 1000. * count(event) / instructions : 0.;
+  }
+
+  hardware_counters::hardware_counters()
+  {
+    auto const& counters = this_thread_counters();
+    supported_ = counters.supported();
+    if (not counters.opened()) {
+      spdlog::warn("Hardware counters are disabled: {}", unavailable_reason(counters.error()));
+    }
+  }
+
+  bool hardware_counters::available() const noexcept
+  {
+    return std::ranges::any_of(supported_, std::identity{});
+  }
+
+  void hardware_counters::add_node(void const* key, std::string name, std::string kind)
+  {
+    nodes_.insert_or_assign(key, std::pair{std::move(name), std::move(kind)});
+  }
+
+  void hardware_counters::activate()
+  {
+    if (available()) {
+      active_counters = this;
+    }
+  }
+
+  void hardware_counters::deactivate()
+  {
+    auto* expected = this;
+    active_counters.compare_exchange_strong(expected, nullptr);
+  }
+
+  hardware_counters* hardware_counters::active() noexcept
+  {
+    return active_counters.load(std::memory_order_relaxed);
+  }
+
+  bool hardware_counters::read(hardware_event_counts& counts) noexcept
+  {
+    return this_thread_counters().read(counts);
+  }
+
+  void hardware_counters::record(void const* node,
+                                 hardware_event_counts const& begin,
+                                 hardware_event_counts const& end)
+  {
+    auto& totals = totals_.local()[node];
+    ++totals.invocations;
+    for (std::size_t i = 0; i != number_hardware_events; ++i) {
+      // Scaled counts of multiplexed counters are estimates that need not be monotonic.
+      totals.counts[i] += end[i] > begin[i] ? end[i] - begin[i] : 0;
+    }
+  }
+
+  hardware_counter_summary hardware_counters::summarize() const
+  {
+    std::unordered_map<void const*, node_totals> combined;
+    for (auto const& local : totals_) {
+      for (auto const& [node, totals] : local) {
+        auto& sum = combined[node];
+        sum.invocations += totals.invocations;
+        for (std::size_t i = 0; i != number_hardware_events; ++i) {
+          sum.counts[i] += totals.counts[i];
+        }
+      }
+    }
+
+    hardware_counter_summary summary{
+      .available = available(), .supported = supported_, .nodes = {}};
+    for (auto const& [key, totals] : combined) {
+      auto it = nodes_.find(key);
+      if (it == nodes_.end()) {
+        continue;
+      }
+      auto const& [name, kind] = it->second;
+      summary.nodes.push_back({name, kind, totals.invocations, totals.counts});
+    }
+    std::ranges::sort(summary.nodes, std::ranges::greater{}, [](auto const& node) {
+      return node.count(hardware_event::cycles);
+    });
+    return summary;
+  }
+
+  void report_hardware_counters(hardware_counter_summary const& summary)
+  {
+    if (not summary.available) {
+      return;
+    }
+
+    auto const& supported = summary.supported;
+    auto const cycles = supported[index(hardware_event::cycles)];
+    auto const instructions = supported[index(hardware_event::instructions)];
+    auto const cache_misses = supported[index(hardware_event::cache_misses)];
+    auto const branch_misses = supported[index(hardware_event::branch_misses)];
+
+    spdlog::info("Hardware counters (MPKI: misses per thousand instructions):");
+    spdlog::info("  {:<40} {:>10} {:>10} {:>12} {:>12} {:>6} {:>11} {:>12}",
+                 "Node",
+                 "Kind",
+                 "Calls",
+                 "Cycles",
+                 "Instructions",
+                 "IPC",
+                 "Cache MPKI",
+                 "Branch MPKI");
+    for (auto const& node : summary.nodes | std::views::take(reported_nodes)) {
+      spdlog::info(
+        "  {:<40} {:>10} {:>10} {:>12} {:>12} {:>6} {:>11} {:>12}",
+        node.name,
+        node.kind,
+        node.invocations,
+        format_count(node.count(hardware_event::cycles), cycles),
+        format_count(node.count(hardware_event::instructions), instructions),
+        format_rate(node.instructions_per_cycle(), cycles and instructions),
+        format_rate(node.misses_per_kilo_instruction(hardware_event::cache_misses),
+                    cache_misses and instructions),
+        format_rate(node.misses_per_kilo_instruction(hardware_event::branch_misses),
+                    branch_misses and instructions));
+    }
+  }
+}
@@ -0,0 +1,85 @@
+#ifndef PHLEX_CORE_HARDWARE_COUNTERS_HPP
+#define PHLEX_CORE_HARDWARE_COUNTERS_HPP
+
+// =======================================================================================
+// The hardware_counters class attributes CPU hardware events (cycles, instructions, cache
+// misses, and branch misses) to the nodes of a framework graph.  Each thread that invokes
+// a node opens its own group of counters with perf_event_open(2) the first time it does
+// so; the counters are read before and after each invocation and the differences are
+// accumulated per node.
+//
+// Hardware counters are only supported on Linux, and only if the kernel permits unprivileged
+// processes to count their own user-space events (see /proc/sys/kernel/perf_event_paranoid).
+// When they are not available, a warning is logged and the job runs without them.
+// =======================================================================================
+
+#include "oneapi/tbb/enumerable_thread_specific.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace phlex::experimental {
+  enum class hardware_event : std::size_t { cycles, instructions, cache_misses, branch_misses };
+  inline constexpr std::size_t number_hardware_events{4};
+
+  using hardware_event_counts = std::array<std::uint64_t, number_hardware_events>;
+
+  struct hardware_counter_summary {
+    struct node_usage {
+      std::string name;
+      std::string kind;
+      std::size_t invocations{};
+      hardware_event_counts counts{};
+
+      std::uint64_t count(hardware_event event) const;
+      double instructions_per_cycle() const;
+      double misses_per_kilo_instruction(hardware_event event) const;
+    };
+
+    bool available{false};
+    std::array<bool, number_hardware_events> supported{};
+    std::vector<node_usage> nodes; // Sorted by decreasing number of cycles
+  };
+
+  class hardware_counters {
+  public:
+    // Opens the counters for the calling thread to determine which events are supported.
+    hardware_counters();
+
+    bool available() const noexcept;
+
+    void add_node(void const* key, std::string name, std::string kind);
+
+    void activate();
+    void deactivate();
+    static hardware_counters* active() noexcept;
+
+    // Reads the counters of the calling thread.  Returns false if they cannot be read.
+    static bool read(hardware_event_counts& counts) noexcept;
+
+    void record(void const* node,
+                hardware_event_counts const& begin,
+                hardware_event_counts const& end);
+
+    hardware_counter_summary summarize() const;
+
+  private:
+    struct node_totals {
+      std::size_t invocations{};
+      hardware_event_counts counts{};
+    };
+
+    std::array<bool, number_hardware_events> supported_{};
+    std::map<void const*, std::pair<std::string, std::string>> nodes_;
+    tbb::enumerable_thread_specific<std::unordered_map<void const*, node_totals>> totals_;
+  };
+
+  void report_hardware_counters(hardware_counter_summary const& summary);
+}
+
+#endif // PHLEX_CORE_HARDWARE_COUNTERS_HPP
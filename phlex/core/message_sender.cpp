@@ -1,18 +1,30 @@
 #include "phlex/core/message_sender.hpp"
 #include "phlex/core/multiplexer.hpp"
+#include "phlex/model/data_cell_counter.hpp"
 #include "phlex/model/product_store.hpp"
 
 #include <cassert>
+#include <memory>
 
 namespace phlex::experimental {
-  message_sender::message_sender(multiplexer& mplexer) : multiplexer_{mplexer} {}
+  message_sender::message_sender(multiplexer& mplexer, std::size_t const n_streams) :
+    multiplexer_{mplexer}, n_streams_{n_streams}
+  {
+    assert(n_streams_ > 0ull);
+  }
 
   message message_sender::make_message(product_store_ptr store)
   {
     assert(store);
     assert(not store->is_flush());
     auto const message_id = ++calls_;
-    original_message_ids_.try_emplace(store->index(), message_id);
+    std::lock_guard lock{mutex_};
+    if (n_streams_ > 1ull and store->index()->depth() == 0ull) {
+      // Different streams may use different index objects for the job data cell.
+      job_message_id_ = message_id;
+    } else {
+      original_message_ids_.try_emplace(store->index(), message_id);
+    }
     return {store, message_id, -1ull};
   }
 
@@ -20,19 +32,66 @@ namespace phlex::experimental {
   {
     assert(store);
     assert(store->is_flush());
+    if (n_streams_ > 1ull and store->index()->depth() == 0ull) {
+      merge_job_flush(store);
+      return;
+    }
+
     auto const message_id = ++calls_;
     message const msg{store, message_id, original_message_id(store)};
     multiplexer_.try_put(std::move(msg));
   }
 
+  void message_sender::stream_without_job()
+  {
+    std::lock_guard lock{mutex_};
+    ++finished_streams_;
+    maybe_send_job_flush();
+  }
+
   std::size_t message_sender::original_message_id(product_store_ptr const& store)
   {
     assert(store);
     assert(store->is_flush());
 
+    std::lock_guard lock{mutex_};
     auto h = original_message_ids_.extract(store->index());
     assert(h);
     return h.mapped();
   }
 
+  void message_sender::merge_job_flush(product_store_ptr const& store)
+  {
+    std::lock_guard lock{mutex_};
+    if (store->contains_product("[flush]")) {
+      auto const counts = store->get_product<flush_counts_ptr>("[flush]");
+      for (auto const& [layer_hash, count] : *counts) {
+        job_counts_[layer_hash] += count;
+      }
+    }
+    if (not job_flush_) {
+      job_flush_ = store;
+    }
+    ++finished_streams_;
+    maybe_send_job_flush();
+  }
+
+  void message_sender::maybe_send_job_flush()
+  {
+    // Must be called with the mutex locked
+    if (finished_streams_ != n_streams_ or not job_flush_) {
+      return;
+    }
+
+    auto flush_store = job_flush_->make_flush();
+    if (not job_counts_.empty()) {
+      flush_store->add_product("[flush]",
+                               std::make_shared<flush_counts const>(std::move(job_counts_)));
+    }
+    job_flush_.reset();
+
+    message const msg{flush_store, ++calls_, job_message_id_};
+    multiplexer_.try_put(std::move(msg));
+  }
+
 }
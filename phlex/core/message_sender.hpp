@@ -4,25 +4,47 @@
 #include "phlex/core/fwd.hpp"
 #include "phlex/core/message.hpp"
 #include "phlex/core/multiplexer.hpp"
+#include "phlex/model/data_cell_index.hpp"
 #include "phlex/model/fwd.hpp"
 
+#include <atomic>
+#include <cstddef>
 #include <map>
+#include <mutex>
 
 namespace phlex::experimental {
 
+  // The message_sender may be shared by several driver streams, each of which runs its
+  // own input node.  Each stream reports its own flush of the job data cell; the job flush
+  // is forwarded to the multiplexer only once all streams have reported, with the child
+  // counts of all streams merged.
+
   class message_sender {
   public:
-    explicit message_sender(multiplexer& mplexer);
+    explicit message_sender(multiplexer& mplexer, std::size_t n_streams = 1);
 
     void send_flush(product_store_ptr store);
     message make_message(product_store_ptr store);
 
+    // Called by a stream that finished without ever yielding the job data cell.
+    void stream_without_job();
+
   private:
     std::size_t original_message_id(product_store_ptr const& store);
+    void merge_job_flush(product_store_ptr const& store);
+    void maybe_send_job_flush();
 
     multiplexer& multiplexer_;
+    std::size_t const n_streams_;
+    std::mutex mutex_;
     std::map<data_cell_index_ptr, std::size_t> original_message_ids_;
-    std::size_t calls_{};
+    std::atomic<std::size_t> calls_{};
+
+    // Accumulated job-flush information (only used for more than one stream)
+    std::size_t job_message_id_{};
+    product_store_ptr job_flush_;
+    std::map<data_cell_index::hash_type, std::size_t> job_counts_;
+    std::size_t finished_streams_{};
   };
 
 }
@@ -2,8 +2,10 @@
 #define PHLEX_CORE_PRODUCT_QUERY_HPP
 
 #include "phlex/model/product_specification.hpp"
+#include "phlex/model/products.hpp"
 
 // #include <algorithm>
+#include <concepts>
 #include <string>
 #include <vector>
 
@@ -48,7 +50,10 @@ namespace phlex::experimental {
       template <typename T>
       void set_type(C& container)
       {
-        container.at(index_).set_type(make_type_id<T>());
+        // The type of a type-erased input is set on the query when it is created
+        if constexpr (!std::same_as<handle_value_type<T>, product_base>) {
+          container.at(index_).set_type(make_type_id<T>());
+        }
         ++index_;
       }
 
@@ -5,6 +5,7 @@
 #include "phlex/core/concepts.hpp"
 #include "phlex/core/declared_fold.hpp"
 #include "phlex/core/detail/make_algorithm_name.hpp"
+#include "phlex/core/detail/maybe_predicates.hpp"
 #include "phlex/core/node_catalog.hpp"
 #include "phlex/core/upstream_predicates.hpp"
 #include "phlex/metaprogramming/delegate.hpp"
@@ -304,26 +305,63 @@ namespace phlex::experimental {
   // ====================================================================================
   // Output API
 
+  template <typename T>
   class output_api {
   public:
     output_api(registrar<declared_output_ptr> reg,
                configuration const* config,
                std::string name,
                tbb::flow::graph& g,
-               detail::output_function_t&& f,
-               concurrency c);
+               std::shared_ptr<T> bound_obj,
+               detail::any_output_function_t&& f,
+               concurrency c) :
+      name_{detail::make_algorithm_name(config, std::move(name))},
+      graph_{g},
+      bound_obj_{std::move(bound_obj)},
+      ft_{std::move(f)},
+      concurrency_{c},
+      reg_{std::move(reg)}
+    {
+      // Predicates from the configuration always take precedence
+      if (config) {
+        reg_.set_predicates(detail::maybe_predicates(config));
+      }
+      reg_.set_creator([this](auto predicates, auto) {
+        return make_declared_output(std::move(name_),
+                                    concurrency_.value,
+                                    std::move(predicates),
+                                    graph_,
+                                    std::move(ft_),
+                                    std::move(end_of_job_));
+      });
+    }
 
-    void experimental_when(std::vector<std::string> predicates);
+    void experimental_when(std::vector<std::string> predicates)
+    {
+      if (!reg_.has_predicates()) {
+        reg_.set_predicates(std::move(predicates));
+      }
+    }
 
     void experimental_when(std::convertible_to<std::string> auto&&... names)
     {
       experimental_when({std::forward<decltype(names)>(names)...});
     }
 
+    // The member function is called once all data cells have been processed, and before the
+    // job ends.  An output can use it to complete its files and report any failure to do so.
+    output_api& experimental_at_end_of_job(void (T::*f)())
+    {
+      end_of_job_ = delegate(bound_obj_, f);
+      return *this;
+    }
+
   private:
     algorithm_name name_;
     tbb::flow::graph& graph_;
-    detail::output_function_t ft_;
+    std::shared_ptr<T> bound_obj_;
+    detail::any_output_function_t ft_;
+    std::function<void()> end_of_job_{};
     concurrency concurrency_;
     registrar<declared_output_ptr> reg_;
   };
@@ -9,12 +9,24 @@
 #include "phlex/utilities/async_driver.hpp"
 
 #include <concepts>
+#include <cstddef>
 #include <memory>
 
 namespace phlex {
   using framework_driver = experimental::async_driver<data_cell_index_ptr>;
 }
 
+namespace phlex::experimental {
+  // A job may be split across several processes (shards).  Shard 'index' of 'count' only
+  // processes the top-level data cells (i.e. the children of the job) whose ordinal
+  // position within the driver's sequence of top-level cells, modulo 'count', equals
+  // 'index'.  All descendants of a skipped top-level cell are skipped as well.
+  struct shard_spec {
+    std::size_t index{0};
+    std::size_t count{1};
+  };
+}
+
 namespace phlex::experimental::detail {
 
   // See note below.
@@ -99,6 +99,21 @@ namespace phlex::experimental {
 
   template <typename... Ts>
   class is_tuple<std::tuple<Ts...>> : public std::true_type {};
+
+  template <typename T>
+  class async_future; // See phlex/utilities/async_future.hpp
+
+  template <typename T>
+  class is_future : public std::false_type {};
+
+  template <typename T>
+  class is_future<async_future<T>> : public std::true_type {
+  public:
+    using value_type = T;
+  };
+
+  template <typename T>
+  using future_value_t = typename is_future<T>::value_type;
 }
 
 #endif // PHLEX_METAPROGRAMMING_TYPE_DEDUCTION_HPP
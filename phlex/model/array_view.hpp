@@ -0,0 +1,143 @@
+#ifndef PHLEX_MODEL_ARRAY_VIEW_HPP
+#define PHLEX_MODEL_ARRAY_VIEW_HPP
+
+// =======================================================================================
+// An array_view<T> is a read-only, possibly strided, N-dimensional view of elements that
+// are owned elsewhere, e.g. by an array created in another language.  The owner is kept
+// alive by a type-erased shared pointer, whose deleter decides how (and on which thread)
+// the memory is released.  The view never copies the elements: consumers that require
+// contiguous memory use span(), which throws for a strided view, or to_vector().
+//
+// Elements are addressed in C (row-major) order, irrespective of the strides.
+// =======================================================================================
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace phlex::experimental {
+  template <typename T>
+  class array_view {
+  public:
+    class const_iterator;
+    using value_type = T;
+    using iterator = const_iterator;
+
+    // Strides are in bytes, as for NumPy and the Python buffer protocol
+    array_view(T const* data,
+               std::vector<std::size_t> shape,
+               std::vector<std::ptrdiff_t> strides,
+               std::shared_ptr<void const> owner) :
+      data_{data}, shape_{std::move(shape)}, strides_{std::move(strides)}, owner_{std::move(owner)}
+    {
+      if (shape_.size() != strides_.size()) {
+        throw std::invalid_argument("array_view: shape and strides differ in dimensions");
+      }
+      size_ = 1;
+      for (auto const n : shape_) {
+        size_ *= n;
+      }
+      std::ptrdiff_t expected = sizeof(T);
+      contiguous_ = true;
+      for (std::size_t d = shape_.size(); d-- > 0;) {
+        if (shape_[d] != 1 && strides_[d] != expected) {
+          contiguous_ = false;
+        }
+        expected *= static_cast<std::ptrdiff_t>(shape_[d]);
+      }
+    }
+
+    // A contiguous, one-dimensional view
+    array_view(T const* data, std::size_t size, std::shared_ptr<void const> owner) :
+      array_view{data, {size}, {static_cast<std::ptrdiff_t>(sizeof(T))}, std::move(owner)}
+    {
+    }
+
+    T const* data() const noexcept { return data_; }
+    std::size_t ndim() const noexcept { return shape_.size(); }
+    std::vector<std::size_t> const& shape() const noexcept { return shape_; }
+    std::vector<std::ptrdiff_t> const& strides() const noexcept { return strides_; }
+    std::size_t size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+    bool is_contiguous() const noexcept { return contiguous_; }
+    std::shared_ptr<void const> const& owner() const noexcept { return owner_; }
+
+    std::span<T const> span() const
+    {
+      if (!contiguous_) {
+        throw std::runtime_error("array_view: a strided view has no contiguous span");
+      }
+      return {data_, size_};
+    }
+
+    // The element at the given position in C order
+    T const& operator[](std::size_t i) const
+    {
+      if (contiguous_) {
+        return data_[i];
+      }
+      std::ptrdiff_t offset = 0;
+      for (std::size_t d = shape_.size(); d-- > 0;) {
+        offset += static_cast<std::ptrdiff_t>(i % shape_[d]) * strides_[d];
+        i /= shape_[d];
+      }
+      return *reinterpret_cast<T const*>(reinterpret_cast<std::byte const*>(data_) + offset);
+    }
+
+    const_iterator begin() const { return {this, 0}; }
+    const_iterator end() const { return {this, size_}; }
+
+    std::vector<T> to_vector() const
+    {
+      if (contiguous_) {
+        return {data_, data_ + size_};
+      }
+      return {begin(), end()};
+    }
+
+    class const_iterator {
+    public:
+      using iterator_category = std::forward_iterator_tag;
+      using value_type = T;
+      using difference_type = std::ptrdiff_t;
+      using pointer = T const*;
+      using reference = T const&;
+
+      const_iterator() = default;
+      const_iterator(array_view const* view, std::size_t i) : view_{view}, i_{i} {}
+
+      reference operator*() const { return (*view_)[i_]; }
+      pointer operator->() const { return &(*view_)[i_]; }
+      const_iterator& operator++()
+      {
+        ++i_;
+        return *this;
+      }
+      const_iterator operator++(int)
+      {
+        auto result = *this;
+        ++i_;
+        return result;
+      }
+      bool operator==(const_iterator const& other) const { return i_ == other.i_; }
+
+    private:
+      array_view const* view_{nullptr};
+      std::size_t i_{};
+    };
+
+  private:
+    T const* data_;
+    std::vector<std::size_t> shape_;
+    std::vector<std::ptrdiff_t> strides_;
+    std::shared_ptr<void const> owner_;
+    std::size_t size_;
+    bool contiguous_;
+  };
+}
+
+#endif // PHLEX_MODEL_ARRAY_VIEW_HPP
@@ -4,6 +4,7 @@
 #include "phlex/model/product_specification.hpp"
 
 #include <cassert>
+#include <concepts>
 #include <memory>
 #include <string>
 #include <typeinfo>
@@ -78,11 +79,16 @@ namespace phlex::experimental {
 
       auto const* available_product = it->second.get();
 
-      if (auto const* desired_product = dynamic_cast<product<T> const*>(available_product)) {
-        return desired_product->obj;
-      }
+      // Type-erased access, for consumers that only know the product type at run time
+      if constexpr (std::same_as<T, product_base>) {
+        return *available_product;
+      } else {
+        if (auto const* desired_product = dynamic_cast<product<T> const*>(available_product)) {
+          return desired_product->obj;
+        }
 
-      throw_mismatched_type(product_name, typeid(T).name(), available_product->type().name());
+        throw_mismatched_type(product_name, typeid(T).name(), available_product->type().name());
+      }
     }
 
     bool contains(std::string const& product_name) const;
@@ -0,0 +1,63 @@
+#ifndef PHLEX_MODEL_RECORD_ARRAY_HPP
+#define PHLEX_MODEL_RECORD_ARRAY_HPP
+
+// =======================================================================================
+// A record_array is a read-only, contiguous sequence of records (see record_layout.hpp)
+// whose memory is owned elsewhere, e.g. by an array created in another language.  It is
+// the product type of records that are not created as a std::vector in C++.  Consumers
+// that know the record type access the elements through as<S>(), which checks the type.
+// =======================================================================================
+
+#include "phlex/model/record_layout.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+namespace phlex::experimental {
+  class record_array {
+  public:
+    record_array(record_layout const& layout,
+                 void const* data,
+                 std::size_t size,
+                 std::shared_ptr<void const> owner) :
+      layout_{&layout}, data_{data}, size_{size}, owner_{std::move(owner)}
+    {
+    }
+
+    record_layout const& layout() const noexcept { return *layout_; }
+    void const* data() const noexcept { return data_; }
+    std::size_t size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+    std::shared_ptr<void const> const& owner() const noexcept { return owner_; }
+
+    template <typename S>
+    std::span<S const> as() const
+    {
+      if (*layout_->type != typeid(S)) {
+        throw std::runtime_error("record_array: the records are of type '" + layout_->name +
+                                 "', not of the requested type");
+      }
+      return {static_cast<S const*>(data_), size_};
+    }
+
+    template <typename S>
+    std::vector<S> to_vector() const
+    {
+      auto const records = as<S>();
+      return {records.begin(), records.end()};
+    }
+
+  private:
+    record_layout const* layout_;
+    void const* data_;
+    std::size_t size_;
+    std::shared_ptr<void const> owner_;
+  };
+}
+
+#endif // PHLEX_MODEL_RECORD_ARRAY_HPP
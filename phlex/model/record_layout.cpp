@@ -0,0 +1,54 @@
+#include "phlex/model/record_layout.hpp"
+
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <typeindex>
+
+namespace {
+  struct record_registry {
+    std::mutex mutex;
+    std::map<std::string, phlex::experimental::record_layout> by_name;
+    std::map<std::type_index, phlex::experimental::record_layout const*> by_type;
+  };
+
+  record_registry& registry()
+  {
+    static record_registry instance;
+    return instance;
+  }
+}
+
+namespace phlex::experimental {
+  void register_record_layout(record_layout layout)
+  {
+    auto& r = registry();
+    std::lock_guard lock{r.mutex};
+    if (auto it = r.by_name.find(layout.name); it != r.by_name.end()) {
+      if (*it->second.type != *layout.type) {
+        throw std::runtime_error("A different record is already registered as '" + layout.name +
+                                 "'");
+      }
+      return;
+    }
+    auto const& registered = r.by_name.emplace(layout.name, std::move(layout)).first->second;
+    r.by_type.emplace(*registered.type, &registered);
+    r.by_type.emplace(*registered.vector_type, &registered);
+  }
+
+  record_layout const* find_record_layout(std::string const& name)
+  {
+    auto& r = registry();
+    std::lock_guard lock{r.mutex};
+    auto it = r.by_name.find(name);
+    return it != r.by_name.end() ? &it->second : nullptr;
+  }
+
+  record_layout const* find_record_layout(std::type_info const& type)
+  {
+    auto& r = registry();
+    std::lock_guard lock{r.mutex};
+    auto it = r.by_type.find(type);
+    return it != r.by_type.end() ? it->second : nullptr;
+  }
+}
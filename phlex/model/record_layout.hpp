@@ -0,0 +1,111 @@
+#ifndef PHLEX_MODEL_RECORD_LAYOUT_HPP
+#define PHLEX_MODEL_RECORD_LAYOUT_HPP
+
+// =======================================================================================
+// A record is a struct whose fields are all arithmetic types, e.g.
+//
+//   struct track {
+//     double px, py, pz;
+//     int charge;
+//   };
+//
+// Its layout (field names, offsets, and types) is reflected with Boost.PFR, so that code
+// that does not know the C++ type, such as the Python bridge, can interpret the memory
+// of a std::vector of records.  A module registers the records it creates or consumes:
+//
+//   register_record<track>("track");
+//
+// Layouts are registered for the lifetime of the program and looked up by name, or by the
+// type of the record or of the vector of records.
+// =======================================================================================
+
+#include "phlex/model/type_id.hpp"
+
+#include <boost/pfr/core.hpp>
+#include <boost/pfr/core_name.hpp>
+
+#include <concepts>
+#include <cstddef>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+namespace phlex::experimental {
+  struct record_field {
+    std::string name;
+    std::size_t offset;
+    std::size_t size;
+    char kind; // 'b' (bool), 'i' (signed integer), 'u' (unsigned integer), 'f' (floating point)
+  };
+
+  struct record_layout {
+    std::string name;
+    std::type_info const* type;        // of the record
+    std::type_info const* vector_type; // of std::vector of the record
+    type_id vector_type_id;
+    std::size_t size;
+    std::vector<record_field> fields;
+    // The elements of a std::vector of the record, as raw memory
+    std::span<std::byte const> (*elements)(void const* vector);
+  };
+
+  template <typename S>
+  record_layout make_record_layout(std::string name)
+  {
+    static_assert(std::is_aggregate_v<S> && std::is_standard_layout_v<S>,
+                  "A record must be a standard-layout aggregate");
+
+    S const record{};
+    auto const* base = reinterpret_cast<std::byte const*>(&record);
+    constexpr auto names = boost::pfr::names_as_array<S>();
+
+    std::vector<record_field> fields;
+    [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+      auto add_field = [&]<std::size_t I>() {
+        using field_t = boost::pfr::tuple_element_t<I, S>;
+        static_assert(std::is_arithmetic_v<field_t>, "The fields of a record must be arithmetic");
+        char kind = 'i';
+        if constexpr (std::same_as<field_t, bool>) {
+          kind = 'b';
+        } else if constexpr (std::is_floating_point_v<field_t>) {
+          kind = 'f';
+        } else if constexpr (std::is_unsigned_v<field_t>) {
+          kind = 'u';
+        }
+        auto const* field = reinterpret_cast<std::byte const*>(&boost::pfr::get<I>(record));
+        fields.push_back({std::string{names[I]},
+                          static_cast<std::size_t>(field - base),
+                          sizeof(field_t),
+                          kind});
+      };
+      (add_field.template operator()<Is>(), ...);
+    }(std::make_index_sequence<boost::pfr::tuple_size_v<S>>{});
+
+    return {std::move(name),
+            &typeid(S),
+            &typeid(std::vector<S>),
+            make_type_id<std::vector<S>>(),
+            sizeof(S),
+            std::move(fields),
+            [](void const* vector) {
+              auto const& v = *static_cast<std::vector<S> const*>(vector);
+              return std::as_bytes(std::span{v});
+            }};
+  }
+
+  // Registering the same record twice is allowed; a different record of the same name is not
+  void register_record_layout(record_layout layout);
+  record_layout const* find_record_layout(std::string const& name);
+  record_layout const* find_record_layout(std::type_info const& type);
+
+  template <typename S>
+  void register_record(std::string name)
+  {
+    register_record_layout(make_record_layout<S>(std::move(name)));
+  }
+}
+
+#endif // PHLEX_MODEL_RECORD_LAYOUT_HPP
@@ -19,6 +19,7 @@ namespace phlex::experimental {
     //        Users can call make<T>(...).fold(...) but not make<T>(...).provide(...)
     using base::make;
 
+    using base::async_transform;
     using base::fold;
     using base::observe;
     using base::predicate;
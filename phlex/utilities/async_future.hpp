@@ -0,0 +1,177 @@
+#ifndef PHLEX_UTILITIES_ASYNC_FUTURE_HPP
+#define PHLEX_UTILITIES_ASYNC_FUTURE_HPP
+
+// =======================================================================================
+// An async_promise/async_future pair works like std::promise/std::future, except that the
+// consumer of the future can register a continuation with on_ready().  The continuation is
+// invoked by the thread that satisfies the promise (or immediately, if the promise has
+// already been satisfied), so that the result of asynchronous work is handed on without
+// any thread waiting or polling for it.  A promise that is destroyed without having been
+// satisfied stores a std::future_error (broken_promise), which also invokes the
+// continuation.
+//
+// An async_scope guards continuations that refer to objects with a shorter lifetime than
+// the asynchronous work (e.g. the node of a graph that is destroyed on an exception path):
+// once the scope has been closed, guarded continuations do nothing.  Closing the scope
+// waits for guarded continuations that are running.
+// =======================================================================================
+
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <utility>
+
+namespace phlex::experimental {
+  namespace detail {
+    template <typename T>
+    class async_state {
+    public:
+      template <typename F>
+      void satisfy(F set_result)
+      {
+        set_result(promise_);
+        std::function<void()> continuation;
+        {
+          std::lock_guard lock{mutex_};
+          ready_ = true;
+          continuation = std::move(continuation_);
+        }
+        if (continuation) {
+          continuation();
+        }
+      }
+
+      void on_ready(std::function<void()> continuation)
+      {
+        {
+          std::lock_guard lock{mutex_};
+          if (not ready_) {
+            continuation_ = std::move(continuation);
+            return;
+          }
+        }
+        continuation();
+      }
+
+      bool ready() const
+      {
+        std::lock_guard lock{mutex_};
+        return ready_;
+      }
+
+      std::future<T> get_future() { return promise_.get_future(); }
+
+    private:
+      std::promise<T> promise_;
+      mutable std::mutex mutex_;
+      bool ready_{false};
+      std::function<void()> continuation_;
+    };
+  }
+
+  template <typename T>
+  class async_promise;
+
+  template <typename T>
+  class async_future {
+  public:
+    async_future() = default;
+
+    bool valid() const noexcept { return future_.valid(); }
+    T get() { return future_.get(); }
+    void wait() const { future_.wait(); }
+
+    // The continuation is invoked once, by the thread that satisfies the promise.
+    void on_ready(std::function<void()> continuation) { state_->on_ready(std::move(continuation)); }
+
+  private:
+    friend class async_promise<T>;
+    explicit async_future(std::shared_ptr<detail::async_state<T>> state) :
+      state_{std::move(state)}, future_{state_->get_future()}
+    {
+    }
+
+    std::shared_ptr<detail::async_state<T>> state_;
+    std::future<T> future_;
+  };
+
+  template <typename T>
+  class async_promise {
+  public:
+    async_promise() : state_{std::make_shared<detail::async_state<T>>()} {}
+    ~async_promise() { abandon(); }
+
+    async_promise(async_promise&&) noexcept = default;
+    async_promise& operator=(async_promise&& other) noexcept
+    {
+      if (this != &other) {
+        abandon();
+        state_ = std::move(other.state_);
+      }
+      return *this;
+    }
+
+    async_future<T> get_future() { return async_future<T>{state_}; }
+
+    template <typename... Args>
+    void set_value(Args&&... args)
+    {
+      state_->satisfy([&](std::promise<T>& p) { p.set_value(std::forward<Args>(args)...); });
+    }
+
+    void set_exception(std::exception_ptr e)
+    {
+      state_->satisfy([&e](std::promise<T>& p) { p.set_exception(std::move(e)); });
+    }
+
+  private:
+    void abandon()
+    {
+      if (state_ and not state_->ready()) {
+        set_exception(
+          std::make_exception_ptr(std::future_error{std::future_errc::broken_promise}));
+      }
+    }
+
+    std::shared_ptr<detail::async_state<T>> state_;
+  };
+
+  class async_scope {
+  public:
+    async_scope() = default;
+    ~async_scope() { close(); }
+
+    async_scope(async_scope const&) = delete;
+    async_scope& operator=(async_scope const&) = delete;
+
+    // Returns a callable that invokes f, unless the scope has been closed.
+    template <typename F>
+    auto guard(F f) const
+    {
+      return [state = state_, f = std::move(f)]() mutable {
+        std::shared_lock lock{state->mutex};
+        if (state->open) {
+          f();
+        }
+      };
+    }
+
+    void close()
+    {
+      std::unique_lock lock{state_->mutex};
+      state_->open = false;
+    }
+
+  private:
+    struct state {
+      std::shared_mutex mutex;
+      bool open{true};
+    };
+    std::shared_ptr<state> state_{std::make_shared<state>()};
+  };
+}
+
+#endif // PHLEX_UTILITIES_ASYNC_FUTURE_HPP
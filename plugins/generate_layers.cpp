@@ -14,6 +14,15 @@
 //   }
 //
 // Note that 'total' refers to the total number of data cells *per* parent.
+//
+// Several drivers may be run concurrently by specifying an array of driver configurations.
+// Each driver must then produce a disjoint set of data cells (apart from the job), which
+// can be achieved through the 'starting_number' parameter:
+//
+//   driver: [
+//     { cpp: "generate_layers", layers: { run: { total: 8 } } },
+//     { cpp: "generate_layers", layers: { run: { total: 8, starting_number: 8 } } }
+//   ]
 // ==============================================================================================
 
 #include "phlex/driver.hpp"
@@ -0,0 +1,59 @@
+// ==============================================================================================
+// The merge_shards driver yields the job data cell followed by one 'shard' data cell for each
+// configured shard-result file.  An empty file is written by a shard that produced no result
+// (e.g. because it processed no data cells); no data cell is yielded for such a shard.  See
+// the notes in plugins/shard_results.hpp.
+//
+//   driver: {
+//     cpp: "merge_shards",
+//     files: ["sum-shard-0.txt", "sum-shard-1.txt"]
+//   }
+// ==============================================================================================
+
+#include "phlex/driver.hpp"
+#include "phlex/model/data_cell_index.hpp"
+
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+using namespace phlex;
+
+namespace {
+  class merge_shards {
+  public:
+    merge_shards(configuration const& config) :
+      file_names_{config.get<std::vector<std::string>>("files")}
+    {
+    }
+
+    void next(framework_driver& driver)
+    {
+      auto const job_index = data_cell_index::base_ptr();
+      driver.yield(job_index);
+      for (std::size_t i = 0; i != file_names_.size(); ++i) {
+        if (has_result(file_names_[i])) {
+          driver.yield(job_index->make_child(i, "shard"));
+        }
+      }
+    }
+
+  private:
+    static bool has_result(std::string const& file_name)
+    {
+      std::error_code ec;
+      auto const size = std::filesystem::file_size(file_name, ec);
+      if (ec) {
+        throw std::runtime_error("Could not read shard-result file '" + file_name +
+                                 "': " + ec.message());
+      }
+      return size != 0;
+    }
+
+    std::vector<std::string> file_names_;
+  };
+}
+
+PHLEX_EXPERIMENTAL_REGISTER_DRIVER(merge_shards)
@@ -1,10 +1,30 @@
+#include "phlex/model/array_view.hpp"
+#include "phlex/model/data_cell_index.hpp"
+#include "phlex/model/record_array.hpp"
+#include "phlex/model/record_layout.hpp"
 #include "phlex/module.hpp"
+#include "phlex/utilities/async_future.hpp"
 #include "wrap.hpp"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <deque>
+#include <exception>
 #include <functional>
+#include <iterator>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <sstream>
 #include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
 #include <vector>
 
 #define NO_IMPORT_ARRAY
@@ -13,17 +33,32 @@
 
 using namespace phlex::experimental;
 using phlex::concurrency;
+using phlex::data_cell_index;
+using phlex::product_queries;
 using phlex::product_query;
 
-// TODO: the layer is currently hard-wired and should come from the product
-// specification instead, but that doesn't exist in Python yet.
+// Python 3.13 critical sections lock an object in free-threaded builds and are a no-op
+// otherwise; with the GIL held, there is nothing to do for older versions
+#if PY_VERSION_HEX >= 0x030d0000
+#define PHLEX_BEGIN_CRITICAL_SECTION(op) Py_BEGIN_CRITICAL_SECTION(op)
+#define PHLEX_END_CRITICAL_SECTION() Py_END_CRITICAL_SECTION()
+#else
+#define PHLEX_BEGIN_CRITICAL_SECTION(op) {
+#define PHLEX_END_CRITICAL_SECTION() }
+#endif
+
+// TODO: the layer is given per registration (the "layer" keyword), with this as the
+// default; it should come from the product specification instead, but that doesn't
+// exist in Python yet.
 static std::string const LAYER = "event";
 
-// Simple phlex module wrapper
+// Simple phlex module wrapper; wraps either the registrar of a module (for transforms,
+// observers, and folds) or that of a source (for providers)
 // clang-format off
 struct phlex::experimental::py_phlex_module {
   PyObject_HEAD
   phlex_module_t* ph_module;
+  phlex_source_t* ph_source;
 };
 // clang-format on
 
@@ -36,6 +71,21 @@ PyObject* phlex::experimental::wrap_module(phlex_module_t* module_)
 
   py_phlex_module* pymod = PyObject_New(py_phlex_module, &PhlexModule_Type);
   pymod->ph_module = module_;
+  pymod->ph_source = nullptr;
+
+  return (PyObject*)pymod;
+}
+
+PyObject* phlex::experimental::wrap_source(phlex_source_t* source)
+{
+  if (!source) {
+    PyErr_SetString(PyExc_ValueError, "provided source is null");
+    return nullptr;
+  }
+
+  py_phlex_module* pymod = PyObject_New(py_phlex_module, &PhlexModule_Type);
+  pymod->ph_module = nullptr;
+  pymod->ph_source = source;
 
   return (PyObject*)pymod;
 }
@@ -55,27 +105,137 @@ namespace {
     return oss.str();
   }
 
-  static inline PyObject* lifeline_transform(intptr_t arg)
+  static inline PyObject* lifeline_transform(PyObject* pyobj)
   {
-    PyObject* pyobj = (PyObject*)arg;
     if (pyobj && PyObject_TypeCheck(pyobj, &PhlexLifeline_Type)) {
       return ((py_lifeline_t*)pyobj)->m_view;
     }
     return pyobj;
   }
 
+  static bool python_gil_enabled()
+  {
+#ifdef Py_GIL_DISABLED
+    // a free-threaded build re-enables the GIL at run time when an extension module is
+    // imported that does not declare support for running without it
+    bool enabled = true;
+    if (PyObject* sys = PyImport_ImportModule("sys")) {
+      if (PyObject* res = PyObject_CallMethod(sys, "_is_gil_enabled", nullptr)) {
+        enabled = PyObject_IsTrue(res) != 0;
+        Py_DECREF(res);
+      }
+      Py_DECREF(sys);
+    }
+    PyErr_Clear();
+    return enabled;
+#else
+    return true;
+#endif
+  }
+
+  // Python objects held by C++ products (e.g. the arrays behind an array_view) are released
+  // wherever the last product referring to them is destroyed, which is usually a thread that
+  // does not hold the GIL, and may be one that runs during or after interpreter shutdown.
+  // The releasing thread therefore never touches Python: the references are queued and
+  // dropped by the next Python node call, which holds the GIL already, and once more before
+  // the interpreter is finalized. References released after that are leaked.
+  class py_reclaimer {
+  public:
+    static py_reclaimer& instance()
+    {
+      // leaked on purpose: products may outlive any static object
+      static py_reclaimer* reclaimer = new py_reclaimer;
+      return *reclaimer;
+    }
+
+    void defer(PyObject* pyobj)
+    {
+      std::lock_guard lock{m_mutex};
+      if (m_finalized)
+        return;
+      m_pending.push_back(pyobj);
+      m_npending.store(m_pending.size(), std::memory_order_relaxed);
+    }
+
+    // the GIL must be held
+    void release()
+    {
+      if (m_npending.load(std::memory_order_relaxed) == 0)
+        return;
+
+      std::vector<PyObject*> pending;
+      {
+        std::lock_guard lock{m_mutex};
+        pending.swap(m_pending);
+        m_npending.store(0, std::memory_order_relaxed);
+      }
+      for (PyObject* pyobj : pending)
+        Py_DECREF(pyobj);
+    }
+
+    // the GIL must be held; called once, before the interpreter is finalized
+    void finalize()
+    {
+      release();
+      std::lock_guard lock{m_mutex};
+      m_finalized = true;
+    }
+
+  private:
+    std::mutex m_mutex;
+    std::vector<PyObject*> m_pending;
+    std::atomic<std::size_t> m_npending{0};
+    bool m_finalized = false;
+  };
+
+  // take ownership of a Python reference on behalf of a C++ product
+  static std::shared_ptr<void const> py_owner(PyObject* pyobj)
+  {
+    return std::shared_ptr<void const>(
+      pyobj, [](void const* p) { py_reclaimer::instance().defer((PyObject*)p); });
+  }
+
+  // Converters between C++ products and Python objects run inside the Python node, under
+  // the same GIL acquisition as the call. The inputs are received type-erased, because the
+  // product types are only known from the annotations at run time; the queries of the node
+  // carry the expected types, so the graph still matches products by type.
+
+  // convert a C++ product into a new reference, or return nullptr with a Python error set
+  using to_py_t = PyObject* (*)(product_base const&);
+
+  // convert a Python result into a C++ product; steals the reference, throws on error
+  template <typename R>
+  using from_py_t = R (*)(PyObject*);
+
+  template <typename T>
+  static T const* product_as(product_base const& p)
+  {
+    // type_id does not distinguish all C++ types (e.g. smart pointers all compare equal),
+    // so check the exact type before the cast
+    if (p.type() != typeid(T)) {
+      PyErr_Format(PyExc_TypeError,
+                   "product of type \"%s\" received where \"%s\" was expected",
+                   p.type().name(),
+                   typeid(T).name());
+      return nullptr;
+    }
+    return static_cast<T const*>(p.address());
+  }
+
   // callable object managing the callback
   template <size_t N>
   struct py_callback {
     PyObject* m_callable; // owned
+    std::array<to_py_t, N> m_to_py;
 
-    py_callback(PyObject* callable) : m_callable(callable)
+    py_callback(PyObject* callable, std::array<to_py_t, N> const& to_py) :
+      m_callable(callable), m_to_py(to_py)
     {
       // callable is always non-null here (validated before py_callback construction)
       PyGILRAII gil;
       Py_INCREF(m_callable);
     }
-    py_callback(py_callback const& pc) : m_callable(pc.m_callable)
+    py_callback(py_callback const& pc) : m_callable(pc.m_callable), m_to_py(pc.m_to_py)
     {
       // Must hold GIL when manipulating reference counts
       PyGILRAII gil;
@@ -89,6 +249,7 @@ namespace {
         Py_INCREF(pc.m_callable);
         Py_DECREF(m_callable);
         m_callable = pc.m_callable;
+        m_to_py = pc.m_to_py;
       }
       return *this;
     }
@@ -100,15 +261,30 @@ namespace {
       // - Module offloading in interpreter cleanup phase 2
     }
 
+    // convert the arguments and call the Python function; the GIL must be held by the
+    // caller, and the result is returned as a new reference
     template <typename... Args>
-    intptr_t call(Args... args)
+    PyObject* call(Args const&... args)
     {
       static_assert(sizeof...(Args) == N, "Argument count mismatch");
 
-      PyGILRAII gil;
+      py_reclaimer::instance().release();
+
+      product_base const* cargs[] = {&args...};
+      PyObject* pyargs[N]; // owned: the converted objects (or their lifelines)
+      PyObject* views[N];  // borrowed: the arguments as passed to the function
 
-      PyObject* result =
-        PyObject_CallFunctionObjArgs(m_callable, lifeline_transform(args)..., nullptr);
+      size_t nconverted = 0;
+      for (; nconverted < N; ++nconverted) {
+        pyargs[nconverted] = m_to_py[nconverted](*cargs[nconverted]);
+        if (!pyargs[nconverted])
+          break;
+        views[nconverted] = lifeline_transform(pyargs[nconverted]);
+      }
+
+      PyObject* result = nullptr;
+      if (nconverted == N)
+        result = PyObject_Vectorcall(m_callable, views, N, nullptr);
 
       std::string error_msg;
       if (!result) {
@@ -116,74 +292,75 @@ namespace {
           error_msg = "Unknown python error";
       }
 
-      decref_all(args...);
+      for (size_t i = 0; i < nconverted; ++i)
+        Py_DECREF(pyargs[i]);
 
       if (!error_msg.empty()) {
         throw std::runtime_error(error_msg.c_str());
       }
 
-      return (intptr_t)result;
+      return result;
     }
+  };
 
-    template <typename... Args>
-    void callv(Args... args)
-    {
-      static_assert(sizeof...(Args) == N, "Argument count mismatch");
+  // use explicit instatiations to ensure that the function signature can
+  // be derived by the graph builder; the result converter is a function, or a
+  // function object for converters that need state (see record_from_py)
+  template <typename R, typename FromPy = from_py_t<R>>
+  struct py_transform_1 : public py_callback<1> {
+    FromPy m_from_py;
 
+    R operator()(product_base const& arg0)
+    {
       PyGILRAII gil;
-
-      PyObject* result = PyObject_CallFunctionObjArgs(m_callable, (PyObject*)args..., nullptr);
-
-      std::string error_msg;
-      if (!result) {
-        if (!msg_from_py_error(error_msg))
-          error_msg = "Unknown python error";
-      } else
-        Py_DECREF(result);
-
-      decref_all(args...);
-
-      if (!error_msg.empty()) {
-        throw std::runtime_error(error_msg.c_str());
-      }
+      return m_from_py(call(arg0));
     }
+  };
 
-  private:
-    template <typename... Args>
-    void decref_all(Args... args)
+  template <typename R, typename FromPy = from_py_t<R>>
+  struct py_transform_2 : public py_callback<2> {
+    FromPy m_from_py;
+
+    R operator()(product_base const& arg0, product_base const& arg1)
     {
-      // helper to decrement reference counts of N arguments
-      (Py_DECREF((PyObject*)args), ...);
+      PyGILRAII gil;
+      return m_from_py(call(arg0, arg1));
     }
   };
 
-  // use explicit instatiations to ensure that the function signature can
-  // be derived by the graph builder
-  struct py_callback_1 : public py_callback<1> {
-    intptr_t operator()(intptr_t arg0) { return call(arg0); }
-  };
-
-  struct py_callback_2 : public py_callback<2> {
-    intptr_t operator()(intptr_t arg0, intptr_t arg1) { return call(arg0, arg1); }
-  };
+  template <typename R, typename FromPy = from_py_t<R>>
+  struct py_transform_3 : public py_callback<3> {
+    FromPy m_from_py;
 
-  struct py_callback_3 : public py_callback<3> {
-    intptr_t operator()(intptr_t arg0, intptr_t arg1, intptr_t arg2)
+    R operator()(product_base const& arg0, product_base const& arg1, product_base const& arg2)
     {
-      return call(arg0, arg1, arg2);
+      PyGILRAII gil;
+      return m_from_py(call(arg0, arg1, arg2));
     }
   };
 
-  struct py_callback_1v : public py_callback<1> {
-    void operator()(intptr_t arg0) { callv(arg0); }
+  struct py_observer_1 : public py_callback<1> {
+    void operator()(product_base const& arg0)
+    {
+      PyGILRAII gil;
+      Py_DECREF(call(arg0));
+    }
   };
 
-  struct py_callback_2v : public py_callback<2> {
-    void operator()(intptr_t arg0, intptr_t arg1) { callv(arg0, arg1); }
+  struct py_observer_2 : public py_callback<2> {
+    void operator()(product_base const& arg0, product_base const& arg1)
+    {
+      PyGILRAII gil;
+      Py_DECREF(call(arg0, arg1));
+    }
   };
 
-  struct py_callback_3v : public py_callback<3> {
-    void operator()(intptr_t arg0, intptr_t arg1, intptr_t arg2) { callv(arg0, arg1, arg2); }
+  struct py_observer_3 : public py_callback<3> {
+    void operator()(product_base const& arg0, product_base const& arg1, product_base const& arg2)
+    {
+      PyGILRAII gil;
+      Py_DECREF(call(arg0, arg1, arg2));
+    }
   };
 
   static std::vector<std::string> cseq(PyObject* coll)
@@ -325,22 +502,21 @@ namespace {
   }
 
 #define BASIC_CONVERTER(name, cpptype, topy, frompy)                                               \
-  static intptr_t name##_to_py(cpptype a)                                                          \
+  static PyObject* name##_to_py(product_base const& p)                                             \
   {                                                                                                \
-    PyGILRAII gil;                                                                                 \
-    return (intptr_t)topy(a);                                                                      \
+    cpptype const* a = product_as<cpptype>(p);                                                     \
+    return a ? topy(*a) : nullptr;                                                                 \
   }                                                                                                \
                                                                                                    \
-  static cpptype py_to_##name(intptr_t pyobj)                                                      \
+  static cpptype py_to_##name(PyObject* pyobj)                                                     \
   {                                                                                                \
-    PyGILRAII gil;                                                                                 \
-    cpptype i = (cpptype)frompy((PyObject*)pyobj);                                                 \
+    cpptype i = (cpptype)frompy(pyobj);                                                            \
     std::string msg;                                                                               \
     if (msg_from_py_error(msg, true)) {                                                            \
-      Py_DECREF((PyObject*)pyobj);                                                                 \
+      Py_DECREF(pyobj);                                                                            \
       throw std::runtime_error("Python conversion error for type " #name ": " + msg);              \
     }                                                                                              \
-    Py_DECREF((PyObject*)pyobj);                                                                   \
+    Py_DECREF(pyobj);                                                                              \
     return i;                                                                                      \
   }
 
@@ -353,12 +529,17 @@ namespace {
   BASIC_CONVERTER(double, double, PyFloat_FromDouble, PyFloat_AsDouble)
 
 #define VECTOR_CONVERTER(name, cpptype, nptype)                                                    \
-  static intptr_t name##_to_py(std::shared_ptr<std::vector<cpptype>> const& v)                     \
+  static PyObject* name##_to_py(product_base const& p)                                             \
   {                                                                                                \
-    PyGILRAII gil;                                                                                 \
+    auto const* pv = product_as<std::shared_ptr<std::vector<cpptype>>>(p);                         \
+    if (!pv)                                                                                       \
+      return nullptr;                                                                              \
                                                                                                    \
-    if (!v)                                                                                        \
-      return (intptr_t)nullptr;                                                                    \
+    auto const& v = *pv;                                                                           \
+    if (!v) {                                                                                      \
+      PyErr_SetString(PyExc_ValueError, "vector product is null");                                 \
+      return nullptr;                                                                              \
+    }                                                                                              \
                                                                                                    \
     /* use a numpy view with the shared pointer tied up in a lifeline object (note: this */        \
     /* is just a demonstrator; alternatives are still being considered) */                         \
@@ -371,7 +552,7 @@ namespace {
     );                                                                                             \
                                                                                                    \
     if (!np_view)                                                                                  \
-      return (intptr_t)nullptr;                                                                    \
+      return nullptr;                                                                              \
                                                                                                    \
     /* make the data read-only by not making it writable */                                        \
     PyArray_CLEARFLAGS((PyArrayObject*)np_view, NPY_ARRAY_WRITEABLE);                              \
@@ -383,12 +564,12 @@ namespace {
       (py_lifeline_t*)PhlexLifeline_Type.tp_new(&PhlexLifeline_Type, nullptr, nullptr);            \
     if (!pyll) {                                                                                   \
       Py_DECREF(np_view);                                                                          \
-      return (intptr_t)nullptr;                                                                    \
+      return nullptr;                                                                              \
     }                                                                                              \
     pyll->m_source = v;                                                                            \
     pyll->m_view = np_view; /* steals reference */                                                 \
                                                                                                    \
-    return (intptr_t)pyll;                                                                         \
+    return (PyObject*)pyll;                                                                        \
   }
 
   VECTOR_CONVERTER(vint, int, NPY_INT)
@@ -399,46 +580,49 @@ namespace {
   VECTOR_CONVERTER(vdouble, double, NPY_DOUBLE)
 
 #define NUMPY_ARRAY_CONVERTER(name, cpptype, nptype, frompy)                                       \
-  static std::shared_ptr<std::vector<cpptype>> py_to_##name(intptr_t pyobj)                        \
+  static std::shared_ptr<std::vector<cpptype>> py_to_##name(PyObject* pyobj)                       \
   {                                                                                                \
-    PyGILRAII gil;                                                                                 \
-                                                                                                   \
     auto vec = std::make_shared<std::vector<cpptype>>();                                           \
                                                                                                    \
-    /* TODO: because of unresolved ownership issues, copy the full array contents */               \
-    if (PyArray_Check((PyObject*)pyobj)) {                                                         \
-      PyArrayObject* arr = (PyArrayObject*)pyobj;                                                  \
-                                                                                                   \
-      /* TODO: flattening the array here seems to be the only workable solution */                 \
-      npy_intp* dims = PyArray_DIMS(arr);                                                          \
-      int nd = PyArray_NDIM(arr);                                                                  \
-      size_t total = 1;                                                                            \
-      for (int i = 0; i < nd; ++i)                                                                 \
-        total *= static_cast<size_t>(dims[i]);                                                     \
-                                                                                                   \
-      /* copy the array info; note that this assumes C continuity */                               \
-      cpptype* raw = static_cast<cpptype*>(PyArray_DATA(arr));                                     \
-      vec->reserve(total);                                                                         \
-      vec->insert(vec->end(), raw, raw + total);                                                   \
-    } else if (PyList_Check((PyObject*)pyobj)) {                                                   \
-      Py_ssize_t total = PyList_Size((PyObject*)pyobj);                                            \
+    /* an array returned for a list annotation is copied; use an ndarray annotation to */         \
+    /* hand the array itself to C++ (see py_to_array) */                                           \
+    if (PyArray_Check(pyobj)) {                                                                    \
+      /* flattened in C order, after conversion of the dtype and layout where needed */            \
+      PyArrayObject* arr =                                                                         \
+        (PyArrayObject*)PyArray_FROM_OTF(pyobj, nptype, NPY_ARRAY_IN_ARRAY);                       \
+      if (!arr) {                                                                                  \
+        std::string msg;                                                                           \
+        msg_from_py_error(msg, true);                                                              \
+        Py_DECREF(pyobj);                                                                          \
+        throw std::runtime_error("Array conversion error: " + msg);                                \
+      }                                                                                            \
+      cpptype const* raw = static_cast<cpptype const*>(PyArray_DATA(arr));                         \
+      vec->assign(raw, raw + PyArray_SIZE(arr));                                                   \
+      Py_DECREF(arr);                                                                              \
+    } else if (PyList_Check(pyobj)) {                                                              \
+      /* the list may still be referenced, and modified, by concurrently running Python */         \
+      /* code, which the critical section protects against in free-threaded builds */              \
+      PHLEX_BEGIN_CRITICAL_SECTION(pyobj);                                                         \
+      Py_ssize_t total = PyList_GET_SIZE(pyobj);                                                   \
       vec->reserve(total);                                                                         \
       for (Py_ssize_t i = 0; i < total; ++i) {                                                     \
-        PyObject* item = PyList_GetItem((PyObject*)pyobj, i);                                      \
+        PyObject* item = PyList_GET_ITEM(pyobj, i);                                                \
         vec->push_back((cpptype)frompy(item));                                                     \
         if (PyErr_Occurred()) {                                                                    \
           PyErr_Clear();                                                                           \
           break;                                                                                   \
         }                                                                                          \
       }                                                                                            \
+      PHLEX_END_CRITICAL_SECTION();                                                                \
     } else {                                                                                       \
       std::string msg;                                                                             \
       if (msg_from_py_error(msg, true)) {                                                          \
+        Py_DECREF(pyobj);                                                                          \
         throw std::runtime_error("List conversion error: " + msg);                                 \
       }                                                                                            \
     }                                                                                              \
                                                                                                    \
-    Py_DECREF((PyObject*)pyobj);                                                                   \
+    Py_DECREF(pyobj);                                                                              \
     return vec;                                                                                    \
   }
 
@@ -449,479 +633,1683 @@ namespace {
   NUMPY_ARRAY_CONVERTER(vfloat, float, NPY_FLOAT, PyFloat_AsDouble)
   NUMPY_ARRAY_CONVERTER(vdouble, double, NPY_DOUBLE, PyFloat_AsDouble)
 
-} // unnamed namespace
-
-#define INSERT_INPUT_CONVERTER(name, alg, inp)                                                     \
-  mod->ph_module->transform("py" #name "_" + inp + "_" + alg, name##_to_py, concurrency::serial)   \
-    .input_family(product_query{product_specification::create(inp), LAYER})                        \
-    .output_products(alg + "_" + inp + "py")
+  // An array returned for an ndarray annotation becomes the product: the array_view refers
+  // to the array's memory, with its strides, and holds a reference to the array, which is
+  // released through the reclaimer. Arrays of another dtype or byte order, and other
+  // sequences, are converted to an array first. The array is made read-only, as products
+  // are immutable once created.
+  template <typename T, int NPT>
+  static array_view<T> py_to_array(PyObject* pyobj)
+  {
+    PyArrayObject* arr =
+      (PyArrayObject*)PyArray_FROM_OTF(pyobj, NPT, NPY_ARRAY_ALIGNED | NPY_ARRAY_NOTSWAPPED);
+    Py_DECREF(pyobj);
+    if (!arr) {
+      std::string msg;
+      msg_from_py_error(msg, true);
+      throw std::runtime_error("Array conversion error: " + msg);
+    }
 
-#define INSERT_OUTPUT_CONVERTER(name, alg, outp)                                                   \
-  mod->ph_module->transform(#name "py_" + outp + "_" + alg, py_to_##name, concurrency::serial)     \
-    .input_family(product_query{product_specification::create("py" + outp + "_" + alg), LAYER})    \
-    .output_products(outp)
+    PyArray_CLEARFLAGS(arr, NPY_ARRAY_WRITEABLE);
 
-static PyObject* parse_args(PyObject* args,
-                            PyObject* kwds,
-                            std::string& functor_name,
-                            std::vector<std::string>& input_labels,
-                            std::vector<std::string>& input_types,
-                            std::vector<std::string>& output_labels,
-                            std::vector<std::string>& output_types)
-{
-  // Helper function to extract the common names and identifiers needed to insert
-  // any node. (The observer does not require outputs, but they still need to be
-  // retrieved, not ignored, to issue an error message if an output is provided.)
+    int const nd = PyArray_NDIM(arr);
+    std::vector<std::size_t> shape(nd);
+    std::vector<std::ptrdiff_t> strides(nd);
+    for (int i = 0; i < nd; ++i) {
+      shape[i] = static_cast<std::size_t>(PyArray_DIM(arr, i));
+      strides[i] = static_cast<std::ptrdiff_t>(PyArray_STRIDE(arr, i));
+    }
 
-  static char const* kwnames[] = {
-    "callable", "input_family", "output_products", "concurrency", "name", nullptr};
-  PyObject *callable = 0, *input = 0, *output = 0, *concurrency = 0, *pyname = 0;
-  if (!PyArg_ParseTupleAndKeywords(
-        args, kwds, "OO|OOO", (char**)kwnames, &callable, &input, &output, &concurrency, &pyname)) {
-    // error already set by argument parser
-    return nullptr;
+    T const* data = static_cast<T const*>(PyArray_DATA(arr));
+    return array_view<T>{data, std::move(shape), std::move(strides), py_owner((PyObject*)arr)};
   }
 
-  if (concurrency && concurrency != Py_None) {
-    PyErr_SetString(PyExc_TypeError, "only serial concurrency is supported");
-    return nullptr;
-  }
+  // Array products are passed to Python as a read-only view with the original strides; vector
+  // products (e.g. from list annotations or C++) are passed on to the vector converter.
+  template <typename T, int NPT, to_py_t vector_to_py>
+  static PyObject* array_to_py(product_base const& p)
+  {
+    if (p.type() != typeid(array_view<T>))
+      return vector_to_py(p);
+
+    auto const& a = *static_cast<array_view<T> const*>(p.address());
+    int const nd = static_cast<int>(a.ndim());
+    std::vector<npy_intp> dims(nd), strides(nd);
+    for (int i = 0; i < nd; ++i) {
+      dims[i] = static_cast<npy_intp>(a.shape()[i]);
+      strides[i] = static_cast<npy_intp>(a.strides()[i]);
+    }
 
-  if (!callable || !PyCallable_Check(callable)) {
-    PyErr_SetString(PyExc_TypeError, "provided algorithm is not callable");
-    return nullptr;
-  }
+    // flags of 0 make the view read-only; NumPy derives the contiguity flags
+    PyObject* np_view = PyArray_New(
+      &PyArray_Type, nd, dims.data(), NPT, strides.data(), (void*)a.data(), 0, 0, nullptr);
+    if (!np_view)
+      return nullptr;
 
-  // retrieve function name and argument types
-  if (!pyname) {
-    pyname = PyObject_GetAttrString(callable, "__name__");
-    if (!pyname) {
-      // AttributeError already set
+    py_lifeline_t* pyll =
+      (py_lifeline_t*)PhlexLifeline_Type.tp_new(&PhlexLifeline_Type, nullptr, nullptr);
+    if (!pyll) {
+      Py_DECREF(np_view);
       return nullptr;
     }
-  } else {
-    Py_INCREF(pyname);
+    pyll->m_source = std::const_pointer_cast<void>(a.owner());
+    pyll->m_view = np_view; // steals reference
+
+    return (PyObject*)pyll;
   }
 
-  functor_name = PyUnicode_AsUTF8(pyname);
-  Py_DECREF(pyname);
+  // Records (structs of arithmetic fields, see phlex/model/record_layout.hpp) are exchanged
+  // as numpy structured arrays, with a dtype built from the reflected field names, offsets,
+  // and types, so that the elements are not converted one by one. A std::vector of records
+  // is passed to Python as a read-only view of its memory, which is only valid during the
+  // call. A record array returned from Python becomes a record_array product that holds the
+  // (read-only) numpy array; the array is converted only if its dtype differs from the
+  // record layout.
 
-  if (!input) {
-    PyErr_SetString(PyExc_TypeError, "an input is required");
-    return nullptr;
-  }
+  // the dtype of a record, or nullptr with a Python error set; the GIL must be held
+  static PyArray_Descr* record_descr(record_layout const& layout)
+  {
+    static std::mutex mutex;
+    static std::map<record_layout const*, PyArray_Descr*> descrs; // leaked, as are the layouts
+
+    std::lock_guard lock{mutex};
+    if (auto it = descrs.find(&layout); it != descrs.end())
+      return it->second;
+
+    PyObject* names = PyList_New(0);
+    PyObject* formats = PyList_New(0);
+    PyObject* offsets = PyList_New(0);
+    PyObject* spec = PyDict_New();
+    PyArray_Descr* descr = nullptr;
+    bool ok = names && formats && offsets && spec;
+    for (auto const& field : layout.fields) {
+      if (!ok)
+        break;
+      std::string format = field.kind == 'b' ? "?" : "=" + std::string(1, field.kind) +
+                                                       std::to_string(field.size);
+      PyObject* name = PyUnicode_FromString(field.name.c_str());
+      PyObject* fmt = PyUnicode_FromString(format.c_str());
+      PyObject* offset = PyLong_FromSize_t(field.offset);
+      ok = name && fmt && offset && PyList_Append(names, name) == 0 &&
+           PyList_Append(formats, fmt) == 0 && PyList_Append(offsets, offset) == 0;
+      Py_XDECREF(name);
+      Py_XDECREF(fmt);
+      Py_XDECREF(offset);
+    }
+    if (ok) {
+      PyObject* itemsize = PyLong_FromSize_t(layout.size);
+      ok = itemsize && PyDict_SetItemString(spec, "names", names) == 0 &&
+           PyDict_SetItemString(spec, "formats", formats) == 0 &&
+           PyDict_SetItemString(spec, "offsets", offsets) == 0 &&
+           PyDict_SetItemString(spec, "itemsize", itemsize) == 0;
+      Py_XDECREF(itemsize);
+    }
+    if (ok && !PyArray_DescrConverter(spec, &descr))
+      descr = nullptr;
 
-  // Accept any sequence type (list, tuple, custom sequences)
-  PyObject* input_fast = PySequence_Fast(input, "input_family must be a sequence");
-  if (!input_fast) {
-    return nullptr; // TypeError already set by PySequence_Fast
+    Py_XDECREF(names);
+    Py_XDECREF(formats);
+    Py_XDECREF(offsets);
+    Py_XDECREF(spec);
+
+    if (descr)
+      descrs.emplace(&layout, descr);
+    return descr;
   }
 
-  PyObject* output_fast = nullptr;
-  if (output) {
-    output_fast = PySequence_Fast(output, "output_products must be a sequence");
-    if (!output_fast) {
-      Py_DECREF(input_fast);
+  static PyObject* record_to_py(product_base const& p)
+  {
+    record_layout const* layout = nullptr;
+    void const* data = nullptr;
+    std::size_t size = 0;
+    std::shared_ptr<void const> owner;
+    if (p.type() == typeid(record_array)) {
+      auto const& records = *static_cast<record_array const*>(p.address());
+      layout = &records.layout();
+      data = records.data();
+      size = records.size();
+      owner = records.owner();
+    } else if ((layout = find_record_layout(p.type())) && *layout->vector_type == p.type()) {
+      auto const elements = layout->elements(p.address());
+      data = elements.data();
+      size = elements.size() / layout->size;
+    } else {
+      PyErr_Format(
+        PyExc_TypeError, "product of type \"%s\" is not a record array", p.type().name());
       return nullptr;
     }
-  }
 
-  // convert input and output declarations, to be able to pass them to Phlex
-  input_labels = cseq(input_fast);
-  output_labels = cseq(output_fast);
+    PyArray_Descr* descr = record_descr(*layout);
+    if (!descr)
+      return nullptr;
 
-  // Clean up fast sequences
-  Py_DECREF(input_fast);
-  Py_XDECREF(output_fast);
+    // flags of 0 make the view read-only; the reference to the dtype is stolen
+    npy_intp dims[] = {static_cast<npy_intp>(size)};
+    Py_INCREF(descr);
+    PyObject* np_view =
+      PyArray_NewFromDescr(&PyArray_Type, descr, 1, dims, nullptr, (void*)data, 0, nullptr);
+    if (!np_view || !owner)
+      return np_view;
+
+    py_lifeline_t* pyll =
+      (py_lifeline_t*)PhlexLifeline_Type.tp_new(&PhlexLifeline_Type, nullptr, nullptr);
+    if (!pyll) {
+      Py_DECREF(np_view);
+      return nullptr;
+    }
+    pyll->m_source = std::const_pointer_cast<void>(owner);
+    pyll->m_view = np_view; // steals reference
 
-  if (output_labels.size() > 1) {
-    PyErr_SetString(PyExc_TypeError, "only a single output supported");
-    return nullptr;
+    return (PyObject*)pyll;
   }
 
-  // retrieve C++ (matching) types from annotations
-  input_types.reserve(input_labels.size());
-
-  PyObject* sann = PyUnicode_FromString("__annotations__");
-  PyObject* annot = PyObject_GetAttr(callable, sann);
-  if (!annot) {
-    // the callable may be an instance with a __call__ method
-    PyErr_Clear();
-    PyObject* callm = PyObject_GetAttrString(callable, "__call__");
-    if (callm) {
-      annot = PyObject_GetAttr(callm, sann);
-      Py_DECREF(callm);
-    }
-  }
-  Py_DECREF(sann);
+  struct record_from_py {
+    record_layout const* m_layout;
+    PyArray_Descr* m_descr; // owned by the dtype cache
 
-  if (annot && PyDict_Check(annot)) {
-    // Variant guarantees OrderedDict with "return" last
-    PyObject *key, *value;
-    Py_ssize_t pos = 0;
+    record_array operator()(PyObject* pyobj) const
+    {
+      // numpy assigns structured arrays field by position, so check the names first
+      bool ok = true;
+      if (PyArray_Check(pyobj)) {
+        PyArray_Descr* descr = PyArray_DESCR((PyArrayObject*)pyobj);
+        PyObject* names = PyObject_GetAttrString((PyObject*)descr, "names");
+        PyObject* expected = PyObject_GetAttrString((PyObject*)m_descr, "names");
+        ok = names && expected;
+        if (ok && names != Py_None && PyObject_RichCompareBool(names, expected, Py_EQ) != 1) {
+          if (!PyErr_Occurred()) {
+            PyErr_Format(PyExc_TypeError,
+                         "the fields of the returned array do not match those of record \"%s\"",
+                         m_layout->name.c_str());
+          }
+          ok = false;
+        }
+        Py_XDECREF(names);
+        Py_XDECREF(expected);
+      }
 
-    while (PyDict_Next(annot, &pos, &key, &value)) {
-      char const* key_str = PyUnicode_AsUTF8(key);
-      if (strcmp(key_str, "return") == 0) {
-        output_types.push_back(annotation_as_text(value));
-      } else {
-        input_types.push_back(annotation_as_text(value));
+      PyObject* arr = nullptr;
+      if (ok) {
+        Py_INCREF(m_descr); // stolen
+        arr = PyArray_FromAny(pyobj,
+                              m_descr,
+                              1,
+                              1,
+                              NPY_ARRAY_C_CONTIGUOUS | NPY_ARRAY_ALIGNED | NPY_ARRAY_NOTSWAPPED,
+                              nullptr);
+      }
+      Py_DECREF(pyobj);
+      if (!arr) {
+        std::string msg;
+        msg_from_py_error(msg, true);
+        throw std::runtime_error("Record conversion error: " + msg);
       }
+
+      PyArray_CLEARFLAGS((PyArrayObject*)arr, NPY_ARRAY_WRITEABLE);
+      return record_array{*m_layout,
+                          PyArray_DATA((PyArrayObject*)arr),
+                          static_cast<std::size_t>(PyArray_DIM((PyArrayObject*)arr, 0)),
+                          py_owner(arr)};
     }
-  }
-  Py_XDECREF(annot);
+  };
 
-  // ignore None as Python's conventional "void" return, which is meaningless in C++
-  if (output_types.size() == 1 && output_types[0] == "None")
-    output_types.clear();
+  // A batched algorithm is called with one numpy array per input, holding the inputs of up
+  // to max_batch data cells, and returns an array with the result for each of them. Calls
+  // are queued as requests; the thread that finds the batcher idle calls the algorithm on
+  // the queued requests, one batch at a time, until none are left, while the other threads
+  // return immediately with a future (transforms) or wait for it (observers). Batches thus
+  // grow with the number of data cells that become ready while the algorithm runs, without
+  // waiting for a batch to fill up. Only scalar products are batched.
 
-  // if annotations were correct (and correctly parsed), there should be as many
-  // input types as input labels
-  if (input_types.size() != input_labels.size()) {
-    PyErr_Format(PyExc_TypeError,
-                 "number of inputs (%d; %s) does not match number of annotation types (%d; %s)",
-                 input_labels.size(),
-                 stringify(input_labels).c_str(),
-                 input_types.size(),
-                 stringify(input_types).c_str());
-    return nullptr;
+  // copy a scalar product into an array element, or return false with a Python error set
+  using gather_t = bool (*)(product_base const&, void*);
+
+  template <typename T>
+  static bool gather(product_base const& p, void* element)
+  {
+    T const* value = product_as<T>(p);
+    if (!value)
+      return false;
+    *static_cast<T*>(element) = *value;
+    return true;
   }
 
-  // special case of Phlex Variant wrapper
-  PyObject* wrapped_callable = PyObject_GetAttrString(callable, "phlex_callable");
-  if (wrapped_callable) {
-    // PyObject_GetAttrString returns a new reference, which we return
-    callable = wrapped_callable;
-  } else {
-    // No wrapper, use the original callable with incremented reference count
-    PyErr_Clear();
-    Py_INCREF(callable);
+  // append a scalar product to a buffer of raw values; does not need the GIL
+  using buffer_t = void (*)(product_base const&, std::vector<std::byte>&);
+
+  template <typename T>
+  static void buffer(product_base const& p, std::vector<std::byte>& values)
+  {
+    if (p.type() != typeid(T)) {
+      throw std::runtime_error(std::string{"product of type \""} + p.type().name() +
+                               "\" received where \"" + typeid(T).name() + "\" was expected");
+    }
+    auto const* value = static_cast<std::byte const*>(p.address());
+    values.insert(values.end(), value, value + sizeof(T));
   }
 
-  // no common errors detected; actual registration may have more checks
-  return callable;
-}
+  struct batch_input {
+    gather_t gather;
+    buffer_t buffer;
+    int nptype;
+  };
 
-static bool insert_input_converters(py_phlex_module* mod,
-                                    std::string const& cname, // TODO: shared_ptr<PyObject>
-                                    std::vector<std::string> const& input_labels,
-                                    std::vector<std::string> const& input_types)
-{
-  // insert input converter nodes into the graph
-  for (size_t i = 0; i < (size_t)input_labels.size(); ++i) {
-    // TODO: this seems overly verbose and inefficient, but the function needs
-    // to be properly types, so every option is made explicit
-    auto const& inp = input_labels[i];
-    auto const& inp_type = input_types[i];
-
-    if (inp_type == "bool")
-      INSERT_INPUT_CONVERTER(bool, cname, inp);
-    else if (inp_type == "int")
-      INSERT_INPUT_CONVERTER(int, cname, inp);
-    else if (inp_type == "unsigned int")
-      INSERT_INPUT_CONVERTER(uint, cname, inp);
-    else if (inp_type == "long")
-      INSERT_INPUT_CONVERTER(long, cname, inp);
-    else if (inp_type == "unsigned long")
-      INSERT_INPUT_CONVERTER(ulong, cname, inp);
-    else if (inp_type == "float")
-      INSERT_INPUT_CONVERTER(float, cname, inp);
-    else if (inp_type == "double")
-      INSERT_INPUT_CONVERTER(double, cname, inp);
-    else if (inp_type.compare(0, 13, "numpy.ndarray") == 0) {
-      // TODO: these are hard-coded std::vector <-> numpy array mappings, which is
-      // way too simplistic for real use. It only exists for demonstration purposes,
-      // until we have an IDL
-      auto pos = inp_type.rfind("numpy.dtype");
-      if (pos == std::string::npos) {
-        PyErr_Format(
-          PyExc_TypeError, "could not determine dtype of input type \"%s\"", inp_type.c_str());
-        return false;
-      }
+  template <typename R, size_t N>
+  class py_batcher {
+  public:
+    py_batcher(PyObject* callable,
+               std::array<batch_input, N> const& inputs,
+               int nptype,
+               std::size_t max_batch) :
+      m_callable(callable), m_inputs(inputs), m_nptype(nptype), m_max_batch(max_batch)
+    {
+      PyGILRAII gil;
+      Py_INCREF(m_callable);
+    }
+    py_batcher(py_batcher const&) = delete;
+    py_batcher& operator=(py_batcher const&) = delete;
 
-      pos += 18;
-      std::string py_out = cname + "_" + inp + "py";
-
-      if (inp_type.compare(pos, 8, "uint32]]") == 0) {
-        mod->ph_module->transform("pyvuint_" + inp + "_" + cname, vuint_to_py, concurrency::serial)
-          .input_family(product_query{product_specification::create(inp), LAYER})
-          .output_products(py_out);
-      } else if (inp_type.compare(pos, 7, "int32]]") == 0) {
-        mod->ph_module->transform("pyvint_" + inp + "_" + cname, vint_to_py, concurrency::serial)
-          .input_family(product_query{product_specification::create(inp), LAYER})
-          .output_products(py_out);
-      } else if (inp_type.compare(pos, 8, "uint64]]") == 0) { // id.
-        mod->ph_module
-          ->transform("pyvulong_" + inp + "_" + cname, vulong_to_py, concurrency::serial)
-          .input_family(product_query{product_specification::create(inp), LAYER})
-          .output_products(py_out);
-      } else if (inp_type.compare(pos, 7, "int64]]") == 0) { // need not be true
-        mod->ph_module->transform("pyvlong_" + inp + "_" + cname, vlong_to_py, concurrency::serial)
-          .input_family(product_query{product_specification::create(inp), LAYER})
-          .output_products(py_out);
-      } else if (inp_type.compare(pos, 9, "float32]]") == 0) {
-        mod->ph_module
-          ->transform("pyvfloat_" + inp + "_" + cname, vfloat_to_py, concurrency::serial)
-          .input_family(product_query{product_specification::create(inp), LAYER})
-          .output_products(py_out);
-      } else if (inp_type.compare(pos, 9, "float64]]") == 0) {
-        mod->ph_module
-          ->transform("pyvdouble_" + inp + "_" + cname, vdouble_to_py, concurrency::serial)
-          .input_family(product_query{product_specification::create(inp), LAYER})
-          .output_products(py_out);
-      } else {
-        PyErr_Format(PyExc_TypeError, "unsupported array input type \"%s\"", inp_type.c_str());
-        return false;
+    // the products must stay alive until the future is ready
+    template <typename... Args>
+    async_future<R> submit(Args const&... args)
+    {
+      static_assert(sizeof...(Args) == N, "Argument count mismatch");
+
+      auto request = std::make_unique<batch_request>(batch_request{{&args...}, {}});
+      async_future<R> result = request->promise.get_future();
+      {
+        std::lock_guard lock{m_mutex};
+        m_queue.push_back(std::move(request));
+        if (m_busy)
+          return result;
+        m_busy = true;
       }
-    } else if (inp_type == "list[int]") {
-      std::string py_out = cname + "_" + inp + "py";
-      mod->ph_module->transform("pyvint_" + inp + "_" + cname, vint_to_py, concurrency::serial)
-        .input_family(product_query{product_specification::create(inp), LAYER})
-        .output_products(py_out);
-    } else if (inp_type == "list[unsigned int]" || inp_type == "list['unsigned int']") {
-      std::string py_out = cname + "_" + inp + "py";
-      mod->ph_module->transform("pyvuint_" + inp + "_" + cname, vuint_to_py, concurrency::serial)
-        .input_family(product_query{product_specification::create(inp), LAYER})
-        .output_products(py_out);
-    } else if (inp_type == "list[long]" || inp_type == "list['long']") {
-      std::string py_out = cname + "_" + inp + "py";
-      mod->ph_module->transform("pyvlong_" + inp + "_" + cname, vlong_to_py, concurrency::serial)
-        .input_family(product_query{product_specification::create(inp), LAYER})
-        .output_products(py_out);
-    } else if (inp_type == "list[unsigned long]" || inp_type == "list['unsigned long']") {
-      std::string py_out = cname + "_" + inp + "py";
-      mod->ph_module->transform("pyvulong_" + inp + "_" + cname, vulong_to_py, concurrency::serial)
-        .input_family(product_query{product_specification::create(inp), LAYER})
-        .output_products(py_out);
-    } else if (inp_type == "list[float]") {
-      std::string py_out = cname + "_" + inp + "py";
-      mod->ph_module->transform("pyvfloat_" + inp + "_" + cname, vfloat_to_py, concurrency::serial)
-        .input_family(product_query{product_specification::create(inp), LAYER})
-        .output_products(py_out);
-    } else if (inp_type == "list[double]" || inp_type == "list['double']") {
-      std::string py_out = cname + "_" + inp + "py";
-      mod->ph_module
-        ->transform("pyvdouble_" + inp + "_" + cname, vdouble_to_py, concurrency::serial)
-        .input_family(product_query{product_specification::create(inp), LAYER})
-        .output_products(py_out);
-    } else {
-      PyErr_Format(PyExc_TypeError, "unsupported input type \"%s\"", inp_type.c_str());
-      return false;
+      drain();
+      return result;
     }
-  }
-
-  return true;
-}
 
-static PyObject* md_transform(py_phlex_module* mod, PyObject* args, PyObject* kwds)
-{
-  // Register a python algorithm by adding the necessary intermediate converter
-  // nodes going from C++ to PyObject* and back.
+  private:
+    struct batch_request {
+      std::array<product_base const*, N> args;
+      async_promise<R> promise;
+    };
+    using batch_t = std::vector<std::unique_ptr<batch_request>>;
 
-  std::string cname;
-  std::vector<std::string> input_labels, input_types, output_labels, output_types;
-  PyObject* callable =
-    parse_args(args, kwds, cname, input_labels, input_types, output_labels, output_types);
-  if (!callable)
-    return nullptr; // error already set
+    void drain()
+    {
+      while (true) {
+        batch_t batch;
+        {
+          std::lock_guard lock{m_mutex};
+          if (m_queue.empty()) {
+            m_busy = false;
+            return;
+          }
+          auto const n = static_cast<std::ptrdiff_t>(std::min(m_queue.size(), m_max_batch));
+          std::move(m_queue.begin(), m_queue.begin() + n, std::back_inserter(batch));
+          m_queue.erase(m_queue.begin(), m_queue.begin() + n);
+        }
 
-  if (output_types.empty()) {
-    PyErr_Format(PyExc_TypeError, "a transform should have an output type");
-    Py_DECREF(callable);
-    return nullptr;
-  }
+        // the GIL is taken per batch, so that other Python algorithms can run in between
+        std::string error_msg;
+        {
+          PyGILRAII gil;
+          py_reclaimer::instance().release();
+          if (!call(batch) && !msg_from_py_error(error_msg))
+            error_msg = "Unknown python error";
+        }
 
-  // TODO: only support single output type for now, as there has to be a mapping
-  // onto a std::tuple otherwise, which is a typed object, thus complicating the
-  // template instantiation
-  std::string output = output_labels[0];
-  std::string output_type = output_types[0];
+        if (!error_msg.empty()) {
+          auto error = std::make_exception_ptr(std::runtime_error(error_msg));
+          for (auto& request : batch)
+            request->promise.set_exception(error);
+        }
+      }
+    }
 
-  if (!insert_input_converters(mod, cname, input_labels, input_types)) {
-    Py_DECREF(callable);
-    return nullptr; // error already set
+    // call the algorithm and fulfill the promises of the batch; the GIL must be held
+    bool call(batch_t& batch)
+    {
+      npy_intp n = static_cast<npy_intp>(batch.size());
+
+      PyObject* arrays[N] = {}; // owned
+      bool ok = true;
+      for (size_t k = 0; ok && k < N; ++k) {
+        arrays[k] = PyArray_SimpleNew(1, &n, m_inputs[k].nptype);
+        ok = arrays[k] != nullptr;
+        for (npy_intp i = 0; ok && i < n; ++i) {
+          void* element = PyArray_GETPTR1((PyArrayObject*)arrays[k], i);
+          ok = m_inputs[k].gather(*batch[i]->args[k], element);
+        }
+      }
+
+      PyObject* result = ok ? PyObject_Vectorcall(m_callable, arrays, N, nullptr) : nullptr;
+      for (size_t k = 0; k < N; ++k)
+        Py_XDECREF(arrays[k]);
+
+      if (!result)
+        return false;
+
+      if constexpr (std::is_void_v<R>) {
+        Py_DECREF(result);
+        for (auto& request : batch)
+          request->promise.set_value();
+      } else {
+        PyArrayObject* arr = (PyArrayObject*)PyArray_FROM_OTF(
+          result, m_nptype, NPY_ARRAY_ALIGNED | NPY_ARRAY_NOTSWAPPED);
+        Py_DECREF(result);
+        if (!arr)
+          return false;
+
+        if (PyArray_NDIM(arr) != 1 || PyArray_DIM(arr, 0) != n) {
+          PyErr_Format(PyExc_ValueError,
+                       "batched algorithm returned %zd results for %zd data cells",
+                       (Py_ssize_t)PyArray_SIZE(arr),
+                       (Py_ssize_t)n);
+          Py_DECREF(arr);
+          return false;
+        }
+
+        for (npy_intp i = 0; i < n; ++i)
+          batch[i]->promise.set_value(*static_cast<R const*>(PyArray_GETPTR1(arr, i)));
+        Py_DECREF(arr);
+      }
+
+      return true;
+    }
+
+    PyObject* m_callable; // owned, leaks with the batcher (see py_callback)
+    std::array<batch_input, N> m_inputs;
+    int m_nptype; // of the results
+    std::size_t m_max_batch;
+
+    std::mutex m_mutex;
+    std::deque<std::unique_ptr<batch_request>> m_queue;
+    bool m_busy = false;
+  };
+
+  // batched transforms are asynchronous: the node is released once the request is queued
+  template <typename R>
+  struct py_batch_transform_1 {
+    py_batcher<R, 1>* m_batcher;
+
+    async_future<R> operator()(product_base const& arg0) { return m_batcher->submit(arg0); }
+  };
+
+  template <typename R>
+  struct py_batch_transform_2 {
+    py_batcher<R, 2>* m_batcher;
+
+    async_future<R> operator()(product_base const& arg0, product_base const& arg1)
+    {
+      return m_batcher->submit(arg0, arg1);
+    }
+  };
+
+  template <typename R>
+  struct py_batch_transform_3 {
+    py_batcher<R, 3>* m_batcher;
+
+    async_future<R> operator()(product_base const& arg0,
+                              product_base const& arg1,
+                              product_base const& arg2)
+    {
+      return m_batcher->submit(arg0, arg1, arg2);
+    }
+  };
+
+  struct py_batch_observer_1 {
+    py_batcher<void, 1>* m_batcher;
+
+    void operator()(product_base const& arg0) { m_batcher->submit(arg0).get(); }
+  };
+
+  struct py_batch_observer_2 {
+    py_batcher<void, 2>* m_batcher;
+
+    void operator()(product_base const& arg0, product_base const& arg1)
+    {
+      m_batcher->submit(arg0, arg1).get();
+    }
+  };
+
+  struct py_batch_observer_3 {
+    py_batcher<void, 3>* m_batcher;
+
+    void operator()(product_base const& arg0, product_base const& arg1, product_base const& arg2)
+    {
+      m_batcher->submit(arg0, arg1, arg2).get();
+    }
+  };
+
+  // A Python fold is called with the value accumulated so far for its partition and one
+  // numpy array per input, and returns the new accumulated value, e.g.
+  //
+  //   def total(acc: int, values: npt.NDArray[np.int32]) -> int:
+  //       return acc + int(values.sum())
+  //
+  // The input values are buffered per partition, without the GIL, and the fold is called
+  // once per max_batch data cells (or once per partition if no batch size is given), so
+  // that the GIL is taken once per batch rather than once per data cell. When the
+  // partition is complete, the remaining values are folded in and the accumulated value is
+  // converted to the fold product. Calls for the same partition are serialized, and the
+  // order of the values within and across batches is unspecified.
+  template <typename R, typename FromPy, size_t N>
+  class py_folder {
+  public:
+    py_folder(PyObject* callable,
+              std::array<batch_input, N> const& inputs,
+              FromPy from_py,
+              PyObject* init,
+              std::size_t max_batch) :
+      m_callable(callable),
+      m_inputs(inputs),
+      m_from_py(from_py),
+      m_init(init),
+      m_max_batch(max_batch)
+    {
+      PyGILRAII gil;
+      Py_INCREF(m_callable);
+      Py_INCREF(m_init);
+    }
+    py_folder(py_folder const&) = delete;
+    py_folder& operator=(py_folder const&) = delete;
+
+    // the fold object of one partition
+    class accumulator {
+    public:
+      explicit accumulator(py_folder const* folder) : m_folder(folder)
+      {
+        PyGILRAII gil;
+        m_value = folder->m_init;
+        Py_INCREF(m_value);
+      }
+      accumulator(accumulator const&) = delete;
+      accumulator& operator=(accumulator const&) = delete;
+      ~accumulator()
+      {
+        // the value is only left if the partition was not completed
+        if (m_value)
+          py_reclaimer::instance().defer(m_value);
+      }
+
+      template <typename... Args>
+      void add(Args const&... args)
+      {
+        static_assert(sizeof...(Args) == N, "Argument count mismatch");
+
+        product_base const* cargs[] = {&args...};
+        std::lock_guard lock{m_mutex};
+        for (size_t k = 0; k < N; ++k)
+          m_folder->m_inputs[k].buffer(*cargs[k], m_buffers[k]);
+        if (++m_count == m_folder->m_max_batch)
+          fold_buffered();
+      }
+
+      friend R send(accumulator const& acc) { return acc.finish(); }
+
+    private:
+      // fold in the remaining values and convert the result; called once all data cells
+      // of the partition have been added
+      R finish() const
+      {
+        std::lock_guard lock{m_mutex};
+        if (m_count)
+          fold_buffered();
+
+        PyGILRAII gil;
+        return m_folder->m_from_py(std::exchange(m_value, nullptr)); // steals the reference
+      }
+
+      // the mutex must be held
+      void fold_buffered() const
+      {
+        std::string error_msg;
+        {
+          PyGILRAII gil;
+          py_reclaimer::instance().release();
+          if (!m_folder->call(m_value, m_buffers, m_count) && !msg_from_py_error(error_msg))
+            error_msg = "Unknown python error";
+        }
+
+        for (auto& values : m_buffers)
+          values.clear();
+        m_count = 0;
+
+        if (!error_msg.empty())
+          throw std::runtime_error(error_msg);
+      }
+
+      py_folder const* m_folder;
+
+      // sending the result folds in the remaining values, hence mutable
+      mutable std::mutex m_mutex;
+      mutable std::array<std::vector<std::byte>, N> m_buffers;
+      mutable std::size_t m_count = 0;
+      mutable PyObject* m_value; // owned
+    };
+
+  private:
+    // call the fold on the buffered values and replace the accumulated value with the
+    // result; the GIL must be held
+    bool call(PyObject*& value,
+              std::array<std::vector<std::byte>, N> const& buffers,
+              std::size_t count) const
+    {
+      npy_intp n = static_cast<npy_intp>(count);
+
+      PyObject* pyargs[N + 1] = {value}; // arrays owned
+      bool ok = true;
+      for (size_t k = 0; ok && k < N; ++k) {
+        pyargs[k + 1] = PyArray_SimpleNew(1, &n, m_inputs[k].nptype);
+        ok = pyargs[k + 1] != nullptr;
+        if (ok)
+          std::memcpy(
+            PyArray_DATA((PyArrayObject*)pyargs[k + 1]), buffers[k].data(), buffers[k].size());
+      }
+
+      PyObject* result = ok ? PyObject_Vectorcall(m_callable, pyargs, N + 1, nullptr) : nullptr;
+      for (size_t k = 0; k < N; ++k)
+        Py_XDECREF(pyargs[k + 1]);
+
+      if (!result)
+        return false;
+
+      Py_DECREF(value);
+      value = result;
+      return true;
+    }
+
+    PyObject* m_callable; // owned, leaks with the folder (see py_callback)
+    std::array<batch_input, N> m_inputs;
+    FromPy m_from_py;
+    PyObject* m_init; // owned, as m_callable
+    std::size_t m_max_batch;
+  };
+
+  // the fold objects carry the state, so the fold functions need none
+  template <typename Folder>
+  struct py_fold_1 {
+    void operator()(typename Folder::accumulator& acc, product_base const& arg0) const
+    {
+      acc.add(arg0);
+    }
+  };
+
+  template <typename Folder>
+  struct py_fold_2 {
+    void operator()(typename Folder::accumulator& acc,
+                    product_base const& arg0,
+                    product_base const& arg1) const
+    {
+      acc.add(arg0, arg1);
+    }
+  };
+
+  template <typename Folder>
+  struct py_fold_3 {
+    void operator()(typename Folder::accumulator& acc,
+                    product_base const& arg0,
+                    product_base const& arg1,
+                    product_base const& arg2) const
+    {
+      acc.add(arg0, arg1, arg2);
+    }
+  };
+
+  // A Python provider is called with the number of the data cell (e.g. the event number)
+  // and returns the product for it.
+  template <typename R, typename FromPy = from_py_t<R>>
+  struct py_provider {
+    PyObject* m_callable; // owned, leaks with the provider (see py_callback)
+    FromPy m_from_py;
+
+    R operator()(data_cell_index const& index) const
+    {
+      PyGILRAII gil;
+      py_reclaimer::instance().release();
+
+      PyObject* number = PyLong_FromSize_t(index.number());
+      PyObject* result = number ? PyObject_CallOneArg(m_callable, number) : nullptr;
+      Py_XDECREF(number);
+      if (!result) {
+        std::string error_msg;
+        if (!msg_from_py_error(error_msg))
+          error_msg = "Unknown python error";
+        throw std::runtime_error(error_msg);
+      }
+
+      return m_from_py(result);
+    }
+  };
+
+} // unnamed namespace
+
+void phlex::experimental::release_python_references() { py_reclaimer::instance().finalize(); }
+
+static bool parse_concurrency(PyObject* pyconc, concurrency& conc)
+{
+  // Python algorithms run serially unless requested otherwise: None (the default) or 1
+  // for serial, a larger integer for a maximum number of concurrent calls, or the
+  // string "unlimited"
+  conc = concurrency::serial;
+  if (!pyconc || pyconc == Py_None)
+    return true;
+
+  if (PyUnicode_Check(pyconc)) {
+    char const* cstr = PyUnicode_AsUTF8(pyconc);
+    if (cstr && strcmp(cstr, "unlimited") == 0) {
+      conc = concurrency::unlimited;
+      return true;
+    }
+  } else if (PyLong_Check(pyconc) && !PyBool_Check(pyconc)) {
+    long n = PyLong_AsLong(pyconc);
+    if (0 < n) {
+      conc = concurrency{static_cast<std::size_t>(n)};
+      return true;
+    }
   }
 
-  // register Python transform
-  std::string py_out = "py" + output + "_" + cname;
-  if (input_labels.size() == 1) {
-    auto* pyc = new py_callback_1{callable}; // TODO: leaks, but has program lifetime
-    mod->ph_module->transform(cname, *pyc, concurrency::serial)
-      .input_family(
-        product_query{product_specification::create(cname + "_" + input_labels[0] + "py"), LAYER})
-      .output_products(py_out);
-    Py_DECREF(callable);
-  } else if (input_labels.size() == 2) {
-    auto* pyc = new py_callback_2{callable};
-    mod->ph_module->transform(cname, *pyc, concurrency::serial)
-      .input_family(
-        product_query{product_specification::create(cname + "_" + input_labels[0] + "py"), LAYER},
-        product_query{product_specification::create(cname + "_" + input_labels[1] + "py"), LAYER})
-      .output_products(py_out);
-    Py_DECREF(callable);
-  } else if (input_labels.size() == 3) {
-    auto* pyc = new py_callback_3{callable};
-    mod->ph_module->transform(cname, *pyc, concurrency::serial)
-      .input_family(
-        product_query{product_specification::create(cname + "_" + input_labels[0] + "py"), LAYER},
-        product_query{product_specification::create(cname + "_" + input_labels[1] + "py"), LAYER},
-        product_query{product_specification::create(cname + "_" + input_labels[2] + "py"), LAYER})
-      .output_products(py_out);
-    Py_DECREF(callable);
+  if (!PyErr_Occurred()) {
+    PyErr_SetString(PyExc_ValueError,
+                    "concurrency should be a positive integer, \"unlimited\", or None");
+  }
+  return false;
+}
+
+static bool parse_batch(PyObject* pybatch, std::size_t& batch)
+{
+  // Python algorithms are called per data cell unless a maximum batch size is given
+  batch = 0;
+  if (!pybatch || pybatch == Py_None)
+    return true;
+
+  if (PyLong_Check(pybatch) && !PyBool_Check(pybatch)) {
+    long n = PyLong_AsLong(pybatch);
+    if (0 < n) {
+      batch = static_cast<std::size_t>(n);
+      return true;
+    }
+  }
+
+  if (!PyErr_Occurred())
+    PyErr_SetString(PyExc_ValueError, "batch should be a positive integer or None");
+  return false;
+}
+
+static bool callable_name(PyObject* callable, PyObject* pyname, std::string& functor_name)
+{
+  // the name of the node is given, or taken from the callable
+  if (!pyname) {
+    pyname = PyObject_GetAttrString(callable, "__name__");
+    if (!pyname) {
+      // AttributeError already set
+      return false;
+    }
   } else {
-    PyErr_SetString(PyExc_TypeError, "unsupported number of inputs");
-    Py_DECREF(callable);
+    Py_INCREF(pyname);
+  }
+
+  char const* cname = PyUnicode_AsUTF8(pyname);
+  if (cname)
+    functor_name = cname;
+  Py_DECREF(pyname);
+  return cname != nullptr;
+}
+
+static void callable_annotations(PyObject* callable,
+                                 std::vector<std::string>& input_types,
+                                 std::vector<std::string>& output_types)
+{
+  // retrieve C++ (matching) types from annotations
+  PyObject* sann = PyUnicode_FromString("__annotations__");
+  PyObject* annot = PyObject_GetAttr(callable, sann);
+  if (!annot) {
+    // the callable may be an instance with a __call__ method
+    PyErr_Clear();
+    PyObject* callm = PyObject_GetAttrString(callable, "__call__");
+    if (callm) {
+      annot = PyObject_GetAttr(callm, sann);
+      Py_DECREF(callm);
+    }
+  }
+  Py_DECREF(sann);
+
+  if (annot && PyDict_Check(annot)) {
+    // Variant guarantees OrderedDict with "return" last
+    PyObject *key, *value;
+    Py_ssize_t pos = 0;
+
+    while (PyDict_Next(annot, &pos, &key, &value)) {
+      char const* key_str = PyUnicode_AsUTF8(key);
+      if (strcmp(key_str, "return") == 0) {
+        output_types.push_back(annotation_as_text(value));
+      } else {
+        input_types.push_back(annotation_as_text(value));
+      }
+    }
+  }
+  Py_XDECREF(annot);
+  PyErr_Clear();
+
+  // ignore None as Python's conventional "void" return, which is meaningless in C++
+  if (output_types.size() == 1 && output_types[0] == "None")
+    output_types.clear();
+}
+
+static PyObject* unwrap_callable(PyObject* callable)
+{
+  // special case of Phlex Variant wrapper
+  PyObject* wrapped_callable = PyObject_GetAttrString(callable, "phlex_callable");
+  if (wrapped_callable) {
+    // PyObject_GetAttrString returns a new reference, which we return
+    return wrapped_callable;
+  }
+
+  // No wrapper, use the original callable with incremented reference count
+  PyErr_Clear();
+  Py_INCREF(callable);
+  return callable;
+}
+
+static bool parse_layer(PyObject* pylayer, std::string& layer)
+{
+  // the layer of the input products (or the output products, for providers)
+  layer = LAYER;
+  if (!pylayer || pylayer == Py_None)
+    return true;
+
+  char const* cstr = PyUnicode_Check(pylayer) ? PyUnicode_AsUTF8(pylayer) : nullptr;
+  if (!cstr) {
+    if (!PyErr_Occurred())
+      PyErr_SetString(PyExc_TypeError, "layer should be a string or None");
+    return false;
+  }
+  layer = cstr;
+  return true;
+}
+
+static PyObject* parse_args(PyObject* args,
+                            PyObject* kwds,
+                            std::string& functor_name,
+                            std::vector<std::string>& input_labels,
+                            std::vector<std::string>& input_types,
+                            std::vector<std::string>& output_labels,
+                            std::vector<std::string>& output_types,
+                            concurrency& conc,
+                            std::size_t& batch,
+                            std::string& layer,
+                            std::size_t accumulators = 0)
+{
+  // Helper function to extract the common names and identifiers needed to insert
+  // any node. (The observer does not require outputs, but they still need to be
+  // retrieved, not ignored, to issue an error message if an output is provided.)
+  // The first <accumulators> parameters of the callable are not inputs (e.g. the
+  // accumulated value of a fold), and their annotations are dropped.
+
+  static char const* kwnames[] = {"callable",
+                                  "input_family",
+                                  "output_products",
+                                  "concurrency",
+                                  "name",
+                                  "batch",
+                                  "layer",
+                                  nullptr};
+  PyObject *callable = 0, *input = 0, *output = 0, *pyconc = 0, *pyname = 0, *pybatch = 0,
+           *pylayer = 0;
+  if (!PyArg_ParseTupleAndKeywords(args,
+                                   kwds,
+                                   "OO|OOOOO",
+                                   (char**)kwnames,
+                                   &callable,
+                                   &input,
+                                   &output,
+                                   &pyconc,
+                                   &pyname,
+                                   &pybatch,
+                                   &pylayer)) {
+    // error already set by argument parser
     return nullptr;
   }
 
-  // insert output converter node into the graph (TODO: same as above; these
-  // are explicit b/c of the templates only)
-  if (output_type == "bool")
-    INSERT_OUTPUT_CONVERTER(bool, cname, output);
-  else if (output_type == "int")
-    INSERT_OUTPUT_CONVERTER(int, cname, output);
-  else if (output_type == "unsigned int")
-    INSERT_OUTPUT_CONVERTER(uint, cname, output);
-  else if (output_type == "long")
-    INSERT_OUTPUT_CONVERTER(long, cname, output);
-  else if (output_type == "unsigned long")
-    INSERT_OUTPUT_CONVERTER(ulong, cname, output);
-  else if (output_type == "float")
-    INSERT_OUTPUT_CONVERTER(float, cname, output);
-  else if (output_type == "double")
-    INSERT_OUTPUT_CONVERTER(double, cname, output);
-  else if (output_type.compare(0, 13, "numpy.ndarray") == 0) {
-    // TODO: just like for input types, these are hard-coded, but should be handled by
-    // an IDL instead.
-    auto pos = output_type.rfind("numpy.dtype");
+  if (!parse_concurrency(pyconc, conc) || !parse_batch(pybatch, batch) ||
+      !parse_layer(pylayer, layer))
+    return nullptr; // error already set
+
+  // batches form from the data cells that are in flight together, and the batches
+  // themselves are processed one at a time; folds always buffer their inputs
+  bool const buffered = batch || accumulators;
+  if (buffered && (!pyconc || pyconc == Py_None))
+    conc = concurrency::unlimited;
+
+  if (!callable || !PyCallable_Check(callable)) {
+    PyErr_SetString(PyExc_TypeError, "provided algorithm is not callable");
+    return nullptr;
+  }
+
+  // retrieve function name and argument types
+  if (!callable_name(callable, pyname, functor_name))
+    return nullptr; // error already set
+
+  if (!buffered && conc.value != concurrency::serial.value && python_gil_enabled()) {
+    // allowed, as the C++ side (converters, Python code that releases the GIL, such
+    // as NumPy) still benefits, but most likely not what the user intended
+    if (PyErr_WarnFormat(PyExc_RuntimeWarning,
+                         1,
+                         "algorithm \"%s\" requests concurrency, but the GIL is enabled: "
+                         "its Python code will run one call at a time",
+                         functor_name.c_str()) < 0)
+      return nullptr; // warning turned into an error
+  }
+
+  if (!input) {
+    PyErr_SetString(PyExc_TypeError, "an input is required");
+    return nullptr;
+  }
+
+  // Accept any sequence type (list, tuple, custom sequences)
+  PyObject* input_fast = PySequence_Fast(input, "input_family must be a sequence");
+  if (!input_fast) {
+    return nullptr; // TypeError already set by PySequence_Fast
+  }
+
+  PyObject* output_fast = nullptr;
+  if (output) {
+    output_fast = PySequence_Fast(output, "output_products must be a sequence");
+    if (!output_fast) {
+      Py_DECREF(input_fast);
+      return nullptr;
+    }
+  }
+
+  // convert input and output declarations, to be able to pass them to Phlex
+  input_labels = cseq(input_fast);
+  output_labels = cseq(output_fast);
+
+  // Clean up fast sequences
+  Py_DECREF(input_fast);
+  Py_XDECREF(output_fast);
+
+  if (output_labels.size() > 1) {
+    PyErr_SetString(PyExc_TypeError, "only a single output supported");
+    return nullptr;
+  }
+
+  input_types.reserve(input_labels.size() + accumulators);
+  callable_annotations(callable, input_types, output_types);
+
+  // if annotations were correct (and correctly parsed), there should be as many
+  // input types as input labels
+  if (input_types.size() != input_labels.size() + accumulators) {
+    PyErr_Format(PyExc_TypeError,
+                 "number of inputs (%d; %s) does not match number of annotation types (%d; %s)",
+                 input_labels.size() + accumulators,
+                 stringify(input_labels).c_str(),
+                 input_types.size(),
+                 stringify(input_types).c_str());
+    return nullptr;
+  }
+  input_types.erase(input_types.begin(), input_types.begin() + accumulators);
+
+  // no common errors detected; actual registration may have more checks
+  return unwrap_callable(callable);
+}
+
+static bool vector_type(std::string const& type,
+                        char const* direction,
+                        std::string& vtype,
+                        bool& is_array)
+{
+  // TODO: these are hard-coded std::vector <-> numpy array mappings, which is way too
+  // simplistic for real use. It only exists for demonstration purposes, until we have an IDL
+  vtype.clear();
+  is_array = false;
+  if (type.compare(0, 13, "numpy.ndarray") == 0) {
+    auto pos = type.rfind("numpy.dtype");
     if (pos == std::string::npos) {
       PyErr_Format(
-        PyExc_TypeError, "could not determine dtype of input type \"%s\"", output_type.c_str());
-      return nullptr;
+        PyExc_TypeError, "could not determine dtype of %s type \"%s\"", direction, type.c_str());
+      return false;
     }
 
-    pos += 18;
-
-    auto py_in = "py" + output + "_" + cname;
-    if (output_type.compare(pos, 7, "int32]]") == 0) {
-      mod->ph_module->transform("pyvint_" + output + "_" + cname, py_to_vint, concurrency::serial)
-        .input_family(product_query{product_specification::create(py_in), LAYER})
-        .output_products(output);
-    } else if (output_type.compare(pos, 8, "uint32]]") == 0) {
-      mod->ph_module->transform("pyvuint_" + output + "_" + cname, py_to_vuint, concurrency::serial)
-        .input_family(product_query{product_specification::create(py_in), LAYER})
-        .output_products(output);
-    } else if (output_type.compare(pos, 7, "int64]]") == 0) { // need not be true
-      mod->ph_module->transform("pyvlong_" + output + "_" + cname, py_to_vlong, concurrency::serial)
-        .input_family(product_query{product_specification::create(py_in), LAYER})
-        .output_products(output);
-    } else if (output_type.compare(pos, 8, "uint64]]") == 0) { // id.
-      mod->ph_module
-        ->transform("pyvulong_" + output + "_" + cname, py_to_vulong, concurrency::serial)
-        .input_family(product_query{product_specification::create(py_in), LAYER})
-        .output_products(output);
-    } else if (output_type.compare(pos, 9, "float32]]") == 0) {
-      mod->ph_module
-        ->transform("pyvfloat_" + output + "_" + cname, py_to_vfloat, concurrency::serial)
-        .input_family(product_query{product_specification::create(py_in), LAYER})
-        .output_products(output);
-    } else if (output_type.compare(pos, 9, "float64]]") == 0) {
-      mod->ph_module
-        ->transform("pyvdouble_" + output + "_" + cname, py_to_vdouble, concurrency::serial)
-        .input_family(product_query{product_specification::create(py_in), LAYER})
-        .output_products(output);
-    } else {
-      PyErr_Format(PyExc_TypeError, "unsupported array output type \"%s\"", output_type.c_str());
-      return nullptr;
+    is_array = true;
+    pos += 18; // skips "numpy.dtype[numpy."
+    if (type.compare(pos, 8, "uint32]]") == 0)
+      vtype = "vuint";
+    else if (type.compare(pos, 7, "int32]]") == 0)
+      vtype = "vint";
+    else if (type.compare(pos, 8, "uint64]]") == 0) // id.
+      vtype = "vulong";
+    else if (type.compare(pos, 7, "int64]]") == 0) // need not be true
+      vtype = "vlong";
+    else if (type.compare(pos, 9, "float32]]") == 0)
+      vtype = "vfloat";
+    else if (type.compare(pos, 9, "float64]]") == 0)
+      vtype = "vdouble";
+    else {
+      PyErr_Format(PyExc_TypeError, "unsupported array %s type \"%s\"", direction, type.c_str());
+      return false;
     }
-  } else if (output_type == "list[int]") {
-    auto py_in = "py" + output + "_" + cname;
-    mod->ph_module->transform("pyvint_" + output + "_" + cname, py_to_vint, concurrency::serial)
-      .input_family(product_query{product_specification::create(py_in), LAYER})
-      .output_products(output);
-  } else if (output_type == "list[unsigned int]" || output_type == "list['unsigned int']") {
-    auto py_in = "py" + output + "_" + cname;
-    mod->ph_module->transform("pyvuint_" + output + "_" + cname, py_to_vuint, concurrency::serial)
-      .input_family(product_query{product_specification::create(py_in), LAYER})
+  } else if (type == "list[int]")
+    vtype = "vint";
+  else if (type == "list[unsigned int]" || type == "list['unsigned int']")
+    vtype = "vuint";
+  else if (type == "list[long]" || type == "list['long']")
+    vtype = "vlong";
+  else if (type == "list[unsigned long]" || type == "list['unsigned long']")
+    vtype = "vulong";
+  else if (type == "list[float]")
+    vtype = "vfloat";
+  else if (type == "list[double]" || type == "list['double']")
+    vtype = "vdouble";
+
+  return true;
+}
+
+static record_layout const* record_type(std::string const& type)
+{
+  // records are annotated by their registered name, e.g. list['track']
+  if (type.size() < 6 || type.compare(0, 5, "list[") != 0 || type.back() != ']')
+    return nullptr;
+
+  std::string name = type.substr(5, type.size() - 6);
+  if (name.size() >= 2 && (name.front() == '\'' || name.front() == '"') &&
+      name.back() == name.front())
+    name = name.substr(1, name.size() - 2);
+  return find_record_layout(name);
+}
+
+namespace {
+  struct input_converter {
+    to_py_t to_py;
+    type_id type; // of the product to be queried
+  };
+
+  template <typename T>
+  input_converter make_input_converter(to_py_t to_py)
+  {
+    return {to_py, make_type_id<T>()};
+  }
+}
+
+static std::optional<input_converter> input_converter_for(std::string const& inp_type)
+{
+  // TODO: this seems overly verbose and inefficient, but the product types need
+  // to be known, so every option is made explicit
+  if (inp_type == "bool")
+    return make_input_converter<bool>(bool_to_py);
+  if (inp_type == "int")
+    return make_input_converter<int>(int_to_py);
+  if (inp_type == "unsigned int")
+    return make_input_converter<unsigned int>(uint_to_py);
+  if (inp_type == "long")
+    return make_input_converter<long>(long_to_py);
+  if (inp_type == "unsigned long")
+    return make_input_converter<unsigned long>(ulong_to_py);
+  if (inp_type == "float")
+    return make_input_converter<float>(float_to_py);
+  if (inp_type == "double")
+    return make_input_converter<double>(double_to_py);
+
+  std::string vtype;
+  bool is_array = false;
+  if (!vector_type(inp_type, "input", vtype, is_array))
+    return std::nullopt; // error already set
+
+  if (auto const* layout = record_type(inp_type))
+    return input_converter{record_to_py, layout->vector_type_id};
+
+  // list and ndarray inputs both accept vector and array products, which have the same
+  // (opaque) type_id, and both receive a read-only numpy array
+  if (vtype == "vint")
+    return make_input_converter<array_view<int>>(array_to_py<int, NPY_INT, vint_to_py>);
+  if (vtype == "vuint")
+    return make_input_converter<array_view<unsigned int>>(
+      array_to_py<unsigned int, NPY_UINT, vuint_to_py>);
+  if (vtype == "vlong")
+    return make_input_converter<array_view<long>>(array_to_py<long, NPY_LONG, vlong_to_py>);
+  if (vtype == "vulong")
+    return make_input_converter<array_view<unsigned long>>(
+      array_to_py<unsigned long, NPY_ULONG, vulong_to_py>);
+  if (vtype == "vfloat")
+    return make_input_converter<array_view<float>>(array_to_py<float, NPY_FLOAT, vfloat_to_py>);
+  if (vtype == "vdouble")
+    return make_input_converter<array_view<double>>(array_to_py<double, NPY_DOUBLE, vdouble_to_py>);
+
+  PyErr_Format(PyExc_TypeError, "unsupported input type \"%s\"", inp_type.c_str());
+  return std::nullopt;
+}
+
+static bool make_inputs(std::vector<std::string> const& input_labels,
+                        std::vector<std::string> const& input_types,
+                        std::string const& layer,
+                        product_queries& inputs,
+                        std::vector<to_py_t>& to_py)
+{
+  // the node receives its inputs type-erased, so the product types from the annotations
+  // are set on the queries, for the graph to connect the node to the right producers
+  for (size_t i = 0; i < input_labels.size(); ++i) {
+    auto converter = input_converter_for(input_types[i]);
+    if (!converter)
+      return false; // error already set
+
+    product_query query{product_specification::create(input_labels[i]), layer};
+    query.set_type(std::move(converter->type));
+    inputs.push_back(std::move(query));
+    to_py.push_back(converter->to_py);
+  }
+
+  return true;
+}
+
+template <typename F>
+static bool with_output_converter(std::string const& output_type, F&& register_with)
+{
+  // TODO: same as for the inputs; these are explicit b/c of the templates only
+  if (output_type == "bool")
+    return register_with(py_to_bool);
+  if (output_type == "int")
+    return register_with(py_to_int);
+  if (output_type == "unsigned int")
+    return register_with(py_to_uint);
+  if (output_type == "long")
+    return register_with(py_to_long);
+  if (output_type == "unsigned long")
+    return register_with(py_to_ulong);
+  if (output_type == "float")
+    return register_with(py_to_float);
+  if (output_type == "double")
+    return register_with(py_to_double);
+
+  std::string vtype;
+  bool is_array = false;
+  if (!vector_type(output_type, "output", vtype, is_array))
+    return false; // error already set
+
+  if (auto const* layout = record_type(output_type)) {
+    PyArray_Descr* descr = record_descr(*layout);
+    if (!descr)
+      return false; // error already set
+    return register_with(record_from_py{layout, descr});
+  }
+
+  if (is_array) {
+    if (vtype == "vint")
+      return register_with(py_to_array<int, NPY_INT>);
+    if (vtype == "vuint")
+      return register_with(py_to_array<unsigned int, NPY_UINT>);
+    if (vtype == "vlong")
+      return register_with(py_to_array<long, NPY_LONG>);
+    if (vtype == "vulong")
+      return register_with(py_to_array<unsigned long, NPY_ULONG>);
+    if (vtype == "vfloat")
+      return register_with(py_to_array<float, NPY_FLOAT>);
+    if (vtype == "vdouble")
+      return register_with(py_to_array<double, NPY_DOUBLE>);
+  }
+
+  if (vtype == "vint")
+    return register_with(py_to_vint);
+  if (vtype == "vuint")
+    return register_with(py_to_vuint);
+  if (vtype == "vlong")
+    return register_with(py_to_vlong);
+  if (vtype == "vulong")
+    return register_with(py_to_vulong);
+  if (vtype == "vfloat")
+    return register_with(py_to_vfloat);
+  if (vtype == "vdouble")
+    return register_with(py_to_vdouble);
+
+  PyErr_Format(PyExc_TypeError, "unsupported output type \"%s\"", output_type.c_str());
+  return false;
+}
+
+template <typename R, typename FromPy>
+static bool register_transform(py_phlex_module* mod,
+                               std::string const& cname,
+                               PyObject* callable,
+                               product_queries const& inputs,
+                               std::vector<to_py_t> const& to_py,
+                               FromPy from_py,
+                               std::string const& output,
+                               concurrency conc)
+{
+  // TODO: the callbacks leak, but have program lifetime
+  if (inputs.size() == 1) {
+    auto* pyc = new py_transform_1<R, FromPy>{{callable, {to_py[0]}}, from_py};
+    mod->ph_module->transform(cname, *pyc, conc).input_family(inputs[0]).output_products(output);
+  } else if (inputs.size() == 2) {
+    auto* pyc = new py_transform_2<R, FromPy>{{callable, {to_py[0], to_py[1]}}, from_py};
+    mod->ph_module->transform(cname, *pyc, conc)
+      .input_family(inputs[0], inputs[1])
       .output_products(output);
-  } else if (output_type == "list[long]" || output_type == "list['long']") {
-    auto py_in = "py" + output + "_" + cname;
-    mod->ph_module->transform("pyvlong_" + output + "_" + cname, py_to_vlong, concurrency::serial)
-      .input_family(product_query{product_specification::create(py_in), LAYER})
+  } else if (inputs.size() == 3) {
+    auto* pyc = new py_transform_3<R, FromPy>{{callable, {to_py[0], to_py[1], to_py[2]}}, from_py};
+    mod->ph_module->transform(cname, *pyc, conc)
+      .input_family(inputs[0], inputs[1], inputs[2])
       .output_products(output);
-  } else if (output_type == "list[unsigned long]" || output_type == "list['unsigned long']") {
-    auto py_in = "py" + output + "_" + cname;
-    mod->ph_module->transform("pyvulong_" + output + "_" + cname, py_to_vulong, concurrency::serial)
-      .input_family(product_query{product_specification::create(py_in), LAYER})
+  } else {
+    PyErr_SetString(PyExc_TypeError, "unsupported number of inputs");
+    return false;
+  }
+
+  return true;
+}
+
+template <typename F>
+static bool with_element_type(std::string const& type, char const* direction, F&& f)
+{
+  // the annotations of batched algorithms are arrays of the scalar product types
+  std::string vtype;
+  bool is_array = false;
+  if (!vector_type(type, direction, vtype, is_array))
+    return false; // error already set
+
+  if (is_array) {
+    if (vtype == "vint")
+      return f.template operator()<int, NPY_INT>();
+    if (vtype == "vuint")
+      return f.template operator()<unsigned int, NPY_UINT>();
+    if (vtype == "vlong")
+      return f.template operator()<long, NPY_LONG>();
+    if (vtype == "vulong")
+      return f.template operator()<unsigned long, NPY_ULONG>();
+    if (vtype == "vfloat")
+      return f.template operator()<float, NPY_FLOAT>();
+    if (vtype == "vdouble")
+      return f.template operator()<double, NPY_DOUBLE>();
+  }
+
+  PyErr_Format(PyExc_TypeError,
+               "batched algorithms take and return numpy arrays; unsupported %s type \"%s\"",
+               direction,
+               type.c_str());
+  return false;
+}
+
+static bool make_batch_inputs(std::vector<std::string> const& input_labels,
+                              std::vector<std::string> const& input_types,
+                              std::string const& layer,
+                              product_queries& inputs,
+                              std::vector<batch_input>& batch_inputs)
+{
+  for (size_t i = 0; i < input_labels.size(); ++i) {
+    bool ok = with_element_type(input_types[i], "input", [&]<typename T, int NPT>() {
+      product_query query{product_specification::create(input_labels[i]), layer};
+      query.set_type(make_type_id<T>());
+      inputs.push_back(std::move(query));
+      batch_inputs.push_back({gather<T>, buffer<T>, NPT});
+      return true;
+    });
+    if (!ok)
+      return false; // error already set
+  }
+
+  return true;
+}
+
+template <typename R, size_t N>
+static py_batcher<R, N>* make_batcher(PyObject* callable,
+                                      std::vector<batch_input> const& batch_inputs,
+                                      int nptype,
+                                      std::size_t batch)
+{
+  std::array<batch_input, N> inputs;
+  std::copy_n(batch_inputs.begin(), N, inputs.begin());
+  // TODO: the batchers leak, but have program lifetime
+  return new py_batcher<R, N>{callable, inputs, nptype, batch};
+}
+
+template <typename R>
+static bool register_batched_transform(py_phlex_module* mod,
+                                       std::string const& cname,
+                                       PyObject* callable,
+                                       product_queries const& inputs,
+                                       std::vector<batch_input> const& batch_inputs,
+                                       int nptype,
+                                       std::size_t batch,
+                                       std::string const& output,
+                                       concurrency conc)
+{
+  if (inputs.size() == 1) {
+    py_batch_transform_1<R> pyc{make_batcher<R, 1>(callable, batch_inputs, nptype, batch)};
+    mod->ph_module->async_transform(cname, pyc, conc)
+      .input_family(inputs[0])
       .output_products(output);
-  } else if (output_type == "list[float]") {
-    auto py_in = "py" + output + "_" + cname;
-    mod->ph_module->transform("pyvfloat_" + output + "_" + cname, py_to_vfloat, concurrency::serial)
-      .input_family(product_query{product_specification::create(py_in), LAYER})
+  } else if (inputs.size() == 2) {
+    py_batch_transform_2<R> pyc{make_batcher<R, 2>(callable, batch_inputs, nptype, batch)};
+    mod->ph_module->async_transform(cname, pyc, conc)
+      .input_family(inputs[0], inputs[1])
       .output_products(output);
-  } else if (output_type == "list[double]" || output_type == "list['double']") {
-    auto py_in = "py" + output + "_" + cname;
-    mod->ph_module
-      ->transform("pyvdouble_" + output + "_" + cname, py_to_vdouble, concurrency::serial)
-      .input_family(product_query{product_specification::create(py_in), LAYER})
+  } else if (inputs.size() == 3) {
+    py_batch_transform_3<R> pyc{make_batcher<R, 3>(callable, batch_inputs, nptype, batch)};
+    mod->ph_module->async_transform(cname, pyc, conc)
+      .input_family(inputs[0], inputs[1], inputs[2])
       .output_products(output);
   } else {
-    PyErr_Format(PyExc_TypeError, "unsupported output type \"%s\"", output_type.c_str());
+    PyErr_SetString(PyExc_TypeError, "unsupported number of inputs");
+    return false;
+  }
+
+  return true;
+}
+
+static bool register_batched_observer(py_phlex_module* mod,
+                                      std::string const& cname,
+                                      PyObject* callable,
+                                      product_queries const& inputs,
+                                      std::vector<batch_input> const& batch_inputs,
+                                      std::size_t batch,
+                                      concurrency conc)
+{
+  // observers wait for their batch, so batches are bounded by the number of threads
+  if (inputs.size() == 1) {
+    py_batch_observer_1 pyc{make_batcher<void, 1>(callable, batch_inputs, NPY_NOTYPE, batch)};
+    mod->ph_module->observe(cname, pyc, conc).input_family(inputs[0]);
+  } else if (inputs.size() == 2) {
+    py_batch_observer_2 pyc{make_batcher<void, 2>(callable, batch_inputs, NPY_NOTYPE, batch)};
+    mod->ph_module->observe(cname, pyc, conc).input_family(inputs[0], inputs[1]);
+  } else if (inputs.size() == 3) {
+    py_batch_observer_3 pyc{make_batcher<void, 3>(callable, batch_inputs, NPY_NOTYPE, batch)};
+    mod->ph_module->observe(cname, pyc, conc).input_family(inputs[0], inputs[1], inputs[2]);
+  } else {
+    PyErr_SetString(PyExc_TypeError, "unsupported number of inputs");
+    return false;
+  }
+
+  return true;
+}
+
+static bool check_registrar(py_phlex_module* mod, bool provider, char const* kind)
+{
+  // algorithms are registered with modules, and providers with sources
+  if (provider ? mod->ph_source != nullptr : mod->ph_module != nullptr)
+    return true;
+
+  PyErr_Format(PyExc_TypeError,
+               "a %s can only be registered from %s",
+               kind,
+               provider ? "PHLEX_REGISTER_PROVIDERS" : "PHLEX_REGISTER_ALGORITHMS");
+  return false;
+}
+
+static PyObject* md_transform(py_phlex_module* mod, PyObject* args, PyObject* kwds)
+{
+  // Register a python algorithm as a single node, which converts the C++ input products
+  // to Python objects, calls the algorithm, and converts the result back to a C++ product,
+  // all under one acquisition of the GIL.
+
+  if (!check_registrar(mod, false, "transform"))
     return nullptr;
+
+  std::string cname;
+  std::vector<std::string> input_labels, input_types, output_labels, output_types;
+  concurrency conc = concurrency::serial;
+  std::size_t batch = 0;
+  std::string layer;
+  PyObject* callable = parse_args(args,
+                                  kwds,
+                                  cname,
+                                  input_labels,
+                                  input_types,
+                                  output_labels,
+                                  output_types,
+                                  conc,
+                                  batch,
+                                  layer);
+  if (!callable)
+    return nullptr; // error already set
+
+  if (output_types.empty()) {
+    PyErr_Format(PyExc_TypeError, "a transform should have an output type");
+    Py_DECREF(callable);
+    return nullptr;
+  }
+
+  // TODO: only support single output type for now, as there has to be a mapping
+  // onto a std::tuple otherwise, which is a typed object, thus complicating the
+  // template instantiation
+  std::string output = output_labels[0];
+  std::string output_type = output_types[0];
+
+  if (batch) {
+    product_queries inputs;
+    std::vector<batch_input> batch_inputs;
+    bool registered =
+      make_batch_inputs(input_labels, input_types, layer, inputs, batch_inputs) &&
+      with_element_type(output_type, "output", [&]<typename R, int NPT>() {
+        return register_batched_transform<R>(
+          mod, cname, callable, inputs, batch_inputs, NPT, batch, output, conc);
+      });
+    Py_DECREF(callable);
+    if (!registered)
+      return nullptr; // error already set
+
+    Py_RETURN_NONE;
   }
 
+  product_queries inputs;
+  std::vector<to_py_t> to_py;
+  if (!make_inputs(input_labels, input_types, layer, inputs, to_py)) {
+    Py_DECREF(callable);
+    return nullptr; // error already set
+  }
+
+  bool registered = with_output_converter(output_type, [&](auto from_py) {
+    using R = std::invoke_result_t<decltype(from_py), PyObject*>;
+    return register_transform<R>(mod, cname, callable, inputs, to_py, from_py, output, conc);
+  });
+  Py_DECREF(callable);
+  if (!registered)
+    return nullptr; // error already set
+
   Py_RETURN_NONE;
 }
 
 static PyObject* md_observe(py_phlex_module* mod, PyObject* args, PyObject* kwds)
 {
-  // Register a python observer by adding the necessary intermediate converter
-  // nodes going from C++ to PyObject* and back.
+  // Register a python observer as a single node, which converts the C++ input products
+  // to Python objects and calls the observer under one acquisition of the GIL.
+
+  if (!check_registrar(mod, false, "observer"))
+    return nullptr;
 
   std::string cname;
   std::vector<std::string> input_labels, input_types, output_labels, output_types;
-  PyObject* callable =
-    parse_args(args, kwds, cname, input_labels, input_types, output_labels, output_types);
+  concurrency conc = concurrency::serial;
+  std::size_t batch = 0;
+  std::string layer;
+  PyObject* callable = parse_args(args,
+                                  kwds,
+                                  cname,
+                                  input_labels,
+                                  input_types,
+                                  output_labels,
+                                  output_types,
+                                  conc,
+                                  batch,
+                                  layer);
   if (!callable)
     return nullptr; // error already set
 
   if (!output_types.empty()) {
     PyErr_Format(PyExc_TypeError, "an observer should not have an output type");
+    Py_DECREF(callable);
     return nullptr;
   }
 
-  if (!insert_input_converters(mod, cname, input_labels, input_types)) {
+  if (batch) {
+    product_queries inputs;
+    std::vector<batch_input> batch_inputs;
+    bool registered =
+      make_batch_inputs(input_labels, input_types, layer, inputs, batch_inputs) &&
+      register_batched_observer(mod, cname, callable, inputs, batch_inputs, batch, conc);
     Py_DECREF(callable);
-    return nullptr; // error already set
+    if (!registered)
+      return nullptr; // error already set
+
+    Py_RETURN_NONE;
   }
 
-  // register Python observer
-  if (input_labels.size() == 1) {
-    auto* pyc = new py_callback_1v{callable}; // id.
-    mod->ph_module->observe(cname, *pyc, concurrency::serial)
-      .input_family(
-        product_query{product_specification::create(cname + "_" + input_labels[0] + "py"), LAYER});
-    Py_DECREF(callable);
-  } else if (input_labels.size() == 2) {
-    auto* pyc = new py_callback_2v{callable};
-    mod->ph_module->observe(cname, *pyc, concurrency::serial)
-      .input_family(
-        product_query{product_specification::create(cname + "_" + input_labels[0] + "py"), LAYER},
-        product_query{product_specification::create(cname + "_" + input_labels[1] + "py"), LAYER});
-    Py_DECREF(callable);
-  } else if (input_labels.size() == 3) {
-    auto* pyc = new py_callback_3v{callable};
-    mod->ph_module->observe(cname, *pyc, concurrency::serial)
-      .input_family(
-        product_query{product_specification::create(cname + "_" + input_labels[0] + "py"), LAYER},
-        product_query{product_specification::create(cname + "_" + input_labels[1] + "py"), LAYER},
-        product_query{product_specification::create(cname + "_" + input_labels[2] + "py"), LAYER});
+  product_queries inputs;
+  std::vector<to_py_t> to_py;
+  if (!make_inputs(input_labels, input_types, layer, inputs, to_py)) {
     Py_DECREF(callable);
+    return nullptr; // error already set
+  }
+
+  // register Python observer (TODO: the callbacks leak, but have program lifetime)
+  if (inputs.size() == 1) {
+    auto* pyc = new py_observer_1{{callable, {to_py[0]}}};
+    mod->ph_module->observe(cname, *pyc, conc).input_family(inputs[0]);
+  } else if (inputs.size() == 2) {
+    auto* pyc = new py_observer_2{{callable, {to_py[0], to_py[1]}}};
+    mod->ph_module->observe(cname, *pyc, conc).input_family(inputs[0], inputs[1]);
+  } else if (inputs.size() == 3) {
+    auto* pyc = new py_observer_3{{callable, {to_py[0], to_py[1], to_py[2]}}};
+    mod->ph_module->observe(cname, *pyc, conc).input_family(inputs[0], inputs[1], inputs[2]);
   } else {
     PyErr_SetString(PyExc_TypeError, "unsupported number of inputs");
     Py_DECREF(callable);
     return nullptr;
   }
+  Py_DECREF(callable);
+
+  Py_RETURN_NONE;
+}
+
+template <typename R, typename FromPy>
+static bool register_fold(py_phlex_module* mod,
+                          std::string const& cname,
+                          PyObject* callable,
+                          product_queries const& inputs,
+                          std::vector<batch_input> const& batch_inputs,
+                          FromPy from_py,
+                          PyObject* init,
+                          std::size_t batch,
+                          std::string const& partition,
+                          std::string const& output,
+                          concurrency conc)
+{
+  // TODO: the folders leak, but have program lifetime
+  auto make_folder = [&]<size_t N>() {
+    std::array<batch_input, N> folder_inputs;
+    std::copy_n(batch_inputs.begin(), N, folder_inputs.begin());
+    return new py_folder<R, FromPy, N>{callable, folder_inputs, from_py, init, batch};
+  };
+
+  // the folder is passed by value, as the fold object of each partition is created from it
+  if (inputs.size() == 1) {
+    using folder_t = py_folder<R, FromPy, 1>;
+    mod->ph_module
+      ->fold(cname,
+             py_fold_1<folder_t>{},
+             conc,
+             partition,
+             static_cast<folder_t const*>(make_folder.template operator()<1>()))
+      .input_family(inputs[0])
+      .output_products(output);
+  } else if (inputs.size() == 2) {
+    using folder_t = py_folder<R, FromPy, 2>;
+    mod->ph_module
+      ->fold(cname,
+             py_fold_2<folder_t>{},
+             conc,
+             partition,
+             static_cast<folder_t const*>(make_folder.template operator()<2>()))
+      .input_family(inputs[0], inputs[1])
+      .output_products(output);
+  } else if (inputs.size() == 3) {
+    using folder_t = py_folder<R, FromPy, 3>;
+    mod->ph_module
+      ->fold(cname,
+             py_fold_3<folder_t>{},
+             conc,
+             partition,
+             static_cast<folder_t const*>(make_folder.template operator()<3>()))
+      .input_family(inputs[0], inputs[1], inputs[2])
+      .output_products(output);
+  } else {
+    PyErr_SetString(PyExc_TypeError, "unsupported number of inputs");
+    return false;
+  }
+
+  return true;
+}
+
+static PyObject* pop_kwarg(PyObject* kwds, char const* name)
+{
+  // remove an optional keyword argument from a (private) dict, returning a new reference
+  // to its value, or nullptr if not given
+  if (!kwds)
+    return nullptr;
+
+  PyObject* value = PyDict_GetItemString(kwds, name); // borrowed
+  if (value) {
+    Py_INCREF(value);
+    PyDict_DelItemString(kwds, name);
+  }
+  return value;
+}
+
+static PyObject* md_fold(py_phlex_module* mod, PyObject* args, PyObject* kwds)
+{
+  // Register a python fold, which receives numpy arrays of the buffered input values of
+  // its partition together with the value accumulated so far, and returns the new value
+  // (see py_folder). The accumulated value starts from "init" (None by default) for each
+  // partition, the data cells of which are those below the "partition" layer ("job" by
+  // default); the inputs are annotated as numpy arrays of the scalar product types.
+
+  if (!check_registrar(mod, false, "fold"))
+    return nullptr;
+
+  // the partition and initial value are specific to folds, the other arguments are common
+  PyObject* common_kwds = kwds ? PyDict_Copy(kwds) : nullptr;
+  if (kwds && !common_kwds)
+    return nullptr;
+  PyObject* pypartition = pop_kwarg(common_kwds, "partition");
+  PyObject* init = pop_kwarg(common_kwds, "init");
+  if (!init) {
+    init = Py_None;
+    Py_INCREF(init);
+  }
+
+  std::string partition = "job";
+  if (pypartition && pypartition != Py_None) {
+    char const* cstr = PyUnicode_Check(pypartition) ? PyUnicode_AsUTF8(pypartition) : nullptr;
+    if (cstr)
+      partition = cstr;
+    else if (!PyErr_Occurred())
+      PyErr_SetString(PyExc_TypeError, "partition should be a string or None");
+  }
+  Py_XDECREF(pypartition);
+
+  std::string cname;
+  std::vector<std::string> input_labels, input_types, output_labels, output_types;
+  concurrency conc = concurrency::serial;
+  std::size_t batch = 0;
+  std::string layer;
+  PyObject* callable = nullptr;
+  if (!PyErr_Occurred()) {
+    callable = parse_args(args,
+                          common_kwds,
+                          cname,
+                          input_labels,
+                          input_types,
+                          output_labels,
+                          output_types,
+                          conc,
+                          batch,
+                          layer,
+                          1);
+  }
+  Py_XDECREF(common_kwds);
+  if (!callable) {
+    Py_DECREF(init);
+    return nullptr; // error already set
+  }
+
+  bool registered = false;
+  if (output_types.empty() || output_labels.empty()) {
+    PyErr_Format(PyExc_TypeError, "a fold should have an output type and product");
+  } else {
+    product_queries inputs;
+    std::vector<batch_input> batch_inputs;
+    registered =
+      make_batch_inputs(input_labels, input_types, layer, inputs, batch_inputs) &&
+      with_output_converter(output_types[0], [&](auto from_py) {
+        using R = std::invoke_result_t<decltype(from_py), PyObject*>;
+        return register_fold<R>(mod,
+                                cname,
+                                callable,
+                                inputs,
+                                batch_inputs,
+                                from_py,
+                                init,
+                                batch,
+                                partition,
+                                output_labels[0],
+                                conc);
+      });
+  }
+  Py_DECREF(init);
+  Py_DECREF(callable);
+  if (!registered)
+    return nullptr; // error already set
+
+  Py_RETURN_NONE;
+}
+
+static PyObject* md_provide(py_phlex_module* mod, PyObject* args, PyObject* kwds)
+{
+  // Register a python provider, which is called with the number of the data cell in the
+  // given layer ("event" by default) and returns its product, converted as for transforms.
+
+  if (!check_registrar(mod, true, "provider"))
+    return nullptr;
+
+  static char const* kwnames[] = {
+    "callable", "output_products", "layer", "concurrency", "name", nullptr};
+  PyObject *callable = 0, *output = 0, *pylayer = 0, *pyconc = 0, *pyname = 0;
+  if (!PyArg_ParseTupleAndKeywords(args,
+                                   kwds,
+                                   "OO|OOO",
+                                   (char**)kwnames,
+                                   &callable,
+                                   &output,
+                                   &pylayer,
+                                   &pyconc,
+                                   &pyname)) {
+    // error already set by argument parser
+    return nullptr;
+  }
+
+  std::string layer, cname;
+  concurrency conc = concurrency::serial;
+  if (!parse_layer(pylayer, layer) || !parse_concurrency(pyconc, conc))
+    return nullptr; // error already set
+
+  if (!callable || !PyCallable_Check(callable)) {
+    PyErr_SetString(PyExc_TypeError, "provided algorithm is not callable");
+    return nullptr;
+  }
+
+  if (!callable_name(callable, pyname, cname))
+    return nullptr; // error already set
+
+  PyObject* output_fast = PySequence_Fast(output, "output_products must be a sequence");
+  if (!output_fast)
+    return nullptr; // TypeError already set by PySequence_Fast
+  std::vector<std::string> output_labels = cseq(output_fast);
+  Py_DECREF(output_fast);
+  if (PyErr_Occurred())
+    return nullptr;
+
+  if (output_labels.size() != 1) {
+    PyErr_SetString(PyExc_TypeError, "a provider should have a single output");
+    return nullptr;
+  }
+
+  std::vector<std::string> input_types, output_types;
+  callable_annotations(callable, input_types, output_types);
+  if (output_types.empty()) {
+    PyErr_Format(PyExc_TypeError, "a provider should have an output type");
+    return nullptr;
+  }
+
+  callable = unwrap_callable(callable);
+  // TODO: the providers leak their callable, which has program lifetime
+  bool registered = with_output_converter(output_types[0], [&](auto from_py) {
+    using R = std::invoke_result_t<decltype(from_py), PyObject*>;
+    Py_INCREF(callable);
+    mod->ph_source->provide(cname, py_provider<R, decltype(from_py)>{callable, from_py}, conc)
+      .output_product(product_query{product_specification::create(output_labels[0]), layer});
+    return true;
+  });
+  Py_DECREF(callable);
+  if (!registered)
+    return nullptr; // error already set
 
   Py_RETURN_NONE;
 }
@@ -934,6 +2322,14 @@ static PyMethodDef md_methods[] = {{(char*)"transform",
                                     (PyCFunction)md_observe,
                                     METH_VARARGS | METH_KEYWORDS,
                                     (char*)"register a Python observer"},
+                                   {(char*)"fold",
+                                    (PyCFunction)md_fold,
+                                    METH_VARARGS | METH_KEYWORDS,
+                                    (char*)"register a Python fold"},
+                                   {(char*)"provide",
+                                    (PyCFunction)md_provide,
+                                    METH_VARARGS | METH_KEYWORDS,
+                                    (char*)"register a Python provider"},
                                    {(char*)nullptr, nullptr, 0, nullptr}};
 
 // clang-format off
@@ -1,5 +1,6 @@
 #include <atomic>
 #include <dlfcn.h>
+#include <functional>
 #include <stdexcept>
 #include <string>
 
@@ -13,19 +14,28 @@
 using namespace phlex::experimental;
 
 static bool initialize();
+static void register_shutdown_hook();
 
 PHLEX_REGISTER_ALGORITHMS(m, config)
+{
+  register_python(config, "PHLEX_REGISTER_ALGORITHMS", [&m] { return wrap_module(&m); });
+}
+
+void phlex::experimental::register_python(configuration const& config,
+                                          char const* registration,
+                                          std::function<PyObject*()> const& wrap)
 {
   initialize();
 
   PyGILRAII g;
+  register_shutdown_hook();
 
   std::string modname = config.get<std::string>("py");
   PyObject* mod = PyImport_ImportModule(modname.c_str());
   if (mod) {
-    PyObject* reg = PyObject_GetAttrString(mod, "PHLEX_REGISTER_ALGORITHMS");
+    PyObject* reg = PyObject_GetAttrString(mod, registration);
     if (reg) {
-      PyObject* pym = wrap_module(&m);
+      PyObject* pym = wrap();
       PyObject* pyconfig = wrap_configuration(&config);
       if (pym && pyconfig) {
         PyObject* res = PyObject_CallFunctionObjArgs(reg, pym, pyconfig, nullptr);
@@ -52,13 +62,46 @@ static void import_numpy(bool control_interpreter)
   if (!numpy_imported.exchange(true)) {
     if (_import_array() < 0) {
       PyErr_Print();
-      if (control_interpreter)
+      if (control_interpreter) {
+        release_python_references();
         Py_Finalize();
+      }
       throw std::runtime_error("build with numpy support, but numpy not importable");
     }
   }
 }
 
+// Python calls the atexit handlers at the start of Py_Finalize, with the GIL held and the
+// interpreter still intact, which makes it the last safe point to drop the references
+// released by C++ products.
+static PyObject* release_references_at_exit(PyObject*, PyObject*)
+{
+  release_python_references();
+  Py_RETURN_NONE;
+}
+
+static PyMethodDef release_references_def = {
+  "_phlex_release_references", release_references_at_exit, METH_NOARGS, nullptr};
+
+// the GIL must be held
+static void register_shutdown_hook()
+{
+  static std::atomic<bool> registered{false};
+  if (registered.exchange(true))
+    return;
+
+  if (PyObject* atexit = PyImport_ImportModule("atexit")) {
+    if (PyObject* hook = PyCFunction_New(&release_references_def, nullptr)) {
+      PyObject* res = PyObject_CallMethod(atexit, "register", "O", hook);
+      Py_XDECREF(res);
+      Py_DECREF(hook);
+    }
+    Py_DECREF(atexit);
+  }
+  // without the hook, the references still pending at shutdown are leaked
+  PyErr_Clear();
+}
+
 static void add_cmake_prefix_paths_to_syspath(char const* cmake_prefix_path)
 {
   std::string prefix_path_str(cmake_prefix_path);
@@ -0,0 +1,12 @@
+#include "phlex/source.hpp"
+
+#include "wrap.hpp"
+
+using namespace phlex::experimental;
+
+// Python providers are registered from a separate entry point, as sources are loaded
+// with their own registrar; the Python interpreter is shared with the Python modules
+PHLEX_REGISTER_PROVIDERS(s, config)
+{
+  register_python(config, "PHLEX_REGISTER_PROVIDERS", [&s] { return wrap_source(&s); });
+}
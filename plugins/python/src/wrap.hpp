@@ -18,11 +18,13 @@
 
 #include "Python.h"
 
+#include <functional>
 #include <memory>
 #include <string>
 
 #include "phlex/configuration.hpp"
 #include "phlex/module.hpp"
+#include "phlex/source.hpp"
 
 namespace phlex::experimental {
 
@@ -39,10 +41,22 @@ namespace phlex::experimental {
   // Returns a new reference.
   PyObject* wrap_module(phlex_module_t* mod);
 
-  // Python wrapper for Phlex modules
+  // Phlex' Source wrapper to register providers
+  typedef source_graph_proxy<void_tag> phlex_source_t;
+  // Returns a new reference.
+  PyObject* wrap_source(phlex_source_t* source);
+
+  // Python wrapper for Phlex modules and sources
   extern PyTypeObject PhlexModule_Type;
   struct py_phlex_module;
 
+  // Import the Python module named by the "py" parameter of the configuration and call its
+  // registration function (e.g. PHLEX_REGISTER_ALGORITHMS) with the registrar returned by
+  // wrap, and the configuration. Throws on Python errors.
+  void register_python(configuration const& config,
+                       char const* registration,
+                       std::function<PyObject*()> const& wrap);
+
   // Python wrapper for Phlex handles
   extern PyTypeObject PhlexLifeline_Type;
   // clang-format off
@@ -54,6 +68,10 @@ namespace phlex::experimental {
   using py_lifeline_t = py_lifeline;
   // clang-format on
 
+  // Drop the Python references still held for C++ products that have been destroyed; any
+  // released later are leaked. Called once, with the GIL held, before Py_Finalize.
+  void release_python_references();
+
   // Error reporting helper.
   bool msg_from_py_error(std::string& msg, bool check_error = false);
 
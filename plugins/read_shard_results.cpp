@@ -0,0 +1,46 @@
+// ==============================================================================================
+// The read_shard_results provider reads the result written by the save_shard_result module
+// for each shard, providing it as a data product in the 'shard' layer.  The data-cell number
+// of each shard indexes into the list of files.  See the notes in plugins/shard_results.hpp.
+//
+//   sources: {
+//     shard_sums: {
+//       cpp: "read_shard_results",
+//       files: ["sum-shard-0.txt", "sum-shard-1.txt"],
+//       provides: { product: "sum", layer: "shard" },
+//       type: "unsigned int"
+//     }
+//   }
+// ==============================================================================================
+
+#include "phlex/model/data_cell_index.hpp"
+#include "phlex/source.hpp"
+#include "plugins/shard_results.hpp"
+
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace phlex;
+
+PHLEX_REGISTER_PROVIDERS(s, config)
+{
+  auto const file_names = config.get<std::vector<std::string>>("files");
+  auto const query = config.get<product_query>("provides");
+  experimental::with_arithmetic_type(
+    config.get<std::string>("type", "unsigned int"), [&]<typename T>() {
+      s.provide("read",
+                [file_names](data_cell_index const& id) -> T {
+                  auto const& file_name = file_names.at(id.number());
+                  std::ifstream file{file_name};
+                  T value{};
+                  if (not(file >> value)) {
+                    throw std::runtime_error("Could not read shard result from '" + file_name +
+                                             "'");
+                  }
+                  return value;
+                })
+        .output_product(query);
+    });
+}
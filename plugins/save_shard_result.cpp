@@ -0,0 +1,47 @@
+// ==============================================================================================
+// The save_shard_result module writes a single arithmetic data product (typically a job-level
+// fold result) to a text file so that it can be merged with the results of other shards.  The
+// file is created (empty) when the module is registered, so that a shard that processes no
+// data cells, and therefore produces no result, still leaves a file for the merge job.  See
+// the notes in plugins/shard_results.hpp.
+//
+//   modules: {
+//     save_sum: {
+//       cpp: "save_shard_result",
+//       consumes: { product: "sum", layer: "job" },
+//       type: "unsigned int",
+//       file: "sum-shard-0.txt"
+//     }
+//   }
+// ==============================================================================================
+
+#include "phlex/module.hpp"
+#include "plugins/shard_results.hpp"
+
+#include "fmt/format.h"
+
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+using namespace phlex;
+
+PHLEX_REGISTER_ALGORITHMS(m, config)
+{
+  auto const query = config.get<product_query>("consumes");
+  auto const file_name = config.get<std::string>("file");
+  if (not std::ofstream{file_name}) {
+    throw std::runtime_error("Could not open shard-result file '" + file_name + "'");
+  }
+  experimental::with_arithmetic_type(
+    config.get<std::string>("type", "unsigned int"), [&]<typename T>() {
+      m.observe("save", [file_name](T const& value) {
+         std::ofstream file{file_name};
+         if (not file) {
+           throw std::runtime_error("Could not open shard-result file '" + file_name + "'");
+         }
+         // fmt's default formatting of floating-point numbers round-trips exactly.
+         file << fmt::format("{}\n", value);
+       }).input_family(query);
+    });
+}
@@ -0,0 +1,48 @@
+#ifndef PLUGINS_SHARD_RESULTS_HPP
+#define PLUGINS_SHARD_RESULTS_HPP
+
+// ==============================================================================================
+// Support for merging job-level fold results of a sharded job (see the '--shard i/N' option of
+// the phlex executable).  Each shard writes its fold result to a local text file with the
+// 'save_shard_result' module.  A subsequent merge job is then configured with:
+//
+//   - the 'merge_shards' driver, which yields one 'shard' data cell per shard-result file,
+//   - the 'read_shard_results' provider, which reads the fold result of each shard, and
+//   - the original fold algorithm, consuming the per-shard results in the 'shard' layer.
+//
+// The fold thus combines the per-shard partial results with the same semantics it uses for
+// combining the original inputs.  This requires that the fold's input type is the same as its
+// result type (e.g. sums, counts, minima, or maxima).
+//
+// A shard that processes no data cells produces no fold result.  Its result file is left empty,
+// and the merge job skips it.
+//
+// The supported product types are listed in 'with_arithmetic_type' below.
+// ==============================================================================================
+
+#include <stdexcept>
+#include <string>
+
+namespace phlex::experimental {
+  template <typename F>
+  void with_arithmetic_type(std::string const& type, F f)
+  {
+    if (type == "int") {
+      f.template operator()<int>();
+    } else if (type == "unsigned int") {
+      f.template operator()<unsigned int>();
+    } else if (type == "long") {
+      f.template operator()<long>();
+    } else if (type == "unsigned long") {
+      f.template operator()<unsigned long>();
+    } else if (type == "float") {
+      f.template operator()<float>();
+    } else if (type == "double") {
+      f.template operator()<double>();
+    } else {
+      throw std::runtime_error("Unsupported shard-result type '" + type + "'");
+    }
+  }
+}
+
+#endif // PLUGINS_SHARD_RESULTS_HPP
@@ -0,0 +1,336 @@
+#!/usr/bin/env python3
+"""Measure how the end-to-end Phlex benchmarks scale with thread and event counts.
+
+Each benchmark configuration is run once per (thread count, event count) pair of the
+requested sweep.  The CPU time, real time and maximum RSS are taken from the report that
+the framework's ``resource_usage`` object writes at the end of graph execution, and the
+number of processed events is taken from the data-layer hierarchy printed at the end of
+the job.  From these, the event throughput and the parallel efficiency relative to the
+smallest thread count of the sweep are derived.
+
+The results are written as JSON.  If a baseline report (a previous output of this script)
+is given, each measurement is compared with the matching baseline entry, and throughput
+changes beyond the tolerance are flagged as improvements or regressions.
+"""
+
+from __future__ import annotations
+
+import argparse
+import json
+import os
+import platform
+import re
+import statistics
+import subprocess
+import sys
+import tempfile
+from datetime import datetime, timezone
+from pathlib import Path
+
+_RESOURCE_USAGE = re.compile(r"CPU time: ([0-9.]+)s\s+Real time: ([0-9.]+)s")
+_MAX_RSS = re.compile(r"Max\. RSS: ([0-9.]+) MB")
+
+
+class BenchmarkError(RuntimeError):
+    """A benchmark job failed or its output could not be interpreted."""
+
+
+def _layer_count(output: str, layer: str) -> int:
+    """Return the number of data cells reported for a layer in the job's hierarchy printout."""
+    matches = re.findall(rf"[├└] {re.escape(layer)}: (\d+)", output)
+    if not matches:
+        raise BenchmarkError(f"no count reported for data layer '{layer}'")
+    return sum(int(m) for m in matches)
+
+
+def _wrapped_config(config: Path, events: int | None, workdir: Path) -> Path:
+    """Return a configuration that overrides the number of events of the given one."""
+    if events is None:
+        return config
+    wrapper = workdir / f"{config.stem}-{events}.jsonnet"
+    wrapper.write_text(
+        f"(import {json.dumps(str(config.resolve()))}) + "
+        f"{{ driver+: {{ layers+: {{ event+: {{ total: {events} }} }} }} }}\n"
+    )
+    return wrapper
+
+
+def run_job(
+    phlex: Path, config: Path, threads: int, layer: str, env: dict[str, str]
+) -> dict[str, float]:
+    """Run one job and return its resource usage.
+
+    Args:
+        phlex: The phlex executable.
+        config: The configuration file to run.
+        threads: The maximum parallelism passed to ``phlex -j``.
+        layer: The data layer whose cells are counted as events.
+        env: The environment of the job.
+
+    Returns:
+        The CPU time and real time (in seconds), the maximum RSS (in MB), and the number
+        of processed events.
+
+    Raises:
+        BenchmarkError: If the job fails or does not report its resource usage.
+    """
+    job = subprocess.run(
+        [str(phlex), "-c", str(config), "-j", str(threads)],
+        env=env,
+        stdout=subprocess.PIPE,
+        stderr=subprocess.STDOUT,
+        text=True,
+        check=False,
+    )
+    if job.returncode != 0:
+        tail = "\n".join(job.stdout.splitlines()[-20:])
+        raise BenchmarkError(f"{config.name} with -j {threads} failed:\n{tail}")
+
+    usage = _RESOURCE_USAGE.search(job.stdout)
+    rss = _MAX_RSS.search(job.stdout)
+    if usage is None or rss is None:
+        raise BenchmarkError(f"{config.name}: no resource usage found in the job output")
+    return {
+        "cpu_time": float(usage.group(1)),
+        "real_time": float(usage.group(2)),
+        "max_rss_mb": float(rss.group(1)),
+        "events": _layer_count(job.stdout, layer),
+    }
+
+
+def measure(
+    phlex: Path,
+    config: Path,
+    threads: int,
+    events: int | None,
+    repetitions: int,
+    layer: str,
+    env: dict[str, str],
+    workdir: Path,
+) -> dict:
+    """Run a configuration repeatedly and summarize it by the median real time."""
+    job_config = _wrapped_config(config, events, workdir)
+    samples = [run_job(phlex, job_config, threads, layer, env) for _ in range(repetitions)]
+    median = sorted(samples, key=lambda s: s["real_time"])[(len(samples) - 1) // 2]
+    result = {
+        "config": config.stem,
+        "threads": threads,
+        "events": median["events"],
+        "repetitions": repetitions,
+        "real_time": median["real_time"],
+        "real_time_stdev": statistics.stdev(s["real_time"] for s in samples)
+        if len(samples) > 1
+        else 0.0,
+        "cpu_time": median["cpu_time"],
+        "max_rss_mb": max(s["max_rss_mb"] for s in samples),
+    }
+    result["events_per_second"] = (
+        result["events"] / result["real_time"] if result["real_time"] > 0 else 0.0
+    )
+    result["cpu_efficiency"] = (
+        result["cpu_time"] / (result["real_time"] * threads) if result["real_time"] > 0 else 0.0
+    )
+    return result
+
+
+def add_parallel_efficiency(results: list[dict]) -> None:
+    """Annotate each result with its speedup and parallel efficiency.
+
+    The reference for a (config, events) series is its measurement with the smallest
+    thread count.  The parallel efficiency is the speedup divided by the increase in the
+    number of threads.
+    """
+    series: dict[tuple[str, int], list[dict]] = {}
+    for r in results:
+        series.setdefault((r["config"], r["events"]), []).append(r)
+    for entries in series.values():
+        reference = min(entries, key=lambda r: r["threads"])
+        for r in entries:
+            speedup = (
+                r["events_per_second"] / reference["events_per_second"]
+                if reference["events_per_second"] > 0
+                else 0.0
+            )
+            r["speedup"] = speedup
+            r["parallel_efficiency"] = speedup * reference["threads"] / r["threads"]
+
+
+def compare(results: list[dict], baseline: dict, tolerance: float) -> list[dict]:
+    """Compare the throughput of each result with the matching baseline measurement.
+
+    Args:
+        results: The measurements of this run.
+        baseline: A report previously written by this script.
+        tolerance: The relative throughput change below which results are unchanged.
+
+    Returns:
+        One entry per result with a baseline counterpart.
+    """
+
+    def key(r: dict) -> tuple[str, int, int]:
+        return r["config"], r["threads"], r["events"]
+
+    reference = {key(r): r for r in baseline.get("results", [])}
+    comparison = []
+    for r in results:
+        if (old := reference.get(key(r))) is None or old["events_per_second"] <= 0:
+            continue
+        change = r["events_per_second"] / old["events_per_second"] - 1.0
+        status = "unchanged"
+        if change < -tolerance:
+            status = "regression"
+        elif change > tolerance:
+            status = "improvement"
+        comparison.append(
+            {
+                "config": r["config"],
+                "threads": r["threads"],
+                "events": r["events"],
+                "baseline_events_per_second": old["events_per_second"],
+                "events_per_second": r["events_per_second"],
+                "change": change,
+                "status": status,
+            }
+        )
+    return comparison
+
+
+def _print_results(results: list[dict], comparison: list[dict]) -> None:
+    changes = {(c["config"], c["threads"], c["events"]): c for c in comparison}
+    print(
+        f"{'config':<16}{'threads':>8}{'events':>10}{'real [s]':>11}{'cpu [s]':>11}"
+        f"{'RSS [MB]':>10}{'events/s':>12}{'par. eff.':>11}{'vs. base':>10}"
+    )
+    for r in results:
+        change = changes.get((r["config"], r["threads"], r["events"]))
+        vs_base = f"{change['change']:+.1%}" if change else "-"
+        print(
+            f"{r['config']:<16}{r['threads']:>8}{r['events']:>10}{r['real_time']:>11.3f}"
+            f"{r['cpu_time']:>11.3f}{r['max_rss_mb']:>10.1f}{r['events_per_second']:>12.1f}"
+            f"{r['parallel_efficiency']:>11.2f}{vs_base:>10}"
+        )
+
+
+def _int_list(text: str) -> list[int]:
+    return [int(v) for v in text.replace(",", " ").split()]
+
+
+def main() -> int:
+    """Run the scaling sweep from the command line."""
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--phlex", type=Path, required=True, help="phlex executable")
+    parser.add_argument(
+        "--plugin-path",
+        default=os.environ.get("PHLEX_PLUGIN_PATH"),
+        help="value of PHLEX_PLUGIN_PATH for the jobs (default: current environment)",
+    )
+    parser.add_argument(
+        "--threads",
+        type=_int_list,
+        default=None,
+        help="thread counts to sweep, e.g. '1,2,4,8' (default: powers of two up to the "
+        "number of CPUs)",
+    )
+    parser.add_argument(
+        "--events",
+        type=_int_list,
+        default=None,
+        help="event counts to sweep (default: the count in each configuration)",
+    )
+    parser.add_argument(
+        "--repetitions", type=int, default=3, help="runs per measurement (default: 3)"
+    )
+    parser.add_argument(
+        "--layer", default="event", help="data layer counted as events (default: event)"
+    )
+    parser.add_argument("--output", type=Path, required=True, help="JSON report to write")
+    parser.add_argument("--baseline", type=Path, help="previous report to compare against")
+    parser.add_argument(
+        "--tolerance",
+        type=float,
+        default=0.05,
+        help="relative throughput change tolerated before flagging (default: 0.05)",
+    )
+    parser.add_argument(
+        "--fail-on-regression",
+        action="store_true",
+        help="exit with a non-zero status if any throughput regression is flagged",
+    )
+    parser.add_argument("configs", type=Path, nargs="+", help="benchmark configurations")
+    args = parser.parse_args()
+
+    threads = args.threads
+    if not threads:
+        cpus = os.cpu_count() or 1
+        threads = [1 << i for i in range(cpus.bit_length()) if 1 << i <= cpus]
+    events = args.events or [None]
+
+    env = dict(os.environ)
+    if args.plugin_path:
+        env["PHLEX_PLUGIN_PATH"] = args.plugin_path
+    env.setdefault("SPDLOG_LEVEL", "info")
+
+    results = []
+    try:
+        with tempfile.TemporaryDirectory(prefix="phlex-scaling-") as workdir:
+            for config in args.configs:
+                for n_events in events:
+                    for n_threads in threads:
+                        print(
+                            f"Running {config.name} with -j {n_threads}"
+                            + (f" and {n_events} events" if n_events is not None else ""),
+                            file=sys.stderr,
+                        )
+                        results.append(
+                            measure(
+                                args.phlex,
+                                config,
+                                n_threads,
+                                n_events,
+                                args.repetitions,
+                                args.layer,
+                                env,
+                                Path(workdir),
+                            )
+                        )
+    except BenchmarkError as e:
+        print(f"Error: {e}", file=sys.stderr)
+        return 1
+
+    add_parallel_efficiency(results)
+
+    comparison = []
+    if args.baseline:
+        comparison = compare(results, json.loads(args.baseline.read_text()), args.tolerance)
+
+    report = {
+        "context": {
+            "date": datetime.now(timezone.utc).isoformat(timespec="seconds"),
+            "host": platform.node(),
+            "cpus": os.cpu_count(),
+            "phlex": str(args.phlex),
+            "repetitions": args.repetitions,
+        },
+        "results": results,
+    }
+    if args.baseline:
+        report["baseline"] = str(args.baseline)
+        report["tolerance"] = args.tolerance
+        report["comparison"] = comparison
+    args.output.write_text(json.dumps(report, indent=2) + "\n")
+
+    _print_results(results, comparison)
+    print(f"\nReport written to {args.output}")
+
+    regressions = [c for c in comparison if c["status"] == "regression"]
+    for c in regressions:
+        print(
+            f"Regression: {c['config']} with -j {c['threads']} ({c['events']} events): "
+            f"{c['change']:+.1%} events/s",
+            file=sys.stderr,
+        )
+    return 1 if regressions and args.fail_on_regression else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
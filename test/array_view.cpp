@@ -0,0 +1,66 @@
+#include "phlex/model/array_view.hpp"
+#include "phlex/model/type_id.hpp"
+
+#include "catch2/catch_test_macros.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+using namespace phlex::experimental;
+
+namespace {
+  // A 3x4 grid in C order, with the values 0 to 11
+  std::shared_ptr<std::vector<double>> make_grid()
+  {
+    auto grid = std::make_shared<std::vector<double>>(12);
+    std::iota(grid->begin(), grid->end(), 0.);
+    return grid;
+  }
+
+  constexpr std::ptrdiff_t elem = sizeof(double);
+}
+
+TEST_CASE("Contiguous array view", "[data model]")
+{
+  auto grid = make_grid();
+  array_view<double> const view{grid->data(), {3, 4}, {4 * elem, elem}, grid};
+  CHECK(view.ndim() == 2);
+  CHECK(view.size() == 12);
+  CHECK(view.is_contiguous());
+  CHECK(view.span().data() == grid->data());
+  CHECK(view[5] == 5.);
+  CHECK(view.to_vector() == *grid);
+}
+
+TEST_CASE("Strided array view", "[data model]")
+{
+  auto grid = make_grid();
+  // Every other column of the transposed grid
+  array_view<double> const view{grid->data(), {2, 3}, {2 * elem, 4 * elem}, grid};
+  CHECK(view.size() == 6);
+  CHECK_FALSE(view.is_contiguous());
+  CHECK_THROWS_AS(view.span(), std::runtime_error);
+  CHECK(view.to_vector() == std::vector<double>{0., 4., 8., 2., 6., 10.});
+  CHECK(std::accumulate(view.begin(), view.end(), 0.) == 30.);
+}
+
+TEST_CASE("Array view keeps its owner alive", "[data model]")
+{
+  auto grid = make_grid();
+  std::weak_ptr<std::vector<double>> const watcher = grid;
+  {
+    array_view<double> const view{grid->data(), grid->size(), std::move(grid)};
+    CHECK_FALSE(watcher.expired());
+    CHECK(view[11] == 11.);
+  }
+  CHECK(watcher.expired());
+}
+
+TEST_CASE("Array views are opaque to type_id", "[data model]")
+{
+  // Matched with vector products of the same name, as for shared pointers
+  CHECK(make_type_id<array_view<double>>() == make_type_id<std::shared_ptr<std::vector<double>>>());
+}
@@ -0,0 +1,175 @@
+// =======================================================================================
+/*
+   This test executes the following graph
+
+                       provide_number
+                        /          \
+                       /            \
+              lookup_calibration   burn_cpu
+                 /          \          |
+                /            \         |
+   verify_calibration   sum_calibrations   sum_work
+
+   where 'lookup_calibration' is an asynchronous transform that consults a stand-in
+   conditions service.  The service sleeps for a fixed time on its own thread before
+   delivering its answer.  The graph is executed with a single worker thread so that, if
+   the worker were parked while waiting for the service, the CPU-bound 'burn_cpu'
+   transform could not make progress in the meantime.
+*/
+// =======================================================================================
+
+#include "phlex/core/framework_graph.hpp"
+#include "phlex/model/data_cell_index.hpp"
+#include "phlex/utilities/async_future.hpp"
+#include "phlex/utilities/sleep_for.hpp"
+#include "plugins/layer_generator.hpp"
+
+#include "catch2/catch_test_macros.hpp"
+#include "fmt/chrono.h"
+#include "spdlog/spdlog.h"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace phlex;
+using namespace std::chrono;
+
+namespace {
+  constexpr auto max_events = 20u;
+  constexpr auto service_latency = 25ms;
+  constexpr auto cpu_work = 10ms;
+
+  class conditions_service {
+  public:
+    experimental::async_future<double> calibration_for(unsigned int number) const
+    {
+      auto const pending = ++pending_;
+      auto peak = peak_pending_.load();
+      while (pending > peak and not peak_pending_.compare_exchange_weak(peak, pending)) {}
+
+      experimental::async_promise<double> calibration;
+      auto result = calibration.get_future();
+      std::lock_guard lock{mutex_};
+      threads_.emplace_back([this, number, calibration = std::move(calibration)]() mutable {
+        experimental::sleep_for(service_latency);
+        --pending_;
+        calibration.set_value(1.5 * number);
+      });
+      return result;
+    }
+
+    // Largest number of requests for which the service had not yet delivered its answer
+    unsigned int peak_pending() const { return peak_pending_.load(); }
+
+  private:
+    mutable std::atomic<unsigned int> pending_{};
+    mutable std::atomic<unsigned int> peak_pending_{};
+    mutable std::mutex mutex_;
+    mutable std::vector<std::jthread> threads_; // Joined when the service is destroyed
+  };
+
+  // Sum of 0, 1, ..., max_events-1
+  constexpr double sum_of_numbers = max_events * (max_events - 1) / 2.;
+
+  unsigned int provide_number(data_cell_index const& id) { return id.number(); }
+
+  void add(std::atomic<double>& sum, double value) { sum += value; }
+}
+
+TEST_CASE("Asynchronous transform does not park worker threads", "[graph]")
+{
+  experimental::layer_generator gen;
+  gen.add_layer("event", {"job", max_events});
+
+  experimental::framework_graph g{driver_for_test(gen), 1};
+
+  g.provide("provide_number", provide_number, concurrency::unlimited)
+    .output_product("number"_in("event"));
+
+  conditions_service const service;
+  g.async_transform(
+     "lookup_calibration",
+     [&service](unsigned int number) { return service.calibration_for(number); },
+     concurrency::unlimited)
+    .input_family("number"_in("event"))
+    .output_products("calibration");
+
+  g.transform(
+     "burn_cpu",
+     [](unsigned int number) {
+       experimental::spin_for(cpu_work);
+       return number;
+     },
+     concurrency::unlimited)
+    .input_family("number"_in("event"))
+    .output_products("work");
+
+  g.observe("verify_calibration",
+            [](unsigned int number, double calibration) { CHECK(calibration == 1.5 * number); })
+    .input_family("number"_in("event"), "calibration"_in("event"));
+
+  g.fold("sum_calibrations", add, concurrency::unlimited)
+    .input_family("calibration"_in("event"))
+    .output_products("calibration_sum");
+  g.fold("sum_work", add, concurrency::unlimited)
+    .input_family("work"_in("event"))
+    .output_products("work_sum");
+
+  g.observe("verify_calibration_sum", [](double sum) { CHECK(sum == 1.5 * sum_of_numbers); })
+    .input_family("calibration_sum"_in("job"));
+  g.observe("verify_work_sum", [](double sum) { CHECK(sum == sum_of_numbers); })
+    .input_family("work_sum"_in("job"));
+
+  auto const begin = steady_clock::now();
+  g.execute();
+  auto const elapsed = steady_clock::now() - begin;
+
+  CHECK(g.execution_count("lookup_calibration") == max_events);
+  CHECK(g.execution_count("burn_cpu") == max_events);
+  CHECK(g.execution_count("verify_calibration") == max_events);
+  CHECK(g.execution_count("verify_calibration_sum") == 1);
+  CHECK(g.execution_count("verify_work_sum") == 1);
+
+  // With one worker thread, a blocking implementation would wait for each service request
+  // to be answered before making the next one, so at most one request would be in flight.
+  // With the asynchronous transform, the requests overlap with each other and with the
+  // CPU-bound work.
+  CHECK(service.peak_pending() > 1u);
+
+  // The timing is only reported: a blocking implementation requires at least
+  // max_events * (service_latency + cpu_work) of wall-clock time.
+  auto const blocking_time = max_events * (service_latency + cpu_work);
+  spdlog::info("Asynchronous transform test took {} (a blocking implementation: at least {})",
+               duration_cast<milliseconds>(elapsed),
+               duration_cast<milliseconds>(blocking_time));
+}
+
+TEST_CASE("Asynchronous transform propagates exceptions", "[graph]")
+{
+  experimental::layer_generator gen;
+  gen.add_layer("event", {"job", 1u});
+
+  std::jthread service_thread;
+  experimental::framework_graph g{driver_for_test(gen)};
+
+  g.provide("provide_number", provide_number, concurrency::unlimited)
+    .output_product("number"_in("event"));
+  g.async_transform("throw_later",
+                    [&service_thread](unsigned int) {
+                      experimental::async_promise<int> never_made;
+                      auto result = never_made.get_future();
+                      service_thread = std::jthread{[p = std::move(never_made)]() mutable {
+                        p.set_exception(
+                          std::make_exception_ptr(std::runtime_error("Service unavailable")));
+                      }};
+                      return result;
+                    })
+    .input_family("number"_in("event"))
+    .output_products("never_made");
+
+  CHECK_THROWS_WITH(g.execute(), "Service unavailable");
+}
@@ -1,14 +1,19 @@
 #include "phlex/core/concepts.hpp"
 #include "phlex/core/framework_graph.hpp"
+#include "phlex/utilities/async_future.hpp"
 
 using namespace phlex::experimental;
 
 namespace {
   int transform [[maybe_unused]] (double&) { return 1; };
   void not_a_transform [[maybe_unused]] (int) {}
+  async_future<int> async_transform [[maybe_unused]] (int) { return {}; }
 
   struct A {
     int call(int, int) const noexcept { return 1; };
+    void save(product_store const&) {}
+    void save_shared(product_store_const_ptr const&) {}
+    async_future<void> save_async(product_store_const_ptr const&) { return {}; }
   };
 }
 
@@ -18,6 +23,14 @@ int main()
   static_assert(is_transform_like<decltype(&A::call)>);
   static_assert(not is_transform_like<decltype(not_a_transform)>);
 
+  static_assert(is_async_transform_like<decltype(async_transform)>);
+  static_assert(not is_async_transform_like<decltype(transform)>);
+
   static_assert(not is_observer_like<decltype(transform)>);
   static_assert(is_observer_like<decltype(not_a_transform)>);
+
+  static_assert(is_output_like<decltype(&A::save)>);
+  static_assert(is_output_like<decltype(&A::save_shared)>);
+  static_assert(is_output_like<decltype(&A::save_async)>);
+  static_assert(not is_output_like<decltype(&A::call)>);
 }
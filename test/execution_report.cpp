@@ -0,0 +1,85 @@
+// =======================================================================================
+/*
+   This test checks the execution report of a graph whose throughput is limited by a
+   serial observer:
+
+     [driver] -> provide_number -> square -> slow_sink (serial)
+
+   The transform may run concurrently, but each invocation of the observer takes longer
+   than the other nodes combined.  The report must therefore identify the observer as the
+   serial bottleneck of the job.
+*/
+// =======================================================================================
+
+#include "phlex/core/framework_graph.hpp"
+#include "phlex/model/data_cell_index.hpp"
+#include "plugins/layer_generator.hpp"
+
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/matchers/catch_matchers_string.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+using namespace phlex;
+using namespace std::chrono_literals;
+
+namespace {
+  constexpr auto n_events = 20u;
+
+  unsigned int provide_number(data_cell_index const& id) { return id.number(); }
+
+  unsigned int square(unsigned int const number)
+  {
+    std::this_thread::sleep_for(1ms);
+    return number * number;
+  }
+
+  void slow_sink(unsigned int) { std::this_thread::sleep_for(10ms); }
+}
+
+TEST_CASE("Execution report of a job limited by a serial node", "[graph]")
+{
+  experimental::layer_generator gen;
+  gen.add_layer("event", {"job", n_events});
+
+  experimental::framework_graph g{driver_for_test(gen), 4};
+  g.enable_execution_report();
+
+  g.provide("provide_number", provide_number, concurrency::unlimited)
+    .output_product("number"_in("event"));
+  g.transform("square", square, concurrency::unlimited)
+    .input_family("number"_in("event"))
+    .output_products("squared_number");
+  g.observe("slow_sink", slow_sink).input_family("squared_number"_in("event"));
+
+  g.execute();
+
+  auto const& report = g.execution_report();
+  REQUIRE(report);
+  CHECK(report->threads == 4u);
+  CHECK(report->utilization_over_time.size() == 10u);
+  CHECK(report->utilization > 0.);
+  CHECK(report->utilization <= 1.);
+
+  // The critical path runs from the driver through the provider and the transform to the
+  // observer, and it cannot be longer than the job.
+  CHECK(report->critical_path_length >= 4u);
+  CHECK(report->critical_path_time > 0.);
+  CHECK(report->critical_path_time <= report->real_time);
+
+  auto const& nodes = report->nodes;
+  REQUIRE_FALSE(nodes.empty());
+  CHECK(nodes.front().name == "slow_sink");
+  CHECK(nodes.front().kind == "observer");
+  CHECK(nodes.front().invocations == n_events);
+  CHECK(nodes.front().peak_concurrency == 1u);
+
+  auto const square_usage =
+    std::ranges::find(nodes, "square", &experimental::execution_summary::node_usage::name);
+  REQUIRE(square_usage != nodes.end());
+  CHECK(square_usage->invocations == n_events);
+
+  CHECK_THAT(report->verdict, Catch::Matchers::ContainsSubstring("serial node 'slow_sink'"));
+}
@@ -0,0 +1,115 @@
+// Copyright (C) 2025 ...
+
+// Writes small scalars next to large vectors through the ROOT TTree backend, then checks that
+// the baskets were sized from the measured entries (apart from the one with a fixed size),
+// that the tree was flushed in clusters, and that the products are read back unchanged.
+
+#include "form/form.hpp"
+#include "form/segment_id.hpp"
+#include "form/technology.hpp"
+
+#include "TBranch.h"
+#include "TFile.h"
+#include "TTree.h"
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+  int const n_segments = 2000;
+  int const waveform_size = 5000;
+  int const fixed_basket_size = 8192;
+  std::string const creator = "tuning";
+
+  form::experimental::segment_id make_id(int segment)
+  {
+    std::uint64_t const numbers[] = {static_cast<std::uint64_t>(segment)};
+    return {1, numbers};
+  }
+
+  std::vector<float> make_waveform(int segment)
+  {
+    std::vector<float> waveform(waveform_size);
+    for (int i = 0; i != waveform_size; ++i) {
+      waveform[i] = static_cast<float>((segment + i) % 100);
+    }
+    return waveform;
+  }
+}
+
+int main(int argc, char** argv)
+{
+  std::string const filename = (argc > 1) ? argv[1] : "basket_tuning.root";
+  int const technology = form::technology::ROOT_TTREE;
+
+  form::experimental::config::output_item_config output_config;
+  output_config.addItem("number", filename, technology);
+  output_config.addItem("waveform", filename, technology);
+  form::experimental::config::tech_setting_config tech_config;
+  tech_config.container_settings[technology][creator + "/number"] = {
+    {"basket_size", std::to_string(fixed_basket_size)}};
+  tech_config.container_settings[technology][creator + "/waveform"] = {
+    {"basket_sample", "50"}, {"auto_flush", "-4000000"}, {"report", "true"}};
+
+  {
+    form::experimental::form_interface form(output_config, tech_config);
+    for (int s = 0; s != n_segments; ++s) {
+      auto const waveform = make_waveform(s);
+      form.write(creator,
+                 make_id(s),
+                 {{"number", &s, &typeid(int)},
+                  {"waveform", &waveform, &typeid(std::vector<float>)}});
+    }
+  }
+
+  int errors = 0;
+  {
+    std::unique_ptr<TFile> file{TFile::Open(filename.c_str(), "READ")};
+    auto* tree = file->Get<TTree>(creator.c_str());
+    if (tree == nullptr) {
+      std::cerr << "No tree " << creator << " in " << filename << '\n';
+      return 1;
+    }
+    // About 20 kB per entry, so that a cluster of 4 MB holds about 200 entries
+    auto const flush_entries = tree->GetAutoFlush();
+    if (flush_entries < 100 || flush_entries > 400) {
+      std::cerr << "Unexpected number of entries per cluster: " << flush_entries << '\n';
+      ++errors;
+    }
+    auto const number_basket = tree->GetBranch("number")->GetBasketSize();
+    if (number_basket != fixed_basket_size) {
+      std::cerr << "The fixed basket size was changed to " << number_basket << '\n';
+      ++errors;
+    }
+    auto const waveform_basket = tree->GetBranch("waveform")->GetBasketSize();
+    if (waveform_basket <= 32000) {
+      std::cerr << "The waveform baskets were not resized: " << waveform_basket << '\n';
+      ++errors;
+    }
+  }
+
+  form::experimental::form_interface form(output_config, {});
+  for (int s = 0; s != n_segments; ++s) {
+    form::experimental::product_with_name number{"number", nullptr, &typeid(int)};
+    form.read(creator, make_id(s), number);
+    std::unique_ptr<int const> read_number{static_cast<int const*>(number.data)};
+    form::experimental::product_with_name waveform{
+      "waveform", nullptr, &typeid(std::vector<float>)};
+    form.read(creator, make_id(s), waveform);
+    std::unique_ptr<std::vector<float> const> read_waveform{
+      static_cast<std::vector<float> const*>(waveform.data)};
+    if (*read_number != s || *read_waveform != make_waveform(s)) {
+      if (++errors <= 10) {
+        std::cerr << "Wrong products read for segment " << s << '\n';
+      }
+    }
+  }
+  if (errors != 0) {
+    return 1;
+  }
+  std::cout << "Read back " << n_segments << " segments written with tuned baskets\n";
+  return 0;
+}
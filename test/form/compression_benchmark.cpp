@@ -0,0 +1,153 @@
+// Copyright (C) 2025 ...
+
+// Compares the write throughput and file size of the toy-tracker products for several ROOT
+// compression algorithms and levels.  The same products are written for every setting; the
+// "mixed" setting compresses the small products with LZ4 and the track points with LZMA through
+// per-container settings (TTree only, as RNTuple compresses all fields of an ntuple alike).
+//
+// Usage: compression_benchmark [ROOT_TTREE|ROOT_RNTUPLE] [segments] [file prefix] [IMT threads]
+
+#include "data_products/track_start.hpp"
+#include "form/form.hpp"
+#include "form/segment_id.hpp"
+#include "form/technology.hpp"
+#include "toy_tracker.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+  std::string const creator = "Toy_Tracker";
+
+  struct segment_products {
+    std::vector<float> track_start;
+    std::vector<int> track_n_hits;
+    std::vector<TrackStart> track_start_points;
+
+    std::size_t bytes() const
+    {
+      return track_start.size() * sizeof(float) + track_n_hits.size() * sizeof(int) +
+             track_start_points.size() * sizeof(TrackStart);
+    }
+  };
+
+  std::vector<segment_products> generate(int n_segments)
+  {
+    srand(12345);
+    ToyTracker tracker(4 * 1024);
+    std::vector<segment_products> segments(n_segments);
+    for (auto& segment : segments) {
+      int const n_x = rand() % 4096;
+      for (int i = 0; i != n_x; ++i) {
+        segment.track_start.push_back(static_cast<float>(rand() % 32768) / 32768);
+      }
+      for (int i = 0; i != 100; ++i) {
+        segment.track_n_hits.push_back(i);
+      }
+      segment.track_start_points = tracker();
+    }
+    return segments;
+  }
+
+  using container_compression = std::vector<std::pair<std::string, std::string>>;
+
+  void run(int technology,
+           std::string const& name,
+           std::string const& file_compression,
+           container_compression const& per_container,
+           std::string const& file_name,
+           int implicit_mt,
+           std::vector<segment_products> const& segments,
+           double uncompressed_bytes)
+  {
+    using namespace form::experimental;
+    config::output_item_config output_config;
+    for (auto const* label : {"trackStart", "trackNumberHits", "trackStartPoints"}) {
+      output_config.addItem(label, file_name, technology);
+    }
+    config::tech_setting_config tech_config;
+    auto& file_settings = tech_config.file_settings[technology][file_name];
+    file_settings.emplace_back("compression", file_compression);
+    if (implicit_mt > 0) {
+      file_settings.emplace_back("implicit_mt", std::to_string(implicit_mt));
+    }
+    for (auto const& [label, compression] : per_container) {
+      tech_config.container_settings[technology][creator + "/" + label].emplace_back(
+        "compression", compression);
+    }
+
+    auto const start = std::chrono::steady_clock::now();
+    {
+      form_interface form(output_config, tech_config);
+      std::uint64_t number = 0;
+      for (auto const& segment : segments) {
+        std::uint64_t const numbers[] = {number++};
+        form.write(
+          creator,
+          segment_id{1, numbers},
+          {{"trackStart", &segment.track_start, &typeid(std::vector<float>)},
+           {"trackNumberHits", &segment.track_n_hits, &typeid(std::vector<int>)},
+           {"trackStartPoints", &segment.track_start_points, &typeid(std::vector<TrackStart>)}});
+      }
+    } // The file is closed, and its last baskets or pages compressed, here
+    std::chrono::duration<double> const elapsed = std::chrono::steady_clock::now() - start;
+
+    auto const file_size = static_cast<double>(std::filesystem::file_size(file_name));
+    std::cout << std::left << std::setw(10) << name << std::right << std::fixed
+              << std::setprecision(1) << std::setw(12) << segments.size() / elapsed.count()
+              << std::setw(12) << uncompressed_bytes / elapsed.count() / 1e6 << std::setw(12)
+              << file_size / 1e6 << std::setprecision(3) << std::setw(10)
+              << file_size / uncompressed_bytes << '\n';
+  }
+}
+
+int main(int argc, char** argv)
+{
+  int const technology = (argc > 1 && std::string(argv[1]) == "ROOT_RNTUPLE")
+                           ? form::technology::ROOT_RNTUPLE
+                           : form::technology::ROOT_TTREE;
+  int const n_segments = (argc > 2) ? std::stoi(argv[2]) : 1000;
+  std::string const prefix = (argc > 3) ? argv[3] : "compression_benchmark";
+  int const implicit_mt = (argc > 4) ? std::stoi(argv[4]) : 0;
+
+  auto const segments = generate(n_segments);
+  double uncompressed_bytes = 0;
+  for (auto const& segment : segments) {
+    uncompressed_bytes += segment.bytes();
+  }
+
+  std::cout << std::left << std::setw(10) << "setting" << std::right << std::setw(12)
+            << "segments/s" << std::setw(12) << "MB/s" << std::setw(12) << "file MB"
+            << std::setw(10) << "ratio" << '\n';
+  for (auto const* compression :
+       {"none", "kLZ4:1", "kLZ4:4", "kZSTD:1", "kZSTD:5", "kZSTD:9", "kLZMA:1", "kLZMA:7"}) {
+    std::string file_name = prefix + "_" + compression + ".root";
+    std::erase(file_name, ':');
+    run(technology,
+        compression,
+        compression,
+        {},
+        file_name,
+        implicit_mt,
+        segments,
+        uncompressed_bytes);
+  }
+  if (technology == form::technology::ROOT_TTREE) {
+    run(technology,
+        "mixed",
+        "kZSTD:5",
+        {{"trackStart", "kLZ4:1"}, {"trackNumberHits", "kLZ4:1"}, {"trackStartPoints", "kLZMA:7"}},
+        prefix + "_mixed.root",
+        implicit_mt,
+        segments,
+        uncompressed_bytes);
+  }
+  return 0;
+}
@@ -1,7 +1,15 @@
 #include "core/token.hpp"
+#include "form/async_writer.hpp"
 #include "form/config.hpp"
+#include "form/parallel_writer.hpp"
+#include "form/read_ahead_reader.hpp"
+#include "form/segment_id.hpp"
+#include "form/technology.hpp"
+#include "native_storage/native_column_container.hpp"
+#include "native_storage/native_type.hpp"
 #include "persistence/persistence.hpp"
 #include "storage/istorage.hpp"
+#include "storage/segment_index.hpp"
 #include "storage/storage_association.hpp"
 #include "storage/storage_associative_container.hpp"
 #include "storage/storage_container.hpp"
@@ -9,8 +17,15 @@
 #include "util/factories.hpp"
 #include <catch2/catch_test_macros.hpp>
 
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <future>
 #include <memory>
 #include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
 
 using namespace form::detail::experimental;
 
@@ -112,8 +127,140 @@ TEST_CASE("Storage basic operations", "[form]")
   void const* read_data = nullptr;
   storage->readContainer(token, &read_data, typeid(int), settings);
 
-  int index = storage->getIndex(token, "some_id", settings);
-  CHECK(index == 0);
+  // The base container records no segment IDs, so no segment can be found
+  CHECK_THROWS_AS(storage->getIndex(token, "some_id", settings), std::runtime_error);
+}
+
+TEST_CASE("Segment ID keys", "[form]")
+{
+  using form::experimental::segment_id;
+
+  segment_id const text{"[run:1, subrun:2, event:345]"};
+  CHECK_FALSE(text.is_binary());
+  CHECK(text.key() == "[run:1, subrun:2, event:345]");
+  CHECK(text.to_string() == text.key());
+
+  std::uint64_t const numbers[] = {1, 2, 345};
+  segment_id const binary{0x1234, numbers};
+  CHECK(binary.is_binary());
+  CHECK(binary.key().size() == 1 + 8 + 4); // Tag, layer, and varint numbers (345 needs 2 bytes)
+  CHECK(binary.to_string() == "[layer 0000000000001234: 1, 2, 345]");
+
+  std::uint64_t const other_numbers[] = {1, 2, 346};
+  CHECK(binary != segment_id{0x1234, other_numbers});
+  CHECK(binary != segment_id{0x1235, numbers});
+  CHECK(binary == segment_id{0x1234, numbers});
+
+  CHECK_THROWS_AS(segment_id(binary.key()), std::runtime_error);
+
+  // Keys read back from an index container
+  CHECK(binary.layer() == 0x1234);
+  CHECK(binary.numbers() == std::vector<std::uint64_t>{1, 2, 345});
+  CHECK(segment_id::from_key(binary.key()) == binary);
+  CHECK(segment_id::from_key(text.key()) == text);
+  CHECK_THROWS_AS(text.numbers(), std::runtime_error);
+  CHECK_THROWS_AS(segment_id::from_key(std::string(1, '\0')), std::runtime_error);
+}
+
+TEST_CASE("Segment index round trip", "[form]")
+{
+  auto const indexFile =
+    (std::filesystem::temp_directory_path() / "form_segment_index_test.fidx").string();
+
+  Segment_Index_Writer writer;
+  for (int i = 0; i != 1000; ++i) {
+    CHECK(writer.add("creator/index", "[EVENT=" + std::to_string(i) + "]") == i);
+  }
+  CHECK(writer.add("other/index", "[EVENT=7]") == 0);
+  CHECK(writer.add("other/index", "[EVENT=7]") == 1); // Duplicates resolve to the first row
+  writer.write(indexFile);
+
+  auto reader = Segment_Index_Reader::open(indexFile);
+  REQUIRE(reader != nullptr);
+  CHECK(reader->hasContainer("creator/index"));
+  CHECK(reader->hasContainer("other/index"));
+  CHECK_FALSE(reader->hasContainer("missing/index"));
+  for (int i = 0; i != 1000; ++i) {
+    CHECK(reader->find("creator/index", "[EVENT=" + std::to_string(i) + "]") == i);
+  }
+  CHECK(reader->find("other/index", "[EVENT=7]") == 0);
+  CHECK_FALSE(reader->find("creator/index", "[EVENT=1000]").has_value());
+  CHECK_FALSE(reader->find("missing/index", "[EVENT=1]").has_value());
+
+  std::filesystem::remove(indexFile);
+  CHECK(Segment_Index_Reader::open(indexFile) == nullptr);
+}
+
+TEST_CASE("Storage persists the segment index", "[form]")
+{
+  auto const fileName =
+    (std::filesystem::temp_directory_path() / "form_segment_index_storage.root").string();
+  form::experimental::config::tech_setting_config settings;
+  {
+    auto storage = createStorage();
+    std::map<std::unique_ptr<Placement>, std::type_info const*> containers;
+    containers.emplace(std::make_unique<Placement>(fileName, "creator/index", 0),
+                       &typeid(std::string));
+    storage->createContainers(containers, settings);
+
+    Placement index(fileName, "creator/index", 0);
+    storage->fillIndex(index, "seg_a");
+    storage->fillIndex(index, "seg_b");
+    storage->fillIndex(index, "seg_c");
+    CHECK_NOTHROW(storage->close());
+    REQUIRE(std::filesystem::exists(segmentIndexFileName(fileName)));
+    CHECK_NOTHROW(storage->close());
+  }
+
+  auto storage = createStorage();
+  Token token(fileName, "creator/index", 0);
+  CHECK(storage->getIndex(token, "seg_a", settings) == 0);
+  CHECK(storage->getIndex(token, "seg_c", settings) == 2);
+  CHECK(storage->getIndex(token, "seg_b", settings) == 1);
+  CHECK_THROWS_AS(storage->getIndex(token, "seg_d", settings), std::runtime_error);
+
+  std::filesystem::remove(segmentIndexFileName(fileName));
+}
+
+TEST_CASE("Storage reports segment index write errors on close", "[form]")
+{
+  auto const fileName =
+    (std::filesystem::temp_directory_path() / "form_missing_directory" / "data.root").string();
+  form::experimental::config::tech_setting_config settings;
+  auto storage = createStorage();
+  std::map<std::unique_ptr<Placement>, std::type_info const*> containers;
+  containers.emplace(std::make_unique<Placement>(fileName, "creator/index", 0),
+                     &typeid(std::string));
+  storage->createContainers(containers, settings);
+  storage->fillIndex(Placement(fileName, "creator/index", 0), "seg");
+  CHECK_THROWS_AS(storage->close(), std::runtime_error);
+}
+
+TEST_CASE("Storage container handles", "[form]")
+{
+  auto storage = createStorage();
+  form::experimental::config::tech_setting_config settings;
+
+  std::map<std::unique_ptr<Placement>, std::type_info const*> containers;
+  containers.emplace(std::make_unique<Placement>("handles.root", "creator/prod", 0), &typeid(int));
+  containers.emplace(std::make_unique<Placement>("handles.root", "creator/index", 0),
+                     &typeid(std::string));
+  storage->createContainers(containers, settings);
+
+  Placement const prod("handles.root", "creator/prod", 0);
+  auto container = storage->getContainer(prod);
+  REQUIRE(container != nullptr);
+  CHECK(container == storage->getContainer(prod));
+  CHECK(container->name() == "creator/prod");
+
+  Placement const index("handles.root", "creator/index", 0);
+  auto index_container = storage->getIndexContainer(index);
+  CHECK(index_container == storage->getIndexContainer(index));
+  std::string const id = "seg";
+  CHECK_NOTHROW(index_container->fill(&id));
+
+  CHECK_THROWS_AS(storage->getContainer(Placement("handles.root", "creator/missing", 0)),
+                  std::runtime_error);
 }
 
 TEST_CASE("Persistence basic operations", "[form]")
@@ -136,14 +283,57 @@ TEST_CASE("Persistence basic operations", "[form]")
     products["prod"] = &typeid(int);
     products["parent/child"] = &typeid(double);
     CHECK_NOTHROW(p->createContainers("my_creator", products));
+    CHECK(p->hasContainer("my_creator", "prod"));
+    CHECK(p->hasContainer("my_creator", "parent/child"));
+    CHECK_FALSE(p->hasContainer("my_creator", "unknown"));
+    CHECK_FALSE(p->hasContainer("other_creator", "prod"));
 
     int val = 42;
+    double dval = 4.2;
     CHECK_NOTHROW(p->registerWrite("my_creator", "prod", &val, typeid(int)));
     CHECK_NOTHROW(p->commitOutput("my_creator", "event_1"));
+    // Products written in a different order are still found
+    CHECK_NOTHROW(p->registerWrite("my_creator", "parent/child", &dval, typeid(double)));
+    CHECK_NOTHROW(p->registerWrite("my_creator", "prod", &val, typeid(int)));
+    CHECK_NOTHROW(p->commitOutput("my_creator", "event_2"));
+    CHECK_THROWS_AS(p->registerWrite("my_creator", "unknown", &val, typeid(int)),
+                    std::runtime_error);
 
     void const* data = nullptr;
-    // This will call getToken -> getIndex (returns 0 for Storage_Container) -> readContainer
-    CHECK_NOTHROW(p->read("my_creator", "prod", "event_1", &data, typeid(int)));
+    // This will call getToken -> getIndex, which cannot find the segment because the base
+    // Storage_Container does not record the segment IDs written to it
+    CHECK_THROWS_AS(p->read("my_creator", "prod", "event_1", &data, typeid(int)),
+                    std::runtime_error);
+  }
+
+  SECTION("Bound products")
+  {
+    // Binding creates the missing containers and writes the products by position
+    auto const binding =
+      p->bindProducts("my_creator", {{"parent/child", &typeid(double)}, {"prod", &typeid(int)}});
+    CHECK(p->hasContainer("my_creator", "prod"));
+    CHECK(p->hasContainer("my_creator", "parent/child"));
+
+    int val = 42;
+    double dval = 4.2;
+    CHECK_NOTHROW(p->registerWrite(binding, 0, &dval));
+    CHECK_NOTHROW(p->registerWrite(binding, 1, &val));
+    CHECK_NOTHROW(p->commitOutput(binding, std::string{"event_1"}));
+
+    // A binding for another order of the same products reuses the containers
+    auto const reordered =
+      p->bindProducts("my_creator", {{"prod", &typeid(int)}, {"parent/child", &typeid(double)}});
+    CHECK(reordered != binding);
+    CHECK_NOTHROW(p->registerWrite(reordered, 0, &val));
+    CHECK_NOTHROW(p->registerWrite(reordered, 1, &dval));
+    CHECK_NOTHROW(p->commitOutput(reordered, std::string{"event_2"}));
+
+    // Binding the same products again returns the existing handles
+    CHECK(p->bindProducts("my_creator",
+                          {{"parent/child", &typeid(double)}, {"prod", &typeid(int)}}) == binding);
+    CHECK(p->bindProducts("my_creator",
+                          {{"prod", &typeid(int)}, {"parent/child", &typeid(double)}}) ==
+          reordered);
   }
 
   SECTION("Errors")
@@ -151,9 +341,329 @@ TEST_CASE("Persistence basic operations", "[form]")
     int val = 42;
     CHECK_THROWS_AS(p->registerWrite("my_creator", "unknown", &val, typeid(int)),
                     std::runtime_error);
+    CHECK_THROWS_AS(p->bindProducts("my_creator", {{"unknown", &typeid(int)}}),
+                    std::runtime_error);
   }
 }
 
+TEST_CASE("Write-behind FORM output", "[form]")
+{
+  using namespace form::experimental;
+  auto const fileName =
+    (std::filesystem::temp_directory_path() / "form_async_writer_test.root").string();
+
+  config::output_item_config out_cfg;
+  out_cfg.addItem("prod", fileName, 0);
+  config::tech_setting_config tech_cfg;
+
+  std::weak_ptr<void const> last_owner;
+  {
+    async_writer writer{std::make_unique<form_interface>(out_cfg, tech_cfg), 2};
+    std::future<void> last_write;
+    for (int i = 0; i != 100; ++i) {
+      auto owner = std::make_shared<int>(i);
+      last_owner = owner;
+      last_write = writer.write("creator",
+                                segment_id{"seg_" + std::to_string(i)},
+                                {{"prod", owner.get(), &typeid(int)}},
+                                std::move(owner));
+    }
+    CHECK_NOTHROW(last_write.get());
+    writer.drain();
+    CHECK(last_owner.expired());
+
+    // Errors from the writer thread are reported through the future of the failed write
+    int value = 0;
+    auto bad_write =
+      writer.write("creator", segment_id{"bad"}, {{"unknown", &value, &typeid(int)}}, nullptr);
+    CHECK_THROWS_AS(bad_write.get(), std::runtime_error);
+    CHECK_NOTHROW(writer.drain());
+
+    writer.close();
+    CHECK_THROWS_AS(writer.write("creator", segment_id{"late"}, {}, nullptr), std::runtime_error);
+  }
+
+  // All segments were written, in order
+  auto storage = createStorage();
+  Token token(fileName, "creator/index", 0);
+  CHECK(storage->getIndex(token, "seg_0", tech_cfg) == 0);
+  CHECK(storage->getIndex(token, "seg_99", tech_cfg) == 99);
+
+  std::filesystem::remove(segmentIndexFileName(fileName));
+}
+
+TEST_CASE("Parallel FORM output", "[form]")
+{
+  using namespace form::experimental;
+  auto const fileName =
+    (std::filesystem::temp_directory_path() / "form_parallel_writer_test.root").string();
+
+  config::output_item_config out_cfg;
+  out_cfg.addItem("prod", fileName, 0);
+  config::tech_setting_config tech_cfg;
+
+  // Storages whose output is merged leave the segment index to be rebuilt after merging
+  {
+    auto storage = createStorage('m');
+    std::map<std::unique_ptr<Placement>, std::type_info const*> containers;
+    containers.emplace(std::make_unique<Placement>(fileName, "creator/index", 0),
+                       &typeid(std::string));
+    storage->createContainers(containers, tech_cfg);
+    storage->fillIndex(Placement(fileName, "creator/index", 0), "seg");
+  }
+  CHECK_FALSE(std::filesystem::exists(segmentIndexFileName(fileName)));
+
+  parallel_writer writer{out_cfg, tech_cfg};
+  {
+    std::vector<std::jthread> threads;
+    for (int t = 0; t != 4; ++t) {
+      threads.emplace_back([&writer, t] {
+        for (int i = 0; i != 100; ++i) {
+          int const value = t * 100 + i;
+          writer.write("creator",
+                       segment_id{"seg_" + std::to_string(value)},
+                       {{"prod", &value, &typeid(int)}});
+        }
+      });
+    }
+  }
+  CHECK_NOTHROW(writer.close());
+  CHECK_NOTHROW(writer.close());
+  int value = 0;
+  CHECK_THROWS_AS(writer.write("creator", segment_id{"late"}, {{"prod", &value, &typeid(int)}}),
+                  std::runtime_error);
+  // The segment index is rebuilt from the merged file
+  CHECK(std::filesystem::exists(segmentIndexFileName(fileName)));
+
+  std::filesystem::remove(segmentIndexFileName(fileName));
+}
+
+namespace {
+  struct NativePoint {
+    float x;
+    float y;
+    int hits;
+    bool operator==(NativePoint const&) const = default;
+  };
+}
+
+TEST_CASE("Native column storage", "[form]")
+{
+  using namespace form::experimental;
+  register_native_type<NativePoint>("NativePoint");
+  auto const fileName = (std::filesystem::temp_directory_path() / "form_native_test").string();
+  int const tech = form::technology::NATIVE_COLUMN;
+
+  config::output_item_config out_cfg;
+  out_cfg.addItem("number", fileName, tech);
+  out_cfg.addItem("values", fileName, tech);
+  out_cfg.addItem("point", fileName, tech);
+  config::tech_setting_config tech_cfg;
+  tech_cfg.container_settings[tech]["creator/values"] = {{"buffer_size", "64"}};
+
+  {
+    form_interface form(out_cfg, tech_cfg);
+    for (int i = 0; i != 100; ++i) {
+      std::vector<float> const values(i % 5, static_cast<float>(i));
+      NativePoint const point{1.5f * i, -1.5f * i, i};
+      form.write("creator",
+                 segment_id{"seg_" + std::to_string(i)},
+                 {{"number", &i, &typeid(int)},
+                  {"values", &values, &typeid(std::vector<float>)},
+                  {"point", &point, &typeid(NativePoint)}});
+    }
+  }
+  REQUIRE(std::filesystem::exists(segmentIndexFileName(fileName)));
+
+  form_interface form(out_cfg, tech_cfg);
+  for (int i : {0, 1, 42, 99}) {
+    segment_id const id{"seg_" + std::to_string(i)};
+    product_with_name number{"number", nullptr, &typeid(int)};
+    form.read("creator", id, number);
+    std::unique_ptr<int const> read_number{static_cast<int const*>(number.data)};
+    CHECK(*read_number == i);
+
+    product_with_name values{"values", nullptr, &typeid(std::vector<float>)};
+    form.read("creator", id, values);
+    std::unique_ptr<std::vector<float> const> read_values{
+      static_cast<std::vector<float> const*>(values.data)};
+    CHECK(*read_values == std::vector<float>(i % 5, static_cast<float>(i)));
+
+    product_with_name point{"point", nullptr, &typeid(NativePoint)};
+    form.read("creator", id, point);
+    std::unique_ptr<NativePoint const> read_point{static_cast<NativePoint const*>(point.data)};
+    CHECK(*read_point == NativePoint{1.5f * i, -1.5f * i, i});
+  }
+
+  // Records can be read in place, and the column type is checked
+  auto file = createFile(tech, fileName, 'i');
+  Native_Column_ContainerImp column("creator/point");
+  column.setFile(file);
+  CHECK(column.rows() == 100);
+  auto const record = column.view(7);
+  REQUIRE(record.size() == sizeof(NativePoint));
+  CHECK(reinterpret_cast<NativePoint const*>(record.data())->hits == 7);
+  CHECK(column.view(100).empty());
+  void const* data = nullptr;
+  CHECK_FALSE(column.read(100, &data, typeid(NativePoint)));
+  CHECK_THROWS_AS(column.read(0, &data, typeid(double)), std::runtime_error);
+
+  // Variable-size records are aligned for their elements
+  Native_Column_ContainerImp values_column("creator/values");
+  values_column.setFile(file);
+  for (std::uint64_t row : {1u, 2u, 3u, 6u}) {
+    auto const values = values_column.view(row);
+    REQUIRE(values.size() == (row % 5) * sizeof(float));
+    CHECK(reinterpret_cast<std::uintptr_t>(values.data()) % 8 == 0);
+    CHECK(reinterpret_cast<float const*>(values.data())[0] == static_cast<float>(row));
+  }
+
+  // Records written so far can be read while the column is being written
+  Native_Column_ContainerImp scratch("creator/scratch");
+  scratch.setFile(createFile(tech, fileName + "_scratch", 'o'));
+  scratch.setupWrite(typeid(std::string));
+  std::string const text = "hello";
+  scratch.fill(&text);
+  REQUIRE(scratch.read(0, &data, typeid(std::string)));
+  std::unique_ptr<std::string const> read_text{static_cast<std::string const*>(data)};
+  CHECK(*read_text == text);
+
+  CHECK_THROWS_AS(Native_Column_ContainerImp("creator/bad").setupWrite(typeid(int)),
+                  std::runtime_error);
+
+  // A native file is rewritten in place, but other directories are never written into
+  auto const otherDir = std::filesystem::temp_directory_path() / "form_native_other";
+  std::filesystem::create_directories(otherDir);
+  std::ofstream{otherDir / "data.txt"} << "keep";
+  CHECK_THROWS_AS(createFile(tech, otherDir.string(), 'o'), std::runtime_error);
+  CHECK(std::filesystem::exists(otherDir / "data.txt"));
+  std::filesystem::remove_all(otherDir);
+
+  std::filesystem::remove_all(fileName);
+  std::filesystem::remove_all(fileName + "_scratch");
+  std::filesystem::remove(segmentIndexFileName(fileName));
+}
+
+TEST_CASE("Products of the same types are written by label", "[form]")
+{
+  using namespace form::experimental;
+  auto const fileName = (std::filesystem::temp_directory_path() / "form_labels_test").string();
+  int const tech = form::technology::NATIVE_COLUMN;
+
+  config::output_item_config out_cfg;
+  out_cfg.addItem("first", fileName, tech);
+  out_cfg.addItem("second", fileName, tech);
+  config::tech_setting_config tech_cfg;
+
+  {
+    // The creator alternates between two orders of products with the same types
+    form_interface form(out_cfg, tech_cfg);
+    for (int i = 0; i != 10; ++i) {
+      int const first = i;
+      int const second = -i;
+      std::vector<product_with_name> products{{"first", &first, &typeid(int)},
+                                              {"second", &second, &typeid(int)}};
+      if (i % 2 != 0) {
+        std::swap(products[0], products[1]);
+      }
+      form.write("creator", segment_id{"seg_" + std::to_string(i)}, products);
+    }
+    form.close();
+  }
+
+  form_interface form(out_cfg, tech_cfg);
+  for (int i = 0; i != 10; ++i) {
+    segment_id const id{"seg_" + std::to_string(i)};
+    product_with_name first{"first", nullptr, &typeid(int)};
+    form.read("creator", id, first);
+    std::unique_ptr<int const> read_first{static_cast<int const*>(first.data)};
+    CHECK(*read_first == i);
+
+    product_with_name second{"second", nullptr, &typeid(int)};
+    form.read("creator", id, second);
+    std::unique_ptr<int const> read_second{static_cast<int const*>(second.data)};
+    CHECK(*read_second == -i);
+  }
+
+  std::filesystem::remove_all(fileName);
+  std::filesystem::remove(segmentIndexFileName(fileName));
+}
+
+TEST_CASE("Read-ahead FORM input", "[form]")
+{
+  using namespace form::experimental;
+  auto const fileName = (std::filesystem::temp_directory_path() / "form_read_ahead_test").string();
+  int const tech = form::technology::NATIVE_COLUMN;
+
+  config::output_item_config out_cfg;
+  out_cfg.addItem("number", fileName, tech);
+  out_cfg.addItem("values", fileName, tech);
+  config::tech_setting_config tech_cfg;
+
+  std::uint64_t constexpr event_layer = 7;
+  auto const event = [](std::uint64_t number) {
+    std::uint64_t const numbers[] = {number};
+    return segment_id{event_layer, numbers};
+  };
+  {
+    form_interface form(out_cfg, tech_cfg);
+    for (int i = 0; i != 50; ++i) {
+      std::vector<float> const values(i % 3, static_cast<float>(i));
+      form.write("creator",
+                 event(i),
+                 {{"number", &i, &typeid(int)}, {"values", &values, &typeid(std::vector<float>)}});
+    }
+  }
+
+  read_ahead_reader reader(out_cfg, tech_cfg, 4);
+  reader.add_product(
+    "creator",
+    "number",
+    typeid(int),
+    [](void const* product) { delete static_cast<int const*>(product); },
+    event_layer);
+  reader.add_product(
+    "creator",
+    "values",
+    typeid(std::vector<float>),
+    [](void const* product) { delete static_cast<std::vector<float> const*>(product); },
+    event_layer);
+
+  auto const ids = reader.read_segment_ids("creator");
+  REQUIRE(ids.size() == 50);
+  CHECK(ids[17] == event(17));
+
+  auto const check = [&](int i) {
+    auto const number = reader.read("creator", ids[i], "number");
+    CHECK(*static_cast<int const*>(number.get()) == i);
+    auto const values = reader.read("creator", ids[i], "values");
+    CHECK(*static_cast<std::vector<float> const*>(values.get()) ==
+          std::vector<float>(i % 3, static_cast<float>(i)));
+  };
+
+  // Consumers that keep up with the read-ahead window
+  for (int i = 0; i != 20; ++i) {
+    reader.prefetch(ids[i]);
+    if (i >= 2) {
+      check(i - 2);
+    }
+  }
+  check(18);
+  check(19);
+
+  // Segments that are dropped from the window, or never prefetched, are read on demand
+  for (int i = 20; i != 40; ++i) {
+    reader.prefetch(ids[i]);
+  }
+  for (int i = 20; i != 50; ++i) {
+    check(i);
+  }
+  CHECK_THROWS_AS(reader.read("creator", ids[0], "unknown"), std::runtime_error);
+
+  std::filesystem::remove_all(fileName);
+  std::filesystem::remove(segmentIndexFileName(fileName));
+}
+
 TEST_CASE("form::experimental::config tests", "[form]")
 {
   using namespace form::experimental::config;
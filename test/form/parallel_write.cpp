@@ -0,0 +1,114 @@
+// Copyright (C) 2025 ...
+
+// Writes segments from several threads through a parallel_writer, then checks that every
+// segment can be found through the segment index and read back with the values it was
+// written with.
+
+#include "form/form.hpp"
+#include "form/parallel_writer.hpp"
+#include "form/segment_id.hpp"
+#include "form/technology.hpp"
+
+#include "storage/segment_index.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+  int const n_threads = 4;
+  int const n_segments = 2500; // Per thread
+  std::uint64_t const event_layer = 1;
+  std::string const creator = "parallel";
+
+  form::experimental::segment_id make_id(int thread, int segment)
+  {
+    std::uint64_t const numbers[] = {static_cast<std::uint64_t>(thread),
+                                     static_cast<std::uint64_t>(segment)};
+    return {event_layer, numbers};
+  }
+
+  std::vector<int> make_values(int thread, int segment)
+  {
+    return std::vector<int>(segment % 7 + 1, thread * n_segments + segment);
+  }
+
+  std::vector<float> make_weights(int thread, int segment)
+  {
+    return {static_cast<float>(thread), static_cast<float>(segment)};
+  }
+}
+
+int main(int argc, char** argv)
+{
+  std::string const filename = (argc > 1) ? argv[1] : "parallel_write.root";
+  int const technology = (argc > 2 && std::string(argv[2]) == "ROOT_RNTUPLE")
+                           ? form::technology::ROOT_RNTUPLE
+                           : form::technology::ROOT_TTREE;
+
+  form::experimental::config::output_item_config output_config;
+  output_config.addItem("values", filename, technology);
+  output_config.addItem("weights", filename, technology);
+  form::experimental::config::tech_setting_config tech_config;
+  if (technology == form::technology::ROOT_TTREE) {
+    tech_config.file_settings[technology][filename] = {{"merge_every", "100"}};
+  }
+
+  {
+    form::experimental::parallel_writer writer(output_config, tech_config);
+    std::vector<std::jthread> threads;
+    for (int t = 0; t != n_threads; ++t) {
+      threads.emplace_back([&writer, t] {
+        for (int s = 0; s != n_segments; ++s) {
+          auto const values = make_values(t, s);
+          auto const weights = make_weights(t, s);
+          writer.write(creator,
+                       make_id(t, s),
+                       {{"values", &values, &typeid(std::vector<int>)},
+                        {"weights", &weights, &typeid(std::vector<float>)}});
+        }
+      });
+    }
+    threads.clear();
+    writer.close();
+  }
+
+  if (!std::filesystem::exists(form::detail::experimental::segmentIndexFileName(filename))) {
+    std::cerr << "No segment index written for " << filename << '\n';
+    return 1;
+  }
+
+  form::experimental::form_interface form(output_config, {});
+  int errors = 0;
+  for (int t = 0; t != n_threads; ++t) {
+    for (int s = 0; s != n_segments; ++s) {
+      auto const id = make_id(t, s);
+      form::experimental::product_with_name values{"values", nullptr, &typeid(std::vector<int>)};
+      form.read(creator, id, values);
+      std::unique_ptr<std::vector<int> const> read_values{
+        static_cast<std::vector<int> const*>(values.data)};
+      form::experimental::product_with_name weights{
+        "weights", nullptr, &typeid(std::vector<float>)};
+      form.read(creator, id, weights);
+      std::unique_ptr<std::vector<float> const> read_weights{
+        static_cast<std::vector<float> const*>(weights.data)};
+
+      if (*read_values != make_values(t, s) || *read_weights != make_weights(t, s)) {
+        if (++errors <= 10) {
+          std::cerr << "Wrong products read for segment " << id.to_string() << '\n';
+        }
+      }
+    }
+  }
+  if (errors != 0) {
+    std::cerr << errors << " segments were read back incorrectly\n";
+    return 1;
+  }
+  std::cout << "Read back " << n_threads * n_segments << " segments written by " << n_threads
+            << " threads\n";
+  return 0;
+}
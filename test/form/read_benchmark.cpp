@@ -0,0 +1,77 @@
+// Copyright (C) 2025 ...
+
+// Writes segments holding an int and a std::vector<float>, then measures the rate at which
+// form_interface::read returns them when the segments are read in the order they were written.
+
+#include "form/form.hpp"
+#include "form/segment_id.hpp"
+#include "form/technology.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+int main(int argc, char** argv)
+{
+  using namespace form::experimental;
+  std::uint64_t const n_segments = (argc > 1) ? std::stoull(argv[1]) : 1'000'000;
+  std::string const fileName = (argc > 2) ? argv[2] : "read_benchmark.root";
+  std::string const cache_size = (argc > 3) ? argv[3] : "0";
+  int const technology = form::technology::ROOT_TTREE;
+  std::uint64_t constexpr event_layer = 1;
+
+  config::output_item_config output_config;
+  output_config.addItem("number", fileName, technology);
+  output_config.addItem("values", fileName, technology);
+
+  {
+    form_interface form(output_config, {});
+    std::vector<float> values(8);
+    for (std::uint64_t segment = 0; segment != n_segments; ++segment) {
+      int const number = static_cast<int>(segment);
+      values.assign(segment % 8, static_cast<float>(segment));
+      std::uint64_t const numbers[] = {segment};
+      form.write("bench",
+                 segment_id{event_layer, numbers},
+                 {{"number", &number, &typeid(int)},
+                  {"values", &values, &typeid(std::vector<float>)}});
+    }
+  }
+
+  config::tech_setting_config tech_config;
+  for (auto const* container : {"bench/number", "bench/values"}) {
+    tech_config.container_settings[technology][container] = {{"cache_size", cache_size},
+                                                             {"cluster_prefetch", "true"}};
+  }
+  form_interface form(output_config, tech_config);
+
+  std::uint64_t errors = 0;
+  auto const start = std::chrono::steady_clock::now();
+  for (std::uint64_t segment = 0; segment != n_segments; ++segment) {
+    std::uint64_t const numbers[] = {segment};
+    segment_id const id{event_layer, numbers};
+    product_with_name number{"number", nullptr, &typeid(int)};
+    form.read("bench", id, number);
+    std::unique_ptr<int const> number_owner{static_cast<int const*>(number.data)};
+    product_with_name values{"values", nullptr, &typeid(std::vector<float>)};
+    form.read("bench", id, values);
+    std::unique_ptr<std::vector<float> const> values_owner{
+      static_cast<std::vector<float> const*>(values.data)};
+    if (*static_cast<int const*>(number.data) != static_cast<int>(segment) ||
+        values_owner->size() != segment % 8) {
+      ++errors;
+    }
+  }
+  std::chrono::duration<double> const elapsed = std::chrono::steady_clock::now() - start;
+
+  std::cout << "Read " << n_segments << " segments: " << n_segments / elapsed.count()
+            << " segments/s\n";
+  if (errors != 0) {
+    std::cerr << errors << " segments were read back incorrectly\n";
+    return 1;
+  }
+  return 0;
+}
@@ -19,13 +19,16 @@ int main(int argc, char** argv)
   std::cout << "In main" << std::endl;
 
   std::string const filename = (argc > 1) ? argv[1] : "toy.root";
+  int const technology = (argc > 2 && std::string(argv[2]) == "ROOT_RNTUPLE")
+                           ? form::technology::ROOT_RNTUPLE
+                           : form::technology::ROOT_TTREE;
 
   // TODO: Read configuration from config file instead of hardcoding
   form::experimental::config::output_item_config output_config;
-  output_config.addItem("trackStart", filename, form::technology::ROOT_TTREE);
-  output_config.addItem("trackNumberHits", filename, form::technology::ROOT_TTREE);
-  output_config.addItem("trackStartPoints", filename, form::technology::ROOT_TTREE);
-  output_config.addItem("trackStartX", filename, form::technology::ROOT_TTREE);
+  output_config.addItem("trackStart", filename, technology);
+  output_config.addItem("trackNumberHits", filename, technology);
+  output_config.addItem("trackStartPoints", filename, technology);
+  output_config.addItem("trackStartX", filename, technology);
 
   form::experimental::config::tech_setting_config tech_config;
 
@@ -0,0 +1,109 @@
+// Copyright (C) 2025 ...
+
+// Compares text and compact binary segment IDs: size of the written file and time needed to
+// look up every segment through the persisted segment index and through a full scan of the
+// index container.
+
+#include "core/token.hpp"
+#include "form/form.hpp"
+#include "form/segment_id.hpp"
+#include "form/technology.hpp"
+#include "storage/istorage.hpp"
+#include "storage/segment_index.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+  constexpr std::uint64_t events_per_subrun = 1000;
+  constexpr std::uint64_t event_layer = 0x5eed'0001'0002'0003ull; // Stand-in for a layer hash
+
+  // Segment i as it is rendered by data_cell_index::to_string()
+  form::experimental::segment_id text_id(std::uint64_t i)
+  {
+    char text[64];
+    std::snprintf(text,
+                  sizeof(text),
+                  "[run:1, subrun:%llu, event:%llu]",
+                  static_cast<unsigned long long>(i / events_per_subrun),
+                  static_cast<unsigned long long>(i % events_per_subrun));
+    return form::experimental::segment_id{std::string(text)};
+  }
+
+  form::experimental::segment_id binary_id(std::uint64_t i)
+  {
+    std::uint64_t const numbers[] = {1, i / events_per_subrun, i % events_per_subrun};
+    return {event_layer, numbers};
+  }
+
+  double seconds_since(std::chrono::steady_clock::time_point start)
+  {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  }
+
+  template <typename MakeId>
+  void run(std::string const& label,
+           std::string const& fileName,
+           std::uint64_t n_segments,
+           MakeId make_id)
+  {
+    using namespace form::experimental;
+    config::output_item_config output_config;
+    output_config.addItem("value", fileName, form::technology::ROOT_TTREE);
+    config::tech_setting_config tech_config;
+
+    auto start = std::chrono::steady_clock::now();
+    {
+      form_interface form(output_config, tech_config);
+      for (std::uint64_t i = 0; i != n_segments; ++i) {
+        int const value = static_cast<int>(i);
+        form.write("bench", make_id(i), product_with_name{"value", &value, &typeid(int)});
+      }
+    }
+    double const write_time = seconds_since(start);
+
+    namespace fd = form::detail::experimental;
+    fd::Token const index_token{fileName, "bench/index", form::technology::ROOT_TTREE};
+    auto lookup_all = [&] {
+      auto storage = fd::createStorage();
+      auto const lookup_start = std::chrono::steady_clock::now();
+      for (std::uint64_t i = 0; i != n_segments; ++i) {
+        if (storage->getIndex(index_token, make_id(i).key(), tech_config) !=
+            static_cast<int>(i)) {
+          std::cerr << label << ": wrong row for segment " << make_id(i).to_string() << '\n';
+          std::exit(1);
+        }
+      }
+      return seconds_since(lookup_start);
+    };
+
+    double const indexed_time = lookup_all();
+    std::filesystem::remove(fd::segmentIndexFileName(fileName));
+    double const scan_time = lookup_all();
+
+    std::cout << label << ": " << n_segments << " segments, file size "
+              << std::filesystem::file_size(fileName) << " bytes, write " << write_time
+              << " s, lookup via segment index " << indexed_time << " s, lookup via scan "
+              << scan_time << " s\n";
+  }
+}
+
+int main(int argc, char** argv)
+{
+  std::uint64_t const n_segments = (argc > 1) ? std::stoull(argv[1]) : 1'000'000;
+  std::string const prefix = (argc > 2) ? argv[2] : "segment_id_benchmark";
+
+  std::cout << "Example IDs: '" << text_id(12345).to_string() << "' vs. '"
+            << binary_id(12345).to_string() << "' (" << text_id(12345).key().size() << " vs. "
+            << binary_id(12345).key().size() << " bytes)\n";
+
+  run("text IDs", prefix + "_text.root", n_segments, text_id);
+  run("binary IDs", prefix + "_binary.root", n_segments, binary_id);
+  return 0;
+}
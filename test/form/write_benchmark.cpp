@@ -0,0 +1,80 @@
+// Copyright (C) 2025 ...
+
+// Measures the rate of form_interface::write calls for 1, 10, and 100 products per segment.
+// With the default technology (0), products are handed to the no-op storage containers, so
+// that the overhead of FORM itself is measured; pass ROOT_TTREE or ROOT_RNTUPLE to include
+// ROOT's costs, or NATIVE_COLUMN for the native columns as a baseline.
+
+#include "form/form.hpp"
+#include "form/segment_id.hpp"
+#include "form/technology.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+  int technology_from(std::string const& name)
+  {
+    if (name == "ROOT_TTREE") {
+      return form::technology::ROOT_TTREE;
+    }
+    if (name == "ROOT_RNTUPLE") {
+      return form::technology::ROOT_RNTUPLE;
+    }
+    if (name == "NATIVE_COLUMN") {
+      return form::technology::NATIVE_COLUMN;
+    }
+    return std::stoi(name);
+  }
+
+  void run(int technology, std::string const& fileName, int n_products, std::uint64_t n_segments)
+  {
+    using namespace form::experimental;
+    config::output_item_config output_config;
+    std::vector<std::string> labels;
+    for (int i = 0; i != n_products; ++i) {
+      labels.push_back("product" + std::to_string(i));
+      output_config.addItem(labels.back(), fileName, technology);
+    }
+    config::tech_setting_config tech_config;
+    form_interface form(output_config, tech_config);
+
+    std::vector<int> values(n_products);
+    std::vector<product_with_name> products;
+    for (int i = 0; i != n_products; ++i) {
+      products.push_back({labels[i], &values[i], &typeid(int)});
+    }
+
+    std::uint64_t constexpr event_layer = 1;
+    auto const start = std::chrono::steady_clock::now();
+    for (std::uint64_t segment = 0; segment != n_segments; ++segment) {
+      for (auto& value : values) {
+        value = static_cast<int>(segment);
+      }
+      std::uint64_t const numbers[] = {segment};
+      form.write("bench", segment_id{event_layer, numbers}, products);
+    }
+    std::chrono::duration<double> const elapsed = std::chrono::steady_clock::now() - start;
+
+    std::cout << n_products << " product(s) per segment: " << n_segments / elapsed.count()
+              << " segments/s, " << n_segments * n_products / elapsed.count() << " products/s\n";
+  }
+}
+
+int main(int argc, char** argv)
+{
+  int const technology = (argc > 1) ? technology_from(argv[1]) : 0;
+  std::uint64_t const n_segments = (argc > 2) ? std::stoull(argv[2]) : 100'000;
+  std::string const prefix = (argc > 3) ? argv[3] : "write_benchmark";
+
+  for (int const n_products : {1, 10, 100}) {
+    run(technology,
+        prefix + "_" + std::to_string(n_products) + ".root",
+        n_products,
+        n_segments / n_products);
+  }
+  return 0;
+}
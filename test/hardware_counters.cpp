@@ -0,0 +1,87 @@
+// =======================================================================================
+/*
+   This test enables the per-node hardware counters for a small graph:
+
+     provide_number -> heavy_sum -> check_sum
+
+   Where the kernel permits counting hardware events, the counts must be attributed to the
+   nodes that incurred them: the transform executes many more instructions than the
+   provider.  Where it does not, the job must still run, and no counts are reported.
+*/
+// =======================================================================================
+
+#include "phlex/core/framework_graph.hpp"
+#include "phlex/model/data_cell_index.hpp"
+#include "plugins/layer_generator.hpp"
+
+#include "catch2/catch_test_macros.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+using namespace phlex;
+using experimental::hardware_event;
+
+namespace {
+  constexpr auto n_events = 10u;
+  constexpr std::uint64_t n_terms = 1'000'000;
+
+  unsigned int provide_number(data_cell_index const& id) { return id.number(); }
+
+  std::uint64_t heavy_sum(unsigned int const number)
+  {
+    std::uint64_t sum{};
+    for (std::uint64_t i = 0; i != n_terms; ++i) {
+      // Prevent the compiler from replacing the loop by a closed-form expression
+      sum += (i ^ number) % 7;
+    }
+    return sum;
+  }
+
+  void check_sum(std::uint64_t const sum) { CHECK(sum > 0u); }
+}
+
+TEST_CASE("Hardware counters per node", "[graph]")
+{
+  experimental::layer_generator gen;
+  gen.add_layer("event", {"job", n_events});
+
+  experimental::framework_graph g{driver_for_test(gen)};
+  g.enable_hardware_counters();
+
+  g.provide("provide_number", provide_number, concurrency::unlimited)
+    .output_product("number"_in("event"));
+  g.transform("heavy_sum", heavy_sum, concurrency::unlimited)
+    .input_family("number"_in("event"))
+    .output_products("sum");
+  g.observe("check_sum", check_sum, concurrency::unlimited).input_family("sum"_in("event"));
+
+  g.execute();
+  CHECK(g.execution_count("heavy_sum") == n_events);
+
+  auto const& report = g.hardware_counter_report();
+  REQUIRE(report);
+  if (not report->available) {
+    CHECK(report->nodes.empty());
+    return;
+  }
+
+  using node_usage = experimental::hardware_counter_summary::node_usage;
+  auto const heavy = std::ranges::find(report->nodes, "heavy_sum", &node_usage::name);
+  auto const provider = std::ranges::find(report->nodes, "provide_number", &node_usage::name);
+  REQUIRE(heavy != report->nodes.end());
+  REQUIRE(provider != report->nodes.end());
+  CHECK(heavy->kind == "transform");
+  CHECK(heavy->invocations == n_events);
+  CHECK(provider->invocations == n_events);
+
+  if (report->supported[static_cast<std::size_t>(hardware_event::instructions)]) {
+    CHECK(heavy->count(hardware_event::instructions) >= n_events * n_terms);
+    CHECK(heavy->count(hardware_event::instructions) >
+          provider->count(hardware_event::instructions));
+  }
+  if (report->supported[static_cast<std::size_t>(hardware_event::cycles)] and
+      report->supported[static_cast<std::size_t>(hardware_event::instructions)]) {
+    CHECK(heavy->instructions_per_cycle() > 0.);
+  }
+}
@@ -0,0 +1,59 @@
+#include "hierarchy.hpp"
+
+#include "phlex/model/data_cell_index.hpp"
+
+#include "benchmark/benchmark.h"
+#include "oneapi/tbb/concurrent_unordered_map.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <random>
+
+using namespace phlex;
+using namespace phlex::benchmarks;
+
+namespace {
+  void index_make_child(benchmark::State& state)
+  {
+    auto const subrun = data_cell_index::base_ptr()->make_child(0, "run")->make_child(0, "subrun");
+    std::size_t i{};
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(subrun->make_child(i++, "event"));
+    }
+    state.SetItemsProcessed(state.iterations());
+  }
+  BENCHMARK(index_make_child);
+
+  // Folds and unfolds key their per-cell state on the index itself, which exercises both
+  // the hash and the equality comparison.
+  void index_hashed_lookup(benchmark::State& state)
+  {
+    auto const events = make_events(state.range(0));
+    tbb::concurrent_unordered_map<data_cell_index, std::size_t> cache;
+    for (auto const& event : events) {
+      cache.emplace(*event, event->number());
+    }
+
+    std::size_t i{};
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(cache.find(*events[i++ % events.size()]));
+    }
+    state.SetItemsProcessed(state.iterations());
+  }
+  BENCHMARK(index_hashed_lookup)->Arg(1'000)->Arg(100'000);
+
+  void index_less_than(benchmark::State& state)
+  {
+    auto const events = make_events(state.range(0));
+    auto shuffled = events;
+    std::ranges::shuffle(shuffled, std::mt19937{});
+
+    for (auto _ : state) {
+      auto sorted = shuffled;
+      std::ranges::sort(sorted, [](auto const& a, auto const& b) { return *a < *b; });
+      benchmark::DoNotOptimize(sorted.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+  BENCHMARK(index_less_than)->Arg(1'000)->Arg(10'000);
+}
@@ -0,0 +1,83 @@
+#include "hierarchy.hpp"
+
+#include "phlex/core/detail/filter_impl.hpp"
+#include "phlex/core/filter.hpp"
+#include "phlex/core/message.hpp"
+#include "phlex/core/product_query.hpp"
+#include "phlex/core/products_consumer.hpp"
+#include "phlex/model/product_specification.hpp"
+#include "phlex/model/product_store.hpp"
+
+#include "benchmark/benchmark.h"
+#include "oneapi/tbb/flow_graph.h"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace phlex;
+using namespace phlex::experimental;
+using namespace phlex::benchmarks;
+
+namespace {
+  std::vector<std::string> predicate_names(std::size_t const n)
+  {
+    std::vector<std::string> result;
+    for (std::size_t i = 0; i != n; ++i) {
+      result.push_back("predicate_" + std::to_string(i));
+    }
+    return result;
+  }
+
+  // Minimal downstream consumer of one event-level product, whose only port discards the
+  // messages that pass the filter.
+  class discarding_consumer : public products_consumer {
+  public:
+    discarding_consumer(tbb::flow::graph& g, std::size_t const n_predicates) :
+      products_consumer{algorithm_name{"microbenchmarks", "discard"},
+                        predicate_names(n_predicates),
+                        {product_query{product_specification::create("number"), "event"}}},
+      sink_{g, tbb::flow::unlimited, [](message const&) { return tbb::flow::continue_msg{}; }}
+    {
+    }
+
+  private:
+    std::vector<tbb::flow::receiver<message>*> ports() override { return {&sink_}; }
+    std::size_t num_calls() const override { return 0; }
+    tbb::flow::receiver<message>& port_for(product_query const&) override { return sink_; }
+
+    tbb::flow::function_node<message, tbb::flow::continue_msg, tbb::flow::lightweight> sink_;
+  };
+
+  // Each data message is matched with one (accepting) result per predicate before it is
+  // forwarded downstream.
+  void filter_execute(benchmark::State& state)
+  {
+    auto const n_predicates = static_cast<std::size_t>(state.range(0));
+    auto const events = make_events(1'000);
+    std::vector<product_store_ptr> stores;
+    for (auto const& event : events) {
+      stores.push_back(std::make_shared<product_store>(event, "provider"));
+      stores.back()->add_product("number", event->number());
+    }
+
+    tbb::flow::graph g;
+    discarding_consumer consumer{g, n_predicates};
+    filter f{g, consumer};
+
+    std::size_t msg_id{};
+    for (auto _ : state) {
+      for (auto const& store : stores) {
+        f.data_port().try_put({store, msg_id});
+        for (std::size_t i = 0; i != n_predicates; ++i) {
+          f.predicate_port().try_put({msg_id, true});
+        }
+        ++msg_id;
+      }
+      g.wait_for_all();
+    }
+    state.SetItemsProcessed(state.iterations() * stores.size());
+  }
+  BENCHMARK(filter_execute)->Arg(1)->Arg(3)->UseRealTime();
+}
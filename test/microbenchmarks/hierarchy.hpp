@@ -0,0 +1,29 @@
+#ifndef TEST_MICROBENCHMARKS_HIERARCHY_HPP
+#define TEST_MICROBENCHMARKS_HIERARCHY_HPP
+
+#include "phlex/model/data_cell_index.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace phlex::benchmarks {
+  // Event-level indices for a job/run/subrun/event hierarchy with one run.  The events are
+  // spread across subruns so that each subrun holds (at most) 'events_per_subrun' events.
+  inline std::vector<data_cell_index_ptr> make_events(std::size_t const n_events,
+                                                      std::size_t const events_per_subrun = 100)
+  {
+    auto run = data_cell_index::base_ptr()->make_child(0, "run");
+    std::vector<data_cell_index_ptr> result;
+    result.reserve(n_events);
+    data_cell_index_ptr subrun;
+    for (std::size_t i = 0; i != n_events; ++i) {
+      if (i % events_per_subrun == 0) {
+        subrun = run->make_child(i / events_per_subrun, "subrun");
+      }
+      result.push_back(subrun->make_child(i, "event"));
+    }
+    return result;
+  }
+}
+
+#endif // TEST_MICROBENCHMARKS_HIERARCHY_HPP
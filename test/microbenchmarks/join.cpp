@@ -0,0 +1,51 @@
+#include "hierarchy.hpp"
+
+#include "phlex/core/message.hpp"
+#include "phlex/model/product_store.hpp"
+
+#include "benchmark/benchmark.h"
+#include "oneapi/tbb/flow_graph.h"
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+using namespace phlex::experimental;
+using namespace phlex::benchmarks;
+
+namespace {
+  // Every node with N input products is preceded by a tag-matching join (or, for N = 1, a
+  // pass-through node); the messages for each data cell arrive on all N ports.
+  template <std::size_t N>
+  void join_messages(benchmark::State& state)
+  {
+    auto const events = make_events(1'000);
+    std::vector<product_store_ptr> stores;
+    for (auto const& event : events) {
+      stores.push_back(std::make_shared<product_store>(event, "provider"));
+    }
+
+    tbb::flow::graph g;
+    auto join = make_join_or_none(g, std::make_index_sequence<N>{});
+    tbb::flow::function_node<messages_t<N>, tbb::flow::continue_msg, tbb::flow::lightweight> sink{
+      g, tbb::flow::unlimited, [](messages_t<N> const&) { return tbb::flow::continue_msg{}; }};
+    make_edge(join, sink);
+    auto const ports = input_ports<N>(join);
+
+    std::size_t msg_id{};
+    for (auto _ : state) {
+      for (auto const& store : stores) {
+        for (auto* port : ports) {
+          port->try_put({store, msg_id});
+        }
+        ++msg_id;
+      }
+      g.wait_for_all();
+    }
+    state.SetItemsProcessed(state.iterations() * stores.size());
+  }
+  BENCHMARK(join_messages<1>)->UseRealTime();
+  BENCHMARK(join_messages<2>)->UseRealTime();
+  BENCHMARK(join_messages<3>)->UseRealTime();
+}
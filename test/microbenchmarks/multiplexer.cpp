@@ -0,0 +1,58 @@
+#include "hierarchy.hpp"
+
+#include "phlex/core/message.hpp"
+#include "phlex/core/multiplexer.hpp"
+#include "phlex/core/product_query.hpp"
+#include "phlex/model/product_specification.hpp"
+#include "phlex/model/product_store.hpp"
+
+#include "benchmark/benchmark.h"
+#include "oneapi/tbb/flow_graph.h"
+
+#include <array>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <string>
+#include <utility>
+
+using namespace phlex;
+using namespace phlex::experimental;
+using namespace phlex::benchmarks;
+
+namespace {
+  using sink_t = tbb::flow::function_node<message, tbb::flow::continue_msg, tbb::flow::lightweight>;
+
+  // Each provider port receives the store for its own layer; ports for the parent layers
+  // require the multiplexer to create a new store for the parent data cell.
+  void multiplexer_multiplex(benchmark::State& state)
+  {
+    std::array<std::string, 3> const layers{"event", "subrun", "run"};
+    auto const n_ports = static_cast<std::size_t>(state.range(0));
+
+    tbb::flow::graph g;
+    std::deque<sink_t> sinks;
+    multiplexer::input_ports_t ports;
+    for (std::size_t i = 0; i != n_ports; ++i) {
+      auto& sink = sinks.emplace_back(
+        g, tbb::flow::unlimited, [](message const&) { return tbb::flow::continue_msg{}; });
+      auto const name = "p" + std::to_string(i);
+      product_query query{product_specification::create(name), layers[i % layers.size()]};
+      ports.try_emplace(name, multiplexer::named_input_port{std::move(query), &sink});
+    }
+
+    multiplexer mux{g};
+    mux.finalize(std::move(ports));
+
+    auto const events = make_events(1'000);
+    std::size_t i{};
+    for (auto _ : state) {
+      auto const& event = events[i % events.size()];
+      mux.multiplex({std::make_shared<product_store>(event, "driver"), i});
+      ++i;
+    }
+    g.wait_for_all();
+    state.SetItemsProcessed(state.iterations());
+  }
+  BENCHMARK(multiplexer_multiplex)->Arg(1)->Arg(4)->Arg(16);
+}
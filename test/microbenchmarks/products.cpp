@@ -0,0 +1,61 @@
+#include "hierarchy.hpp"
+
+#include "phlex/model/product_store.hpp"
+#include "phlex/model/products.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace phlex::experimental;
+using namespace phlex::benchmarks;
+
+namespace {
+  std::vector<std::string> product_names(std::size_t const n)
+  {
+    std::vector<std::string> result;
+    result.reserve(n);
+    for (std::size_t i = 0; i != n; ++i) {
+      result.push_back("product_" + std::to_string(i));
+    }
+    return result;
+  }
+
+  void products_get(benchmark::State& state)
+  {
+    auto const names = product_names(state.range(0));
+    products prods;
+    for (std::size_t i = 0; i != names.size(); ++i) {
+      prods.add(names[i], static_cast<int>(i));
+    }
+
+    std::size_t i{};
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(prods.get<int>(names[i++ % names.size()]));
+    }
+    state.SetItemsProcessed(state.iterations());
+  }
+  BENCHMARK(products_get)->Arg(1)->Arg(8)->Arg(64);
+
+  // Creation of a store the way providers and transforms produce them: one store per data
+  // cell, holding a small number of products.
+  void product_store_creation(benchmark::State& state)
+  {
+    auto const events = make_events(1'000);
+    auto const names = product_names(state.range(0));
+
+    std::size_t i{};
+    for (auto _ : state) {
+      auto store = std::make_shared<product_store>(events[i++ % events.size()], "provider");
+      for (auto const& name : names) {
+        store->add_product(name, 17.);
+      }
+      benchmark::DoNotOptimize(store.get());
+    }
+    state.SetItemsProcessed(state.iterations());
+  }
+  BENCHMARK(product_store_creation)->Arg(0)->Arg(1)->Arg(4);
+}
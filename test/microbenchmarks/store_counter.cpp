@@ -0,0 +1,73 @@
+#include "hierarchy.hpp"
+
+#include "phlex/core/store_counters.hpp"
+#include "phlex/model/data_cell_counter.hpp"
+#include "phlex/model/product_store.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <cstddef>
+#include <map>
+#include <memory>
+
+using namespace phlex;
+using namespace phlex::experimental;
+using namespace phlex::benchmarks;
+
+namespace {
+  // Flush store for the subrun that contains the provided events
+  product_store_ptr flush_store_for(data_cell_index_ptr const& event, std::size_t const n_events)
+  {
+    auto flush = product_store{event->parent(), "driver"}.make_flush();
+    flush->add_product("[flush]",
+                       std::make_shared<flush_counts const>(
+                         std::map<data_cell_index::hash_type, std::size_t>{
+                           {event->layer_hash(), n_events}}));
+    return flush;
+  }
+
+  // Folds check for completion after every child data cell they process.  Before the flush
+  // message arrives the check returns early; afterwards it must compare the child counts.
+  void store_counter_is_complete(benchmark::State& state)
+  {
+    auto const n_events = static_cast<std::size_t>(state.range(0));
+    auto const flushed = state.range(1) != 0;
+    auto const events = make_events(n_events, n_events);
+
+    store_counter counter;
+    if (flushed) {
+      counter.set_flush_value(flush_store_for(events.front(), n_events + 1), 0);
+    }
+    for (auto const& event : events) {
+      counter.increment(event->layer_hash());
+    }
+
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(counter.is_complete());
+    }
+    state.SetItemsProcessed(state.iterations());
+  }
+  BENCHMARK(store_counter_is_complete)->Args({100, 0})->Args({100, 1});
+
+  // Full lifecycle of the counter for one subrun: increment per event, checking completion
+  // each time, with the flush arriving before the last event.
+  void store_counter_lifecycle(benchmark::State& state)
+  {
+    auto const n_events = static_cast<std::size_t>(state.range(0));
+    auto const events = make_events(n_events, n_events);
+    auto const flush = flush_store_for(events.front(), n_events);
+
+    for (auto _ : state) {
+      store_counter counter;
+      for (std::size_t i = 0; i != n_events; ++i) {
+        if (i + 1 == n_events) {
+          counter.set_flush_value(flush, 0);
+        }
+        counter.increment(events[i]->layer_hash());
+        benchmark::DoNotOptimize(counter.is_complete());
+      }
+    }
+    state.SetItemsProcessed(state.iterations() * n_events);
+  }
+  BENCHMARK(store_counter_lifecycle)->Arg(10)->Arg(1'000);
+}
@@ -0,0 +1,105 @@
+// =======================================================================================
+/*
+   This test executes the fold graph of test/fold.cpp, but with the data cells supplied by
+   two drivers that run concurrently.  Each driver yields the job data cell and a disjoint
+   set of runs:
+
+     - driver 1: runs 0 and 1
+     - driver 2: runs 2 and 3
+
+   Each run contains five events.  The run-level folds must see only the events of their
+   own run, and the job-level folds must see the events of all runs, regardless of which
+   driver supplied them.
+*/
+// =======================================================================================
+
+#include "phlex/core/framework_graph.hpp"
+#include "phlex/model/data_cell_index.hpp"
+#include "plugins/layer_generator.hpp"
+
+#include "catch2/catch_test_macros.hpp"
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+using namespace phlex;
+
+namespace {
+  constexpr auto runs_per_driver = 2u;
+  constexpr auto events_per_run = 5u;
+
+  void add(std::atomic<unsigned int>& counter, unsigned int number) { counter += number; }
+
+  unsigned int provide_number(data_cell_index const& id) { return id.number(); }
+}
+
+TEST_CASE("Folds with multiple concurrent drivers", "[graph]")
+{
+  experimental::layer_generator gen1;
+  gen1.add_layer("run", {"job", runs_per_driver});
+  gen1.add_layer("event", {"run", events_per_run});
+
+  experimental::layer_generator gen2;
+  gen2.add_layer("run", {"job", runs_per_driver, runs_per_driver});
+  gen2.add_layer("event", {"run", events_per_run});
+
+  experimental::framework_graph g{
+    std::vector<experimental::detail::next_index_t>{driver_for_test(gen1), driver_for_test(gen2)}};
+
+  g.provide("provide_number", provide_number, concurrency::unlimited)
+    .output_product("number"_in("event"));
+
+  g.fold("run_add", add, concurrency::unlimited, "run")
+    .input_family("number"_in("event"))
+    .output_products("run_sum");
+  g.fold("job_add", add, concurrency::unlimited)
+    .input_family("number"_in("event"))
+    .output_products("job_sum");
+  g.fold("two_layer_job_add", add, concurrency::unlimited)
+    .input_family("run_sum"_in("run"))
+    .output_products("two_layer_job_sum");
+
+  constexpr auto total_runs = 2 * runs_per_driver;
+  g.observe("verify_run_sum", [](unsigned int actual) { CHECK(actual == 10u); })
+    .input_family("run_sum"_in("run"));
+  g.observe("verify_two_layer_job_sum",
+            [](unsigned int actual) { CHECK(actual == 10u * total_runs); })
+    .input_family("two_layer_job_sum"_in("job"));
+  g.observe("verify_job_sum", [](unsigned int actual) { CHECK(actual == 10u * total_runs); })
+    .input_family("job_sum"_in("job"));
+
+  g.execute();
+
+  CHECK(g.seen_cell_count("job") == 1);
+  CHECK(g.seen_cell_count("run") == total_runs);
+  CHECK(g.seen_cell_count("event") == total_runs * events_per_run);
+  CHECK(g.execution_count("run_add") == total_runs * events_per_run);
+  CHECK(g.execution_count("job_add") == total_runs * events_per_run);
+  CHECK(g.execution_count("two_layer_job_add") == total_runs);
+  CHECK(g.execution_count("verify_run_sum") == total_runs);
+  CHECK(g.execution_count("verify_two_layer_job_sum") == 1);
+  CHECK(g.execution_count("verify_job_sum") == 1);
+}
+
+TEST_CASE("A driver that yields no data cells", "[graph]")
+{
+  experimental::layer_generator gen;
+  gen.add_layer("event", {"job", events_per_run});
+
+  experimental::framework_graph g{std::vector<experimental::detail::next_index_t>{
+    driver_for_test(gen), [](framework_driver&) {}}};
+
+  g.provide("provide_number", provide_number, concurrency::unlimited)
+    .output_product("number"_in("event"));
+  g.fold("job_add", add, concurrency::unlimited)
+    .input_family("number"_in("event"))
+    .output_products("job_sum");
+  g.observe("verify_job_sum", [](unsigned int actual) { CHECK(actual == 10u); })
+    .input_family("job_sum"_in("job"));
+
+  g.execute();
+
+  CHECK(g.execution_count("job_add") == events_per_run);
+  CHECK(g.execution_count("verify_job_sum") == 1);
+}
@@ -7,13 +7,17 @@
 
 #include "phlex/core/framework_graph.hpp"
 #include "phlex/model/data_cell_index.hpp"
+#include "phlex/utilities/async_future.hpp"
 #include "plugins/layer_generator.hpp"
 
 #include "catch2/catch_test_macros.hpp"
 
+#include <mutex>
 #include <ranges>
 #include <set>
 #include <string>
+#include <thread>
+#include <vector>
 
 using namespace phlex;
 
@@ -32,6 +36,45 @@ namespace {
   private:
     std::set<std::string>* products_;
   };
+
+  // Records the products on a separate thread; the returned future is ready once they have
+  // been recorded.
+  class async_product_recorder {
+  public:
+    explicit async_product_recorder(std::set<std::string>& finished_products) :
+      finished_products_{&finished_products}
+    {
+    }
+
+    experimental::async_future<void> record(experimental::product_store_const_ptr const& store)
+    {
+      experimental::async_promise<void> recorded;
+      auto result = recorded.get_future();
+      std::lock_guard lock{mutex_};
+      threads_.emplace_back([this, store, recorded = std::move(recorded)]() mutable {
+        {
+          std::lock_guard lock{mutex_};
+          for (auto const& product_name : *store | std::views::keys) {
+            products_.insert(product_name);
+          }
+        }
+        recorded.set_value();
+      });
+      return result;
+    }
+
+    void finish()
+    {
+      std::lock_guard lock{mutex_};
+      *finished_products_ = products_;
+    }
+
+  private:
+    std::mutex mutex_;
+    std::set<std::string> products_;
+    std::set<std::string>* finished_products_;
+    std::vector<std::jthread> threads_; // Joined when the recorder is destroyed
+  };
 }
 
 TEST_CASE("Output data products", "[graph]")
@@ -65,3 +108,26 @@ TEST_CASE("Output data products", "[graph]")
   CHECK(g.execution_count("record_numbers") == 2u);
   CHECK(products_from_nodes == std::set<std::string>{"number_from_provider", "squared_number"});
 }
+
+TEST_CASE("Output data products asynchronously", "[graph]")
+{
+  experimental::layer_generator gen;
+  gen.add_layer("spill", {"job", 10u});
+
+  experimental::framework_graph g{driver_for_test(gen)};
+
+  g.provide("provide_number", [](data_cell_index const&) -> int { return 17; })
+    .output_product("number_from_provider"_in("spill"));
+
+  // The products recorded by the time the end-of-job function is called
+  std::set<std::string> finished_products;
+  g.make<async_product_recorder>(finished_products)
+    .output("record_numbers", &async_product_recorder::record, concurrency{2})
+    .experimental_at_end_of_job(&async_product_recorder::finish);
+
+  g.execute();
+
+  CHECK(g.execution_count("provide_number") == 10u);
+  CHECK(g.execution_count("record_numbers") == 10u);
+  CHECK(finished_products == std::set<std::string>{"number_from_provider"});
+}
@@ -0,0 +1,31 @@
+// =======================================================================================
+// C++ consumer of an array produced by a Python algorithm: the product is an array_view
+// of the NumPy array itself, including its strides, rather than a flattened copy.
+// =======================================================================================
+
+#include "phlex/model/array_view.hpp"
+#include "phlex/module.hpp"
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace phlex;
+using phlex::experimental::array_view;
+
+PHLEX_REGISTER_ALGORITHMS(m, config)
+{
+  m.observe("check_array_view",
+            [expected = config.get<std::vector<double>>("expected")](
+              array_view<double> const& grid) {
+              if (grid.is_contiguous()) {
+                throw std::runtime_error("array_view: expected a strided view");
+              }
+              if (grid.to_vector() != expected) {
+                throw std::runtime_error("array_view: unexpected elements");
+              }
+            })
+    .input_family(product_query{
+      experimental::product_specification::create(config.get<std::string>("input")), "event"});
+}
@@ -0,0 +1,95 @@
+"""A vectorized version of the three-input algorithm of `overhead.py`.
+
+Registered with a batch size, the algorithm is called with numpy arrays that
+hold the inputs of many events, and returns an array with the result of each
+event, which are then made into per-event products. The average time per event
+and the number of calls are printed after the last event, for comparison with
+the per-event calls of `overhead.py`.
+"""
+
+import time
+
+import numpy as np
+import numpy.typing as npt
+
+
+class BatchedOverhead:
+    """A callable class that adds three input arrays and times its calls.
+
+    Attributes:
+        __name__ (str): Identifier for Phlex.
+    """
+
+    __name__ = "batched_add"
+
+    def __init__(self, events: int):
+        """Create an adder that reports after `events` events.
+
+        Args:
+            events (int): Expected number of events, after which to report.
+        """
+        self._events = events
+        self._seen = 0
+        self._calls = 0
+        self._largest = 0
+        self._start = None
+
+    def __call__(
+        self, i: npt.NDArray[np.int32], j: npt.NDArray[np.int32], k: npt.NDArray[np.int32]
+    ) -> npt.NDArray[np.int32]:
+        """Add `i`, `j`, and `k` element-wise.
+
+        Batches are processed one at a time, so no lock is needed.
+
+        Args:
+            i (ndarray): First input, one element per event.
+            j (ndarray): Second input, one element per event.
+            k (ndarray): Third input, one element per event.
+
+        Returns:
+            ndarray: Sum of the three inputs, one element per event.
+        """
+        if self._start is None:
+            self._start = time.perf_counter()
+        self._seen += len(i)
+        self._calls += 1
+        self._largest = max(self._largest, len(i))
+        if self._seen == self._events:
+            elapsed = time.perf_counter() - self._start
+            print(
+                f"batched: {self._seen} events in {elapsed:.3f} s,"
+                f" {1e6 * elapsed / self._seen:.2f} us/event,"
+                f" {self._calls} calls (largest batch {self._largest})"
+            )
+        return i + j + k
+
+
+def check_sums(total: npt.NDArray[np.int32]) -> None:
+    """Verify a batch of sums.
+
+    Args:
+        total (ndarray): Sums of a batch of events.
+
+    Raises:
+        AssertionError: if any sum differs from 1.
+    """
+    assert (total == 1).all()
+
+
+def PHLEX_REGISTER_ALGORITHMS(m, config):
+    """Register a batched `BatchedOverhead` transform and a batched check of its results.
+
+    Args:
+        m (internal): Phlex registrar representation.
+        config (internal): Phlex configuration representation.
+
+    Returns:
+        None
+    """
+    m.transform(
+        BatchedOverhead(config["events"]),
+        input_family=config["input"],
+        output_products=config["output"],
+        batch=config["batch"],
+    )
+    m.observe(check_sums, input_family=config["output"], batch=config["batch"])
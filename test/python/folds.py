@@ -0,0 +1,161 @@
+"""Python providers and folds with vectorized accumulation.
+
+The providers make per-event products from the event number. The folds sum
+them per run and over the job: the framework buffers the values of each run
+and calls the fold with numpy arrays of many events at once, together with the
+value accumulated so far, and the fold returns the new value. Observers check
+the sums of each run and of the job.
+"""
+
+import math
+
+import numpy as np
+import numpy.typing as npt
+
+
+def provide_n(n: int) -> int:
+    """Provide the event number.
+
+    Args:
+        n (int): Number of the event.
+
+    Returns:
+        int: The event number.
+    """
+    return n
+
+
+def provide_x(n: int) -> float:
+    """Provide half of the event number.
+
+    Args:
+        n (int): Number of the event.
+
+    Returns:
+        float: Half of the event number.
+    """
+    return n / 2.0
+
+
+def sum_n(acc: int, n: npt.NDArray[np.int32]) -> int:
+    """Add a batch of event numbers to the sum of the run.
+
+    Args:
+        acc (int): Sum of the run so far.
+        n (ndarray): Event numbers of a batch of events.
+
+    Returns:
+        int: The updated sum.
+    """
+    return acc + int(n.sum())
+
+
+def sum_nx(acc: float, n: npt.NDArray[np.int32], x: npt.NDArray[np.float32]) -> float:
+    """Add the products of a batch of event numbers and their halves to the run sum.
+
+    Args:
+        acc (float): Sum of the run so far.
+        n (ndarray): Event numbers of a batch of events.
+        x (ndarray): Halves of the event numbers of the same events.
+
+    Returns:
+        float: The updated sum.
+    """
+    return acc + float(np.dot(n, x))
+
+
+def sum_runs(acc: int, run_sums: npt.NDArray[np.int32]) -> int:
+    """Add the sums of all runs of the job, received in a single call.
+
+    Args:
+        acc (int): Sum of the job so far.
+        run_sums (ndarray): Sums of the runs.
+
+    Returns:
+        int: The updated sum.
+    """
+    return acc + int(run_sums.sum())
+
+
+class Expect:
+    """A callable class that checks a fold result against an expected value.
+
+    Attributes:
+        __name__ (str): Identifier for Phlex.
+    """
+
+    def __init__(self, name: str, expected: float):
+        """Create a check named `name` for the `expected` value.
+
+        Args:
+            name (str): Name of the node.
+            expected (float): The expected value.
+        """
+        self.__name__ = name
+        self._expected = expected
+
+    def __call__(self, value: float) -> None:
+        """Verify the `value`.
+
+        Args:
+            value (float): The value to verify.
+
+        Raises:
+            AssertionError: if the value differs from the expected value.
+        """
+        assert math.isclose(value, self._expected), f"{value} != {self._expected}"
+
+
+def PHLEX_REGISTER_PROVIDERS(s, config):
+    """Register the providers of the event number and its half.
+
+    Args:
+        s (internal): Phlex source representation.
+        config (internal): Phlex configuration representation.
+
+    Returns:
+        None
+    """
+    s.provide(provide_n, output_products=["n"])
+    s.provide(provide_x, output_products=["x"])
+
+
+def PHLEX_REGISTER_ALGORITHMS(m, config):
+    """Register the folds per run and over the job, and checks of their results.
+
+    Args:
+        m (internal): Phlex registrar representation.
+        config (internal): Phlex configuration representation.
+
+    Returns:
+        None
+    """
+    events = config["events"]
+    runs = config["runs"]
+    batch = config["batch"]
+
+    m.fold(
+        sum_n,
+        input_family=["n"],
+        output_products=["run_sum"],
+        partition="run",
+        init=0,
+        batch=batch,
+    )
+    m.fold(
+        sum_nx,
+        input_family=["n", "x"],
+        output_products=["run_sum_nx"],
+        partition="run",
+        init=0.0,
+        batch=batch,
+    )
+    m.fold(
+        sum_runs, input_family=["run_sum"], output_products=["job_sum"], layer="run", init=0
+    )
+
+    run_sum = events * (events + 1) // 2
+    run_sum_nx = events * (events + 1) * (2 * events + 1) / 12
+    m.observe(Expect("check_run_sum", run_sum), input_family=["run_sum"], layer="run")
+    m.observe(Expect("check_run_sum_nx", run_sum_nx), input_family=["run_sum_nx"], layer="run")
+    m.observe(Expect("check_job_sum", runs * run_sum), input_family=["job_sum"], layer="job")
@@ -0,0 +1,71 @@
+"""A trivial three-input algorithm to measure the per-event cost of Python nodes.
+
+The work done by the algorithm is negligible, so that the time between its
+first and last call is dominated by the framework: scheduling the node,
+converting the three inputs and the result, and crossing into Python. The
+average time per event is printed after the last event.
+"""
+
+import threading
+import time
+
+
+class Overhead:
+    """A callable class that adds three inputs and times its calls.
+
+    Attributes:
+        __name__ (str): Identifier for Phlex.
+    """
+
+    __name__ = "overhead_add"
+
+    def __init__(self, events: int):
+        """Create an adder that reports after `events` calls.
+
+        Args:
+            events (int): Expected number of calls, after which to report.
+        """
+        self._events = events
+        self._lock = threading.Lock()
+        self._calls = 0
+        self._start = None
+
+    def __call__(self, i: int, j: int, k: int) -> int:
+        """Add `i`, `j`, and `k`.
+
+        Args:
+            i (int): First input.
+            j (int): Second input.
+            k (int): Third input.
+
+        Returns:
+            int: Sum of the three inputs.
+        """
+        with self._lock:
+            if self._start is None:
+                self._start = time.perf_counter()
+            self._calls += 1
+            if self._calls == self._events:
+                elapsed = time.perf_counter() - self._start
+                print(
+                    f"overhead: {self._calls} events in {elapsed:.3f} s,"
+                    f" {1e6 * elapsed / self._calls:.2f} us/event"
+                )
+        return i + j + k
+
+
+def PHLEX_REGISTER_ALGORITHMS(m, config):
+    """Register an `Overhead` instance as a transformation.
+
+    Args:
+        m (internal): Phlex registrar representation.
+        config (internal): Phlex configuration representation.
+
+    Returns:
+        None
+    """
+    m.transform(
+        Overhead(config["events"]),
+        input_family=config["input"],
+        output_products=config["output"],
+    )
@@ -0,0 +1,48 @@
+// =======================================================================================
+// C++ side of the record exchange with Python: creates a std::vector of track records for
+// each event, which Python receives as a numpy structured array, and checks the records
+// that Python returns, which arrive as a record_array.
+// =======================================================================================
+
+#include "phlex/model/record_array.hpp"
+#include "phlex/model/record_layout.hpp"
+#include "phlex/module.hpp"
+
+#include <stdexcept>
+#include <vector>
+
+using namespace phlex;
+using phlex::experimental::record_array;
+
+struct track {
+  double px;
+  double py;
+  int charge;
+};
+
+PHLEX_REGISTER_ALGORITHMS(m)
+{
+  // Registered before the Python modules that use it are loaded
+  experimental::register_record<track>("track");
+
+  m.transform(
+     "make_tracks",
+     [](int i, int j) {
+       return std::vector<track>{{1., 2., 1}, {3., 4., -1}, {double(i), double(j), 0}};
+     },
+     concurrency::unlimited)
+    .input_family("i"_in("event"), "j"_in("event"))
+    .output_products("tracks");
+
+  m.observe(
+     "check_flipped_tracks",
+     [](record_array const& records) {
+       auto const tracks = records.as<track>();
+       if (tracks.size() != 3 || tracks[0].charge != -1 || tracks[1].charge != 1 ||
+           tracks[2].charge != 0 || tracks[1].px != 3. || tracks[1].py != 4.) {
+         throw std::runtime_error("records: unexpected tracks returned from Python");
+       }
+     },
+     concurrency::unlimited)
+    .input_family("flipped_tracks"_in("event"));
+}
@@ -0,0 +1,50 @@
+"""Algorithms exchanging C++ records as numpy structured arrays.
+
+The C++ module `records4py` registers a `track` record (a struct of
+arithmetic fields) and creates a list of tracks per event, which arrives here
+as a read-only structured array with the fields of the struct. A structured
+array returned for a record annotation is handed back to C++ as is.
+"""
+
+
+def total_momentum(tracks: list["track"]) -> int:  # noqa: F821
+    """Sum the momentum components of all tracks.
+
+    Args:
+        tracks (ndarray): Structured array with fields ``px``, ``py``, and
+            ``charge``.
+
+    Returns:
+        int: Sum of ``px`` and ``py`` over all tracks.
+    """
+    assert tracks.dtype.names == ("px", "py", "charge")
+    assert not tracks.flags.writeable
+    return int(tracks["px"].sum() + tracks["py"].sum())
+
+
+def flip_charges(tracks: list["track"]) -> list["track"]:  # noqa: F821
+    """Return the tracks with their charges flipped.
+
+    Args:
+        tracks (ndarray): Structured array of tracks.
+
+    Returns:
+        ndarray: A new structured array with the same dtype.
+    """
+    flipped = tracks.copy()
+    flipped["charge"] *= -1
+    return flipped
+
+
+def PHLEX_REGISTER_ALGORITHMS(m, config):
+    """Register the consumers and the producer of track records.
+
+    Args:
+        m (internal): Phlex registrar representation.
+        config (internal): Phlex configuration representation.
+
+    Returns:
+        None
+    """
+    m.transform(total_momentum, input_family=config["input"], output_products=config["output"])
+    m.transform(flip_charges, input_family=config["input"], output_products=["flipped_tracks"])
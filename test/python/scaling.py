@@ -0,0 +1,89 @@
+"""A CPU-bound algorithm to check the scaling of concurrent Python calls.
+
+The algorithm adds its inputs, like adder.py, after spinning for a fixed
+number of iterations, so that each call takes long enough to overlap with
+others. With a free-threaded build of Python, concurrent calls run in
+parallel; with the GIL enabled, they take turns. The peak number of calls
+in flight and the elapsed time are printed after the last event, which
+allows comparing runs with different concurrency settings.
+"""
+
+import sys
+import threading
+import time
+
+
+class ScalingAdder:
+    """A callable class that adds its inputs after a fixed amount of work.
+
+    Attributes:
+        __name__ (str): Identifier for Phlex.
+    """
+
+    __name__ = "scaling_add"
+
+    def __init__(self, iterations: int, events: int):
+        """Create an adder that spins for `iterations` per call.
+
+        Args:
+            iterations (int): Number of loop iterations per call.
+            events (int): Expected number of calls, after which to report.
+        """
+        self._iterations = iterations
+        self._events = events
+        self._lock = threading.Lock()
+        self._in_flight = 0
+        self._peak = 0
+        self._calls = 0
+        self._start = None
+
+    def __call__(self, i: int, j: int) -> int:
+        """Add `i` and `j` after spinning.
+
+        Args:
+            i (int): First input.
+            j (int): Second input.
+
+        Returns:
+            int: Sum of the two inputs.
+        """
+        with self._lock:
+            if self._start is None:
+                self._start = time.perf_counter()
+            self._in_flight += 1
+            self._peak = max(self._peak, self._in_flight)
+
+        total = 0
+        for k in range(self._iterations):
+            total += k & 1
+
+        with self._lock:
+            self._in_flight -= 1
+            self._calls += 1
+            if self._calls == self._events:
+                gil = getattr(sys, "_is_gil_enabled", lambda: True)()
+                print(
+                    f"scaling: {self._calls} calls in {time.perf_counter() - self._start:.3f} s,"
+                    f" peak concurrency {self._peak} (GIL {'enabled' if gil else 'disabled'})"
+                )
+
+        return i + j + total - (self._iterations // 2)
+
+
+def PHLEX_REGISTER_ALGORITHMS(m, config):
+    """Register a `ScalingAdder` with the configured concurrency.
+
+    Args:
+        m (internal): Phlex registrar representation.
+        config (internal): Phlex configuration representation.
+
+    Returns:
+        None
+    """
+    adder = ScalingAdder(config["iterations"], config["events"])
+    m.transform(
+        adder,
+        input_family=config["input"],
+        output_products=config["output"],
+        concurrency=config["concurrency"],
+    )
@@ -0,0 +1,58 @@
+"""Algorithms exchanging strided numpy arrays without copying them.
+
+The array returned for an ndarray annotation becomes the product itself, so
+that a transposed or sliced view arrives at its consumers, in Python and in
+C++, with its original strides rather than as a flattened copy.
+"""
+
+import numpy as np
+import numpy.typing as npt
+
+
+def make_grid(i: int, j: int) -> npt.NDArray[np.float64]:
+    """Return a strided view of a grid of values.
+
+    Args:
+        i (int): First input.
+        j (int): Second input; the values of the grid start at ``i + j``.
+
+    Returns:
+        ndarray: Every other column of the grid, as a (2, 3) array that is
+        not contiguous in memory.
+
+    Examples:
+        >>> make_grid(0, 1)
+        array([[ 1.,  5.,  9.],
+               [ 3.,  7., 11.]])
+    """
+    grid = np.arange(12, dtype=np.float64).reshape(3, 4) + (i + j)
+    return grid.T[::2]
+
+
+def sum_grid(grid: npt.NDArray[np.float64]) -> int:
+    """Check the layout of the received grid and sum its elements.
+
+    Args:
+        grid (ndarray): The strided view returned by `make_grid`.
+
+    Returns:
+        int: Sum total of the elements.
+    """
+    assert grid.shape == (2, 3)
+    assert not grid.flags.c_contiguous
+    assert not grid.flags.writeable
+    return int(grid.sum())
+
+
+def PHLEX_REGISTER_ALGORITHMS(m, config):
+    """Register the producer and the Python consumer of a strided array.
+
+    Args:
+        m (internal): Phlex registrar representation.
+        config (internal): Phlex configuration representation.
+
+    Returns:
+        None
+    """
+    m.transform(make_grid, input_family=config["input"], output_products=["grid"])
+    m.transform(sum_grid, input_family=["grid"], output_products=config["output"])
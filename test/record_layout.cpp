@@ -0,0 +1,74 @@
+#include "phlex/model/record_array.hpp"
+#include "phlex/model/record_layout.hpp"
+
+#include "catch2/catch_test_macros.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+using namespace phlex::experimental;
+
+namespace {
+  struct hit {
+    float x;
+    double energy;
+    unsigned int channel;
+    bool saturated;
+  };
+
+  struct other_hit {
+    float x;
+  };
+}
+
+TEST_CASE("Record layouts are reflected from the struct", "[data model]")
+{
+  auto const layout = make_record_layout<hit>("hit");
+  CHECK(layout.name == "hit");
+  CHECK(layout.size == sizeof(hit));
+  CHECK(*layout.vector_type == typeid(std::vector<hit>));
+  CHECK(layout.vector_type_id == make_type_id<std::vector<hit>>());
+
+  REQUIRE(layout.fields.size() == 4);
+  CHECK(layout.fields[0].name == "x");
+  CHECK(layout.fields[0].kind == 'f');
+  CHECK(layout.fields[0].size == sizeof(float));
+  CHECK(layout.fields[1].name == "energy");
+  CHECK(layout.fields[1].offset == offsetof(hit, energy));
+  CHECK(layout.fields[2].kind == 'u');
+  CHECK(layout.fields[2].offset == offsetof(hit, channel));
+  CHECK(layout.fields[3].kind == 'b');
+
+  std::vector<hit> const hits(3);
+  auto const elements = layout.elements(&hits);
+  CHECK(elements.data() == reinterpret_cast<std::byte const*>(hits.data()));
+  CHECK(elements.size() == 3 * sizeof(hit));
+}
+
+TEST_CASE("Record layouts are registered by name and type", "[data model]")
+{
+  register_record<hit>("registered_hit");
+  register_record<hit>("registered_hit"); // Registering again is allowed
+  CHECK_THROWS_AS(register_record<other_hit>("registered_hit"), std::runtime_error);
+
+  auto const* by_name = find_record_layout("registered_hit");
+  REQUIRE(by_name != nullptr);
+  CHECK(find_record_layout(typeid(hit)) == by_name);
+  CHECK(find_record_layout(typeid(std::vector<hit>)) == by_name);
+  CHECK(find_record_layout("unregistered") == nullptr);
+}
+
+TEST_CASE("Record arrays check the type of their records", "[data model]")
+{
+  register_record<hit>("registered_hit");
+  auto hits = std::make_shared<std::vector<hit>>(2);
+  (*hits)[1].channel = 7;
+  record_array const records{
+    *find_record_layout("registered_hit"), hits->data(), hits->size(), hits};
+  CHECK(records.as<hit>().size() == 2);
+  CHECK(records.as<hit>()[1].channel == 7);
+  CHECK(records.to_vector<hit>().size() == 2);
+  CHECK_THROWS_AS(records.as<other_hit>(), std::runtime_error);
+}
@@ -0,0 +1,13 @@
+#include "phlex/model/data_cell_index.hpp"
+#include "phlex/source.hpp"
+
+using namespace phlex;
+
+PHLEX_REGISTER_PROVIDERS(s)
+{
+  s.provide("provide_number",
+            [](data_cell_index const& id) -> unsigned int {
+              return 100 * id.parent("run")->number() + id.number();
+            })
+    .output_product("number"_in("event"));
+}
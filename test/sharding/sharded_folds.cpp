@@ -0,0 +1,86 @@
+// =======================================================================================
+// This test runs the same fold over 7 runs with 5 events each, once as a single shard and
+// once split across four shards.  The sum of the per-shard job-level fold results must be
+// identical to the single-shard result, and each run must be processed by exactly one
+// shard.
+// =======================================================================================
+
+#include "phlex/core/framework_graph.hpp"
+#include "phlex/model/data_cell_index.hpp"
+#include "plugins/layer_generator.hpp"
+
+#include "catch2/catch_test_macros.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+
+using namespace phlex;
+
+namespace {
+  constexpr auto n_runs = 7u;
+  constexpr auto events_per_run = 5u;
+
+  void add(std::atomic<unsigned int>& sum, unsigned int number) { sum += number; }
+
+  unsigned int provide_number(data_cell_index const& id)
+  {
+    return 100 * id.parent("run")->number() + id.number();
+  }
+
+  struct shard_result {
+    unsigned int sum;
+    std::size_t runs;
+  };
+
+  shard_result run_shard(experimental::shard_spec const shard)
+  {
+    experimental::layer_generator gen;
+    gen.add_layer("run", {"job", n_runs});
+    gen.add_layer("event", {"run", events_per_run});
+
+    experimental::framework_graph g{driver_for_test(gen)};
+    g.restrict_to_shard(shard);
+
+    g.provide("provide_number", provide_number, concurrency::unlimited)
+      .output_product("number"_in("event"));
+    g.fold("sum", add, concurrency::unlimited)
+      .input_family("number"_in("event"))
+      .output_products("sum");
+
+    unsigned int result{};
+    g.observe("record_sum", [&result](unsigned int sum) { result = sum; })
+      .input_family("sum"_in("job"));
+
+    g.execute();
+    return {result, g.seen_cell_count("run", true)};
+  }
+}
+
+TEST_CASE("One shard and four shards give identical fold results", "[graph]")
+{
+  auto const [single_sum, single_runs] = run_shard({.index = 0, .count = 1});
+  CHECK(single_runs == n_runs);
+
+  unsigned int merged_sum{};
+  std::size_t merged_runs{};
+  for (std::size_t i = 0; i != 4; ++i) {
+    auto const [sum, runs] = run_shard({.index = i, .count = 4});
+    // Runs are assigned round-robin: shards 0, 1, and 2 each get two runs, shard 3 gets one.
+    CHECK(runs == (i < 3 ? 2u : 1u));
+    merged_sum += sum;
+    merged_runs += runs;
+  }
+
+  CHECK(merged_runs == n_runs);
+  CHECK(merged_sum == single_sum);
+  CHECK(single_sum == 10570u);
+}
+
+TEST_CASE("Invalid shard specifications", "[graph]")
+{
+  experimental::layer_generator gen;
+  experimental::framework_graph g{driver_for_test(gen)};
+  CHECK_THROWS_AS(g.restrict_to_shard({.index = 0, .count = 0}), std::runtime_error);
+  CHECK_THROWS_AS(g.restrict_to_shard({.index = 4, .count = 4}), std::runtime_error);
+}
@@ -0,0 +1,17 @@
+#include "phlex/module.hpp"
+
+#include <atomic>
+#include <string>
+
+using namespace phlex;
+
+namespace {
+  void add(std::atomic<unsigned int>& sum, unsigned int number) { sum += number; }
+}
+
+PHLEX_REGISTER_ALGORITHMS(m, config)
+{
+  m.fold("sum", add, concurrency::unlimited)
+    .input_family(config.get<product_query>("consumes"))
+    .output_products(config.get<std::string>("output"));
+}
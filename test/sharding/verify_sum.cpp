@@ -0,0 +1,18 @@
+#include "phlex/module.hpp"
+
+#include <stdexcept>
+#include <string>
+
+using namespace phlex;
+
+PHLEX_REGISTER_ALGORITHMS(m, config)
+{
+  m.observe("verify",
+            [expected = config.get<unsigned int>("expected")](unsigned int actual) {
+              if (actual != expected) {
+                throw std::runtime_error("Expected sum of " + std::to_string(expected) +
+                                         ", but got " + std::to_string(actual));
+              }
+            })
+    .input_family(config.get<product_query>("consumes"));
+}
@@ -0,0 +1,39 @@
+#ifndef TEST_SYNTHETIC_WORKFLOW_PAYLOAD_HPP
+#define TEST_SYNTHETIC_WORKFLOW_PAYLOAD_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace phlex::experimental::test {
+  // Every product of the synthetic workflow is a payload of doubles whose first element
+  // carries the number of the data cell the payload was ultimately derived from.  The
+  // remaining elements only occupy memory, so that products of realistic sizes flow
+  // through the graph.
+  using payload = std::vector<double>;
+
+  inline std::size_t elements_for(std::size_t const bytes)
+  {
+    return std::max<std::size_t>(1, bytes / sizeof(double));
+  }
+
+  inline payload make_payload(std::size_t const n_elements, double const tag)
+  {
+    payload result(n_elements);
+    result[0] = tag;
+    return result;
+  }
+
+  // Well-mixed hash of a payload tag (SplitMix64 finalizer), used for pseudo-random but
+  // reproducible predicate decisions.
+  inline std::uint64_t mix(double const tag, std::uint64_t const salt)
+  {
+    auto z = static_cast<std::uint64_t>(tag) + salt + 0x9e3779b97f4a7c15ull;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+  }
+}
+
+#endif // TEST_SYNTHETIC_WORKFLOW_PAYLOAD_HPP
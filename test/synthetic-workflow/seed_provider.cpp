@@ -0,0 +1,22 @@
+#include "phlex/source.hpp"
+#include "test/synthetic-workflow/payload.hpp"
+
+#include <cstddef>
+#include <string>
+
+using namespace phlex::experimental::test;
+
+// Provides the 'seed' payload, from which all products of the synthetic workflow derive.
+PHLEX_REGISTER_PROVIDERS(s, config)
+{
+  using namespace phlex;
+  auto const layer = config.get<std::string>("layer", "event");
+  auto const n_elements = elements_for(config.get<std::size_t>("product_size", 64));
+  s.provide(
+     "provide_seed",
+     [n_elements](data_cell_index const& id) {
+       return make_payload(n_elements, static_cast<double>(id.number()));
+     },
+     concurrency::unlimited)
+    .output_product("seed"_in(layer));
+}
@@ -0,0 +1,456 @@
+// ==============================================================================================
+// The synthetic_workflow plugin builds a directed acyclic graph of algorithms from a small set
+// of structural parameters, so that graphs of production-like shape and size (hundreds of
+// nodes) can be used to measure the overhead of the framework.  Each algorithm spins for a
+// configured time using timed_busy (see test/mock-workflow/timed_busy.hpp) and produces a
+// payload of configured size (see payload.hpp).
+//
+// The graph is built level by level.  Each level has 'width' nodes (or 'widths[i]' nodes if
+// a list of widths is given), and each node consumes products made by nodes of earlier
+// levels.  The products of level 0 are the 'seed' products, provided by the seed provider
+// (seed_provider.cpp) that is part of the same plugin.  Each node is one of the following:
+//
+//   - transform: consumes 'fan_in' products and creates one new product,
+//   - predicate: consumes one product; it guards an observer of that same product, which
+//                runs only for the accepted fraction ('accept_fraction') of data cells,
+//   - fold:      consumes one product and accumulates it over the 'fold_partition' layer,
+//   - unfold:    consumes one product and splits it into 'unfold_children' data cells,
+//                whose per-child results are folded back into one product per data cell.
+//
+// Only transforms create products that later levels consume; the results of folds are
+// not consumed by other nodes.  The fan-out of each product thus follows from the widths,
+// the fan-in, and the fraction of transforms.  With the 'random'
+// topology, the inputs of a node are drawn from all products of earlier levels; with the
+// 'layered' topology, a node at position i consumes the products at positions
+// i, i+1, ... (modulo the width) of the previous level.
+//
+// A configuration with all parameters and their default values:
+//
+//   sources: {
+//     seed: { cpp: 'synthetic_workflow', layer: 'event', product_size: 64 },
+//   },
+//   modules: {
+//     synthetic: {
+//       cpp: 'synthetic_workflow',
+//       layer: 'event',                 // data layer of the seed products
+//       random_seed: 1,
+//       topology: 'random',             // or 'layered'
+//       levels: 10,
+//       width: 10,                      // or, e.g., widths: [4, 16, 16, 8]
+//       fan_in: { min: 1, max: 3 },
+//       cost_usec: { distribution: 'fixed', mean: 100 },
+//       product_size: { min: 64, max: 64 },   // in bytes
+//       fractions: { predicate: 0, fold: 0, unfold: 0 },
+//       accept_fraction: 0.5,
+//       fold_partition: 'job',
+//       unfold_children: 4,
+//       concurrency: 0,                 // 0 means unlimited
+//     },
+//   },
+//
+// The per-node cost is drawn once per node from the 'cost_usec' distribution, which may be
+// 'fixed' (mean), 'uniform' (min, max), 'exponential' (mean), or 'lognormal' (mean, sigma,
+// where sigma is the standard deviation of the underlying normal distribution).
+//
+// After the graph is built, the total work and the critical-path time per data cell are
+// reported; together with the number of data cells and threads, these give the ideal
+// processing time against which the measured time can be compared.
+// ==============================================================================================
+
+#include "phlex/module.hpp"
+#include "test/mock-workflow/timed_busy.hpp"
+#include "test/synthetic-workflow/payload.hpp"
+
+#include "fmt/format.h"
+#include "spdlog/spdlog.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace phlex;
+using namespace phlex::experimental;
+using namespace phlex::experimental::test;
+
+namespace {
+  using std::chrono::microseconds;
+  constexpr std::size_t max_fan_in{4};
+
+  class cost_distribution {
+  public:
+    explicit cost_distribution(configuration const& config) :
+      kind_{config.get<std::string>("distribution", "fixed")},
+      mean_{config.get<double>("mean", 100.)},
+      sigma_{config.get<double>("sigma", 1.)},
+      min_{config.get<double>("min", 0.)},
+      max_{config.get<double>("max", 2 * mean_)}
+    {
+      if (kind_ != "fixed" and kind_ != "uniform" and kind_ != "exponential" and
+          kind_ != "lognormal") {
+        throw std::runtime_error("Unknown cost distribution '" + kind_ + "'");
+      }
+    }
+
+    double operator()(std::mt19937_64& rng) const
+    {
+      if (kind_ == "uniform") {
+        return std::uniform_real_distribution{min_, max_}(rng);
+      }
+      if (kind_ == "exponential") {
+        return std::exponential_distribution{1. / mean_}(rng);
+      }
+      if (kind_ == "lognormal") {
+        // Choose the location so that the mean of the distribution is 'mean_'
+        auto const mu = std::log(mean_) - sigma_ * sigma_ / 2;
+        return std::lognormal_distribution{mu, sigma_}(rng);
+      }
+      return mean_;
+    }
+
+  private:
+    std::string kind_;
+    double mean_;
+    double sigma_;
+    double min_;
+    double max_;
+  };
+
+  // A product that nodes of later levels can consume, along with the length (in
+  // microseconds) of the longest chain of work needed to create it.
+  struct available_product {
+    std::string name;
+    double critical_path;
+  };
+
+  // State of an unfold: the payload to be split
+  class splitter {
+  public:
+    explicit splitter(payload const& p) : tag_{p[0]}, size_{p.size()} {}
+    std::size_t initial_value() const { return 0; }
+    double tag() const { return tag_; }
+    std::size_t size() const { return size_; }
+
+  private:
+    double tag_;
+    std::size_t size_;
+  };
+
+  // Fold result that merges the per-child results of an unfold back into one payload
+  struct merged_payload {
+    std::mutex mutex;
+    payload value;
+  };
+
+  // Makes the merged payload sendable as a data product (see phlex/core/fold/send.hpp)
+  payload send(merged_payload const& merged) { return merged.value; }
+
+  class workflow_builder {
+  public:
+    workflow_builder(module_graph_proxy<void_tag>& m, configuration const& config) :
+      m_{m},
+      label_{config.get<std::string>("module_label")},
+      layer_{config.get<std::string>("layer", "event")},
+      rng_{config.get<std::uint64_t>("random_seed", 1)},
+      layered_{config.get<std::string>("topology", "random") == "layered"},
+      cost_{config.get<configuration>("cost_usec", {})},
+      accept_fraction_{config.get<double>("accept_fraction", 0.5)},
+      fold_partition_{config.get<std::string>("fold_partition", "job")},
+      unfold_children_{std::max<std::size_t>(1, config.get<std::size_t>("unfold_children", 4))},
+      concurrency_{config.get<unsigned>("concurrency", concurrency::unlimited.value)}
+    {
+      auto const fan_in = config.get<configuration>("fan_in", {});
+      fan_in_min_ = std::clamp<std::size_t>(fan_in.get<std::size_t>("min", 1), 1, max_fan_in);
+      fan_in_max_ =
+        std::clamp<std::size_t>(fan_in.get<std::size_t>("max", 3), fan_in_min_, max_fan_in);
+
+      auto const sizes = config.get<configuration>("product_size", {});
+      size_min_ = sizes.get<std::size_t>("min", 64);
+      size_max_ = std::max(size_min_, sizes.get<std::size_t>("max", std::size_t{size_min_}));
+
+      auto const fractions = config.get<configuration>("fractions", {});
+      predicate_fraction_ = fractions.get<double>("predicate", 0.);
+      fold_fraction_ = fractions.get<double>("fold", 0.);
+      unfold_fraction_ = fractions.get<double>("unfold", 0.);
+      if (predicate_fraction_ + fold_fraction_ + unfold_fraction_ > 1.) {
+        throw std::runtime_error("The fractions of predicates, folds, and unfolds exceed 1.");
+      }
+
+      if (auto widths = config.get_if_present<std::vector<std::size_t>>("widths")) {
+        widths_ = std::move(*widths);
+      } else {
+        widths_.assign(config.get<std::size_t>("levels", 10),
+                       config.get<std::size_t>("width", 10));
+      }
+    }
+
+    void build()
+    {
+      std::vector<std::vector<available_product>> levels{{{"seed", 0.}}};
+      for (std::size_t level = 1; level <= widths_.size(); ++level) {
+        std::vector<available_product> created;
+        auto const width = widths_[level - 1];
+        for (std::size_t position = 0; position != width; ++position) {
+          auto const inputs = choose_inputs(levels, position, width);
+          auto const name = fmt::format("{}_{}", level, position);
+          auto const kind = std::uniform_real_distribution{}(rng_);
+          if (kind < predicate_fraction_) {
+            add_predicate(name, inputs.front());
+          } else if (kind < predicate_fraction_ + fold_fraction_) {
+            add_fold(name, inputs.front());
+          } else if (kind < predicate_fraction_ + fold_fraction_ + unfold_fraction_) {
+            add_unfold(name, inputs.front());
+          } else {
+            created.push_back(add_transform(name, inputs));
+          }
+        }
+        levels.push_back(std::move(created));
+      }
+
+      spdlog::info("Synthetic workflow '{}': {} nodes ({} transforms, {} predicates with "
+                   "guarded observers, {} folds, {} unfolds)",
+                   label_,
+                   n_transforms_ + 2 * n_predicates_ + n_folds_ + 2 * n_unfolds_,
+                   n_transforms_,
+                   n_predicates_,
+                   n_folds_,
+                   n_unfolds_);
+      spdlog::info("Synthetic workflow '{}': work per {} data cell: {:.1f} us; critical path: "
+                   "{:.1f} us",
+                   label_,
+                   layer_,
+                   total_work_,
+                   critical_path_);
+    }
+
+  private:
+    std::vector<available_product> choose_inputs(
+      std::vector<std::vector<available_product>> const& levels,
+      std::size_t const position,
+      std::size_t const width)
+    {
+      // Fall back to the products of all earlier levels if the previous level made none.
+      std::vector<available_product> candidates;
+      if (layered_ and not levels.back().empty()) {
+        candidates = levels.back();
+      } else {
+        for (auto const& level : levels) {
+          candidates.insert(candidates.end(), level.begin(), level.end());
+        }
+      }
+
+      auto const fan_in = std::min(
+        std::uniform_int_distribution{fan_in_min_, fan_in_max_}(rng_), candidates.size());
+      std::vector<available_product> result;
+      if (layered_) {
+        // Spread the consumers evenly over the products of the previous level
+        auto const first = position * candidates.size() / width;
+        for (std::size_t i = 0; i != fan_in; ++i) {
+          result.push_back(candidates[(first + i) % candidates.size()]);
+        }
+      } else {
+        std::ranges::sample(candidates, std::back_inserter(result), fan_in, rng_);
+      }
+      return result;
+    }
+
+    microseconds draw_cost()
+    {
+      return microseconds{static_cast<microseconds::rep>(std::max(0., cost_(rng_)))};
+    }
+
+    std::size_t draw_size()
+    {
+      return elements_for(std::uniform_int_distribution{size_min_, size_max_}(rng_));
+    }
+
+    product_query query(std::string const& name) const
+    {
+      return product_query{product_specification::create(name), layer_};
+    }
+
+    static double longest(std::vector<available_product> const& inputs)
+    {
+      return std::ranges::max(inputs, {}, &available_product::critical_path).critical_path;
+    }
+
+    template <std::size_t... Is>
+    static auto transform_body(microseconds const cost,
+                               std::size_t const n_elements,
+                               std::index_sequence<Is...>)
+    {
+      return [cost, n_elements](type_t<payload const&, Is>... inputs) {
+        timed_busy(cost);
+        // Every input derives from the same data cell, so any tag will do
+        return make_payload(n_elements, std::ranges::max({inputs[0]...}));
+      };
+    }
+
+    template <std::size_t N>
+    void register_transform(std::string const& name,
+                            microseconds const cost,
+                            std::vector<available_product> const& inputs)
+    {
+      auto queries = [this, &inputs]<std::size_t... Is>(std::index_sequence<Is...>) {
+        return std::array{query(inputs[Is].name)...};
+      }(std::make_index_sequence<N>{});
+      m_.transform("transform_" + name,
+                   transform_body(cost, draw_size(), std::make_index_sequence<N>{}),
+                   concurrency_)
+        .input_family(std::move(queries))
+        .output_products("p" + name);
+    }
+
+    available_product add_transform(std::string const& name,
+                                    std::vector<available_product> const& inputs)
+    {
+      auto const cost = draw_cost();
+      switch (inputs.size()) {
+      case 1:
+        register_transform<1>(name, cost, inputs);
+        break;
+      case 2:
+        register_transform<2>(name, cost, inputs);
+        break;
+      case 3:
+        register_transform<3>(name, cost, inputs);
+        break;
+      default:
+        static_assert(max_fan_in == 4);
+        register_transform<4>(name, cost, inputs);
+      }
+      ++n_transforms_;
+      return record("p" + name, cost.count(), longest(inputs), cost.count());
+    }
+
+    void add_predicate(std::string const& name, available_product const& input)
+    {
+      auto const cost = draw_cost();
+      auto const threshold = static_cast<std::uint64_t>(
+        std::clamp(accept_fraction_, 0., 1.) * static_cast<double>(std::uint64_t{1} << 53));
+      auto const salt = rng_();
+      m_.predicate("predicate_" + name,
+                   [cost, threshold, salt](payload const& p) {
+                     timed_busy(cost);
+                     return (mix(p[0], salt) >> 11) < threshold;
+                   },
+                   concurrency_)
+        .input_family(query(input.name));
+
+      auto const guarded_cost = draw_cost();
+      m_.observe("guarded_" + name,
+                 [guarded_cost](payload const&) { timed_busy(guarded_cost); },
+                 concurrency_)
+        .input_family(query(input.name))
+        .experimental_when(label_ + ":predicate_" + name);
+
+      ++n_predicates_;
+      auto const predicate_path = input.critical_path + cost.count();
+      record({}, cost.count(), input.critical_path, cost.count());
+      record({}, guarded_cost.count(), predicate_path, accept_fraction_ * guarded_cost.count());
+    }
+
+    void add_fold(std::string const& name, available_product const& input)
+    {
+      auto const cost = draw_cost();
+      m_.fold(
+          "fold_" + name,
+          [cost](std::atomic<double>& sum, payload const& p) {
+            timed_busy(cost);
+            sum += p[0];
+          },
+          concurrency_,
+          fold_partition_)
+        .input_family(query(input.name))
+        .output_products("f" + name);
+      ++n_folds_;
+      record({}, cost.count(), input.critical_path, cost.count());
+    }
+
+    // The unfold splits its input payload into children, each of which carries an equal
+    // share of the node's cost; the children are then merged by a fold into one product.
+    void add_unfold(std::string const& name, available_product const& input)
+    {
+      auto const cost = draw_cost();
+      auto const child_cost = cost / unfold_children_;
+      auto const child_layer = "split_" + name;
+      auto const n = unfold_children_;
+      m_.unfold<splitter>(
+          "unfold_" + name,
+          [n](splitter const&, std::size_t const i) { return i != n; },
+          [n](splitter const& s, std::size_t const i) {
+            auto const n_elements = std::max<std::size_t>(1, s.size() / n);
+            return std::make_pair(i + 1, make_payload(n_elements, s.tag()));
+          },
+          concurrency_,
+          child_layer)
+        .input_family(query(input.name))
+        .output_products("c" + name);
+      m_.fold(
+          "merge_" + name,
+          [child_cost](merged_payload& merged, payload const& child) {
+            timed_busy(child_cost);
+            std::lock_guard lock{merged.mutex};
+            if (merged.value.empty()) {
+              merged.value = make_payload(child.size(), child[0]);
+            }
+          },
+          concurrency_,
+          layer_)
+        .input_family(product_query{product_specification::create("c" + name), child_layer})
+        .output_products("m" + name);
+      ++n_unfolds_;
+      // Children are processed in parallel, so only one share lies on the critical path.
+      record({}, child_cost.count(), input.critical_path, cost.count());
+    }
+
+    available_product record(std::string name,
+                             double const cost,
+                             double const upstream_path,
+                             double const work)
+    {
+      total_work_ += work;
+      auto const path = upstream_path + cost;
+      critical_path_ = std::max(critical_path_, path);
+      return {std::move(name), path};
+    }
+
+    module_graph_proxy<void_tag>& m_;
+    std::string label_;
+    std::string layer_;
+    std::mt19937_64 rng_;
+    bool layered_;
+    cost_distribution cost_;
+    double accept_fraction_;
+    std::string fold_partition_;
+    std::size_t unfold_children_;
+    concurrency concurrency_;
+    std::size_t fan_in_min_{};
+    std::size_t fan_in_max_{};
+    std::size_t size_min_{};
+    std::size_t size_max_{};
+    double predicate_fraction_{};
+    double fold_fraction_{};
+    double unfold_fraction_{};
+    std::vector<std::size_t> widths_;
+
+    std::size_t n_transforms_{};
+    std::size_t n_predicates_{};
+    std::size_t n_folds_{};
+    std::size_t n_unfolds_{};
+    double total_work_{};
+    double critical_path_{};
+  };
+}
+
+PHLEX_REGISTER_ALGORITHMS(m, config) { workflow_builder{m, config}.build(); }
@@ -6,7 +6,9 @@
 
 #include "catch2/catch_test_macros.hpp"
 
+#include <atomic>
 #include <tuple>
+#include <typeinfo>
 #include <vector>
 
 using namespace phlex;
@@ -110,3 +112,36 @@ TEST_CASE("Distinguish products with same name and different types", "[programmi
   g.execute();
   spdlog::info("Executed");
 }
+
+TEST_CASE("Select type-erased inputs by the type set on the query", "[programming model]")
+{
+  auto gen = [](auto& driver) {
+    auto job_index = data_cell_index::base_ptr();
+    driver.yield(job_index);
+    for (unsigned i : {1u, 2u, 3u}) {
+      driver.yield(job_index->make_child(i, "event"));
+    }
+  };
+
+  experimental::framework_graph g{gen};
+  g.provide("provide_numbers", provide_numbers, concurrency::unlimited)
+    .output_product("numbers"_in("event"));
+  g.transform("square", square, concurrency::unlimited)
+    .input_family("numbers"_in("event"))
+    .output_products("square_result", "square_result");
+
+  // Both products are named "square_result"; the type on the query picks the double
+  auto query = "square_result"_in("event");
+  query.set_type(experimental::make_type_id<double>());
+
+  std::atomic<unsigned> doubles{};
+  g.observe("erased",
+            [&doubles](experimental::product_base const& product) {
+              if (product.type() == typeid(double)) {
+                ++doubles;
+              }
+            })
+    .input_family(query);
+  g.execute();
+  CHECK(doubles == 3u);
+}
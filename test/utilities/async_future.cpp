@@ -0,0 +1,70 @@
+#include "phlex/utilities/async_future.hpp"
+
+#include "catch2/catch_test_macros.hpp"
+
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+using namespace phlex::experimental;
+
+TEST_CASE("Continuation runs on the thread that completes the promise", "[async_future]")
+{
+  async_promise<int> promise;
+  auto future = promise.get_future();
+
+  std::thread::id continuation_thread;
+  future.on_ready([&continuation_thread] { continuation_thread = std::this_thread::get_id(); });
+
+  std::jthread producer{[p = std::move(promise)]() mutable { p.set_value(42); }};
+  auto const producer_thread = producer.get_id();
+  producer.join();
+
+  CHECK(continuation_thread == producer_thread);
+  CHECK(future.get() == 42);
+}
+
+TEST_CASE("Continuation of a completed promise runs immediately", "[async_future]")
+{
+  async_promise<void> promise;
+  auto future = promise.get_future();
+  promise.set_value();
+
+  bool ready = false;
+  future.on_ready([&ready] { ready = true; });
+  CHECK(ready);
+  CHECK_NOTHROW(future.get());
+}
+
+TEST_CASE("Exceptions and broken promises complete the future", "[async_future]")
+{
+  async_future<int> failed;
+  {
+    async_promise<int> promise;
+    failed = promise.get_future();
+    promise.set_exception(std::make_exception_ptr(std::runtime_error("Failed")));
+  }
+  CHECK_THROWS_AS(failed.get(), std::runtime_error);
+
+  async_future<int> abandoned;
+  bool ready = false;
+  {
+    async_promise<int> promise;
+    abandoned = promise.get_future();
+    abandoned.on_ready([&ready] { ready = true; });
+  }
+  CHECK(ready);
+  CHECK_THROWS_AS(abandoned.get(), std::future_error);
+}
+
+TEST_CASE("Guarded continuations do nothing once the scope is closed", "[async_future]")
+{
+  int calls = 0;
+  auto scope = std::make_unique<async_scope>();
+  auto guarded = scope->guard([&calls] { ++calls; });
+  guarded();
+  scope.reset();
+  guarded();
+  CHECK(calls == 1);
+}